@@ -6,13 +6,20 @@
  *
  *  @author  Reiner Rohlfs, UGE
  *
+ *  @version 13.2   2026-10-19 agent user-041 the items are stored in an
+ *                                        append-only log file with in-memory
+ *                                        indexes, inserted under a lock of the
+ *                                        group (user-042)
  *  @version 12.0.1 2019-11-14 ABE #20111 Handle 32 bit unsigned integers
  *  @version  9.0   2018-02-01 RRO        UTC can be used as bookkeeping number
  *  @version  7.0   2017-01-20 RRO        first released version
  */
 
+#include <cstdint>
 #include <string>
 #include <list>
+#include <map>
+#include <unordered_map>
 #include <vector>
 #include <set>
 
@@ -96,7 +103,31 @@ struct BKItem {
  *
  *  @brief Main class of the Bookkeeping module.
  *
- *
+ *  The items of a bookkeeping group are stored in the log file items.bklog
+ *  in the directory of the group. Every inserted
+ *  item is appended as one line. A line is the name of the item file of
+ *  the former format and a CRC. Lines that are incomplete or have a wrong
+ *  CRC are ignored. This can happen if a program crashes while it writes
+ *  the line.\n
+ *  The items are kept in memory. They are indexed by start time and by the
+ *  values of the key BKNumbers. Insert() and Find() only read the lines
+ *  appended to the log file since the previous call. Other instances of
+ *  the same group therefore see the inserted items.\n
+ *  The directory of the group also contains the master file. Items stored
+ *  as empty files in this directory, the format of former versions, are
+ *  imported when the group is opened for the first time without a log
+ *  file. They can be imported again with ImportItemFiles() and exported
+ *  with ExportItemFiles().\n
+ *  Several processes and threads can use the same group at the same time,
+ *  each with its own instance of this class. Insert(), ImportItemFiles()
+ *  and Compact() hold an exclusive flock() of the file items.bklog.lock
+ *  while they check and write the log file, the overlap check and the
+ *  append are therefore one atomic step. Find() and GetNumItems() do not
+ *  lock: they read the log file without locking. Lines are only appended and
+ *  Compact() replaces the log file by a rename, a reader therefore always
+ *  sees the items of a complete prefix of the log file. The lock and the
+ *  rename require a local file system, not NFS.\n
+ *  An instance must not be used by several threads at the same time.
  */
 class Bookkeeping {
 
@@ -104,6 +135,37 @@ class Bookkeeping {
                                         ///  this bookkeeping group
    std::string             m_groupDir;  ///< @brief complete path of the directory
                                         ///  of this bookkeeping group
+   std::string             m_logFileName;  ///< @brief complete path of the log
+                                           ///  file with the items of this group
+   std::string             m_lockFileName; ///< @brief complete path of the file
+                                           ///  locked while the log file is written
+
+   std::vector<BKItem>     m_items;     ///< all items, in the order of the log file
+
+   /// index of m_items by the start time of the items
+   std::multimap<UTC, size_t>  m_startIndex;
+
+   /// index of m_items by the values of the key BKNumbers, see GetKey()
+   std::unordered_map<std::string, std::vector<size_t> >  m_keyIndex;
+
+   uint64_t  m_logOffset;   ///< number of bytes of the log file read into m_items
+   uint64_t  m_logInode;    ///< inode of the log file, changed by Compact()
+
+   /// @brief Verifies the BKNumbers of @b bkItem against the master list and
+   ///        returns the file name of the item in the former format.
+   std::string GetItemName(const BKItem & bkItem, const std::string & method) const;
+
+   /// Creates the item of the file name of the former format
+   BKItem ParseItemName(const std::string & itemName) const;
+
+   /// Returns the values of the key BKNumbers of @b bkItem as one string
+   std::string GetKey(const BKItem & bkItem) const;
+
+   /// Reads the lines appended to the log file since the last call.
+   void ReadLog();
+
+   /// Inserts an item, without reading the log file before
+   bool InsertItem(const BKItem & bkItem, const std::string & itemName);
 
 public:
    /** ****************************************************************************
@@ -133,7 +195,10 @@ public:
     *  yet used by an other bookkeeping item. Except if the @b bkItem is
     *  identical to an already existing item. i.e. all values of all numbers are
     *  identical and the start and stop times are identical. In this case the
-    *  method does nothing and returns without creating a new item.
+    *  method does nothing and returns without creating a new item.\n
+    *  The check of the time range and the insertion are done under the lock
+    *  of the group. Of several processes inserting overlapping items at the
+    *  same time exactly one succeeds.
     *
     *  @throw runtime_error if the key Numbers of @b bkItem are not identical as
     *         the masterList provided to the constructor of this class. Identical
@@ -160,6 +225,41 @@ public:
     */
    std::list<BKItem>   Find(const BKItem & bkItem);
 
+   /** ****************************************************************************
+    *  @brief Inserts the items stored as empty files in the directory of the
+    *         group, the format of former versions.
+    *
+    *  Items that exist already are skipped.
+    *
+    *  @return the number of inserted items
+    *
+    *  @throw runtime_error if the time range of an item file overlaps with
+    *         the time range of another item.
+    */
+   uint64_t ImportItemFiles();
+
+   /** ****************************************************************************
+    *  @brief Creates an empty file in the directory of the group for every
+    *         item, the format of former versions.
+    *
+    *  @return the number of created files, files that exist already are not
+    *          counted.
+    */
+   uint64_t ExportItemFiles();
 
+   /** ****************************************************************************
+    *  @brief Rewrites the log file, sorted by start time and without the
+    *         incomplete or corrupted lines.
+    *
+    *  The new log file is written to a temporary file, which replaces the
+    *  log file by a rename. The log file is therefore complete, either in
+    *  the old or in the new version, if the program crashes meanwhile.
+    */
+   void Compact();
+
+   /** ****************************************************************************
+    *  @brief Returns the number of items of this group.
+    */
+   uint64_t GetNumItems();
 
 };
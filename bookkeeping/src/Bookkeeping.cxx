@@ -6,6 +6,10 @@
  *
  *  @author Reiner Rohlfs, UGE
  *  
+ *  @version 13.2   2026-10-19 agent user-041 append-only log file with
+ *                                        in-memory indexes instead of one file
+ *                                        per item, written under a lock of the
+ *                                        group (user-042)
  *  @version 12.0.1 2019-11-14 ABE #20111 Handle 32 bit unsigned integers
  *  @version  9.0   2018-02-01 RRO        UTC can be used as bookkeeping number
  *  @version  8.0   2017-08-03 ABE        bug fix: the current directory was
@@ -15,19 +19,31 @@
  *  @version 7.0  2017-01-20 RRO first version
  */
 
+#include <cerrno>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
 
 #include "boost/filesystem.hpp"
 #include "boost/algorithm/string.hpp"
 #include "boost/range/algorithm/count.hpp"
+#include "boost/crc.hpp"
 
 #include "Bookkeeping.hxx"
 
 using namespace std;
 
+/// Name of the log file of the items in the directory of the group
+static const string LOG_FILE_NAME = "items.bklog";
+
 Bookkeeping::Bookkeeping(const std::string & path,
 		const std::string & name,
-		std::vector<BKNumber> & masterList) : m_master(masterList) {
+		std::vector<BKNumber> & masterList)
+	: m_master(masterList), m_logOffset(0), m_logInode(0) {
 
 	// Check that the name is not an empty string
 	if (name == "") {
@@ -43,6 +59,8 @@ Bookkeeping::Bookkeeping(const std::string & path,
     string fullpath(path);
     if (fullpath.at(0) != '/') fullpath = string(getenv("PWD"))+"/"+fullpath;
 	m_groupDir = fullpath+"/"+name;
+	m_logFileName = m_groupDir+"/"+LOG_FILE_NAME;
+	m_lockFileName = m_logFileName+".lock";
 
 	// Check that the path is valid
 	if (!boost::filesystem::exists(fullpath)) {
@@ -168,9 +186,59 @@ Bookkeeping::Bookkeeping(const std::string & path,
 
 	}
 
+	// A group of a former version: import the item files once
+	if (!boost::filesystem::exists(m_logFileName))
+		ImportItemFiles();
+	else
+		ReadLog();
+
 }
 
-void Bookkeeping::Insert(const BKItem & bkItem) {
+/// Returns the CRC of a line of the log file
+static uint32_t LineCrc(const string & itemName) {
+
+	boost::crc_32_type crc;
+	crc.process_bytes(itemName.data(), itemName.size());
+	return crc.checksum();
+}
+
+/** ****************************************************************************
+ *  @brief Exclusive lock of a bookkeeping group, held until the instance is
+ *         deleted.
+ *
+ *  The lock file is never replaced, unlike the log file, which is renamed
+ *  by Compact(). flock() locks the open file, the lock therefore also
+ *  excludes other instances in the same process.
+ */
+class GroupLock {
+
+	int m_fd;   ///< the locked file
+
+public:
+	GroupLock(const string & lockFileName, const string & method) {
+
+		m_fd = open(lockFileName.c_str(), O_RDWR | O_CREAT, 0644);
+		if (m_fd < 0) {
+			throw runtime_error("Error in Bookkeeping::"+method+": cannot open the lock file "+lockFileName);
+		}
+		int result;
+		while ((result = flock(m_fd, LOCK_EX)) != 0 && errno == EINTR);
+		if (result != 0) {
+			close(m_fd);
+			throw runtime_error("Error in Bookkeeping::"+method+": cannot lock the file "+lockFileName);
+		}
+	}
+
+	~GroupLock() {
+		// closing the file releases the lock
+		close(m_fd);
+	}
+
+	GroupLock(const GroupLock &) = delete;
+	GroupLock & operator=(const GroupLock &) = delete;
+};
+
+std::string Bookkeeping::GetItemName(const BKItem & bkItem, const std::string & method) const {
 
 	// First part of filename is the start and stop UTC times
 	string filename = "TU";
@@ -179,12 +247,10 @@ void Bookkeeping::Insert(const BKItem & bkItem) {
 	filename += bkItem.m_stop.getUtc(true);
 	filename += "_";
 	boost::replace_all(filename, ":", "-");
-	//boost::erase_all(filename, ":");
-	//boost::erase_all(filename, "-");
 
 	// Check that the number of BKNumbers is the same as for the master
 	if (bkItem.m_bkNumbers.size() != m_master.size()) {
-		throw runtime_error("Error in Bookkeeping::Insert: number of BKNumbers in inserted item not consistent with the bookkeeping group master list");
+		throw runtime_error("Error in Bookkeeping::"+method+": number of BKNumbers in inserted item not consistent with the bookkeeping group master list");
 	}
 
 	// Loop over the BKNumbers
@@ -194,7 +260,7 @@ void Bookkeeping::Insert(const BKItem & bkItem) {
 
 		// Check that the sequence of BKNumbers is the same as for the master
 		if (!(*bknum == *masterNum)) {
-			throw runtime_error("Error in Bookkeeping::Insert: name, key or data type for BKNumber "
+			throw runtime_error("Error in Bookkeeping::"+method+": name, key or data type for BKNumber "
 					+bknum->m_name+" does not match the corresponding BKNumber of the bookkeeping group master list");
 		}
 
@@ -205,12 +271,12 @@ void Bookkeeping::Insert(const BKItem & bkItem) {
 			filename += to_string(bknum->m_uint8Number);
 		} else if (bknum->m_bkDataType == bk_uint16) {
 			filename += to_string(bknum->m_uint16Number);
-    } else if (bknum->m_bkDataType == bk_UTC) {
-      filename += bknum->m_utc.getUtc(true);
+		} else if (bknum->m_bkDataType == bk_UTC) {
+			filename += bknum->m_utc.getUtc(true);
 		} else if (bknum->m_bkDataType == bk_uint32) {
 			filename += to_string(bknum->m_uint32Number);
 		} else {
-			throw runtime_error("Error in Bookkeeping::Insert: invalid BKDataType: "+bknum->m_bkDataType);
+			throw runtime_error("Error in Bookkeeping::"+method+": invalid BKDataType: "+to_string(bknum->m_bkDataType));
 		}
 		filename += "_";
 
@@ -219,147 +285,338 @@ void Bookkeeping::Insert(const BKItem & bkItem) {
 	}
 	filename.pop_back(); // Remove the last trailing underscore
 
-	// Loop over existing items in the bookkeeping group
-	boost::filesystem::directory_iterator it(m_groupDir), eod;
-	for (;it != eod; ++it) {
-		if (is_regular_file(it->path())) {
+	return filename;
+}
 
-			// Check if an identical booking item already exists and exit without doing anything if it does
-			if (filename == it->path().filename().string()) return;
+BKItem Bookkeeping::ParseItemName(const std::string & itemName) const {
 
-			// Split the filename into substrings, using underscore as the separator
-			vector<string> substrings;
-			boost::split(substrings,it->path().filename().string(),boost::is_any_of("_"));
+	BKItem item;
 
-			// Skip the master list file
-			if (substrings[0] == "master") continue;
+	// Split the filename into substrings, using underscore as the separator
+	vector<string> substrings;
+	boost::split(substrings,itemName,boost::is_any_of("_"));
 
-			// Extract the start and stop UTC times from the filename
-			UTC start = UTC(substrings[0]);
-			UTC stop = UTC(substrings[1]);
+	if (substrings.size() < 2) {
+		throw runtime_error("Error in Bookkeeping: invalid item "+itemName);
+	}
 
-			// Check that the time interval of the item to be inserted does not overlap with that of an existing item
-			if (start<bkItem.m_stop && stop>bkItem.m_start) {
-				throw runtime_error("Error in Bookkeeping::Insert: The time interval for the item to be inserted ("
-						+bkItem.m_start.getUtc(true)+" - "+bkItem.m_stop.getUtc(true)
-						+") overlaps with the time interval of the following existing item: "
-						+it->path().filename().string());
-			}
+	// Extract the start and stop UTC times from the filename
+	item.m_start = UTC(substrings[0]);
+	item.m_stop = UTC(substrings[1]);
+
+	// Extract the BKNumber names and values from the filename
+	unsigned istr = 2; //Skip the start and stop times from the filename
+	for (unsigned i=0; i<m_master.size(); i++) {
+		unsigned count = boost::count(m_master[i].m_name, '_');
+		if (istr + count + 2 > substrings.size()) {
+			throw runtime_error("Error in Bookkeeping: invalid item "+itemName);
+		}
 
+		string name = substrings[istr++];
+		// Take into account that names can include an underscore, requiring concatenation of substrings
+		// since underscore is used as the substring separator
+		for (unsigned j=0; j<count; j++) {
+			name += "_";
+			name += substrings[istr++];
+		}
+		string value = substrings[istr++];
+
+		// Check that the ordering of the BKNumber names names matches the master
+		if (name != m_master[i].m_name) {
+			throw runtime_error("Error in Bookkeeping::Find: ordering of BKNumber names does not match master list for BKItem "
+					+itemName);
+		}
+		// Make a copy of the master BKNumber and assign the value
+		BKNumber number = m_master[i];
+		if (number.m_bkDataType == bk_uint8) {
+			number.m_uint8Number = static_cast<uint8_t>(stoul(value));
+		} else if (number.m_bkDataType == bk_uint16) {
+			number.m_uint16Number = static_cast<uint16_t>(stoul(value));
+		} else if (number.m_bkDataType == bk_UTC) {
+			number.m_utc = UTC(value);
+		} else if (number.m_bkDataType == bk_uint32) {
+			number.m_uint32Number = static_cast<uint32_t>(stoul(value));
+		} else {
+			throw runtime_error("Error in Bookkeeping::Find: invalid BKDataType: "+to_string(number.m_bkDataType));
 		}
+		item.m_bkNumbers.push_back(number);
 	}
 
-	// Create the bookkeeping item file and close it
-	ofstream ofs(m_groupDir+"/"+filename);
-	ofs.close();
+	if (istr != substrings.size()) {
+		throw runtime_error("Error in Bookkeeping: invalid item "+itemName);
+	}
 
+	return item;
 }
 
-std::list<BKItem> Bookkeeping::Find(const BKItem & bkItem) {
+std::string Bookkeeping::GetKey(const BKItem & bkItem) const {
+
+	// Only the BKNumbers for which the key is true
+	string key;
+	for (const BKNumber & number : bkItem.m_bkNumbers) {
+		if (!number.m_key) continue;
+		if (number.m_bkDataType == bk_uint8) {
+			key += to_string(number.m_uint8Number);
+		} else if (number.m_bkDataType == bk_uint16) {
+			key += to_string(number.m_uint16Number);
+		} else if (number.m_bkDataType == bk_UTC) {
+			key += number.m_utc.getUtc();
+		} else if (number.m_bkDataType == bk_uint32) {
+			key += to_string(number.m_uint32Number);
+		}
+		key += "_";
+	}
+	return key;
+}
 
-	// Check that the number of BKNumbers is the same as for the master
-	if (bkItem.m_bkNumbers.size() != m_master.size()) {
-		throw runtime_error("Error in Bookkeeping::Insert: number of BKNumbers in inserted item not consistent with the bookkeeping group master list");
+void Bookkeeping::ReadLog() {
+
+	// The size and the inode are taken from the opened file, which may be
+	// replaced by Compact() of another instance meanwhile
+	int fd = open(m_logFileName.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+	struct stat logStat;
+	if (fstat(fd, &logStat) != 0) {
+		close(fd);
+		return;
 	}
 
-	// Check that the sequence of BKNumbers is the same as for the master
-	vector<BKNumber>::const_iterator masterNum = m_master.begin();
-	vector<BKNumber>::const_iterator bknum = bkItem.m_bkNumbers.begin();
-	while (bknum != bkItem.m_bkNumbers.end()) {
-		if (!(*bknum == *masterNum)) {
-			throw runtime_error("Error in Bookkeeping::Find: name, key or data type for BKNumber "
-					+bknum->m_name+" does not match the corresponding BKNumber of the bookkeeping group master list");
+	// The log file was replaced by Compact() of another instance: read it again
+	if ((uint64_t)logStat.st_ino != m_logInode || (uint64_t)logStat.st_size < m_logOffset) {
+		m_items.clear();
+		m_startIndex.clear();
+		m_keyIndex.clear();
+		m_logOffset = 0;
+		m_logInode = logStat.st_ino;
+	}
+
+	if ((uint64_t)logStat.st_size == m_logOffset) {
+		close(fd);
+		return;
+	}
+
+	string buffer(logStat.st_size - m_logOffset, '\0');
+	size_t numRead = 0;
+	while (numRead < buffer.size()) {
+		ssize_t result = pread(fd, &buffer[numRead], buffer.size() - numRead, m_logOffset + numRead);
+		if (result <= 0) break;
+		numRead += result;
+	}
+	close(fd);
+	buffer.resize(numRead);
+
+	// Only complete lines are read, the last line may still be written
+	size_t lineStart = 0;
+	size_t lineEnd;
+	while ((lineEnd = buffer.find('\n', lineStart)) != string::npos) {
+
+		string line = buffer.substr(lineStart, lineEnd - lineStart);
+		lineStart = lineEnd + 1;
+
+		// A line is the item name and its CRC, other lines were not completely
+		// written and are ignored
+		size_t separator = line.rfind(' ');
+		if (separator == string::npos || line.size() - separator != 9) continue;
+		string itemName = line.substr(0, separator);
+		if (strtoul(line.c_str() + separator + 1, nullptr, 16) != LineCrc(itemName)) continue;
+
+		BKItem item;
+		try {
+			item = ParseItemName(itemName);
 		}
-		masterNum++;
-		bknum++;
+		catch (exception & error) {
+			continue;
+		}
+
+		// An item may be in the log file twice if it was inserted at the same
+		// time by two instances
+		bool exists = false;
+		auto sameStart = m_startIndex.equal_range(item.m_start);
+		for (auto i_item = sameStart.first; i_item != sameStart.second; i_item++) {
+			if (GetItemName(m_items[i_item->second], "Insert") == itemName) exists = true;
+		}
+		if (exists) continue;
+
+		m_startIndex.insert(make_pair(item.m_start, m_items.size()));
+		m_keyIndex[GetKey(item)].push_back(m_items.size());
+		m_items.push_back(item);
+	}
+
+	m_logOffset += lineStart;
+}
+
+bool Bookkeeping::InsertItem(const BKItem & bkItem, const std::string & itemName) {
+
+	// Check if an identical booking item already exists and exit without doing anything if it does
+	auto sameStart = m_startIndex.equal_range(UTC(bkItem.m_start.getUtc(true)));
+	for (auto i_item = sameStart.first; i_item != sameStart.second; i_item++) {
+		if (GetItemName(m_items[i_item->second], "Insert") == itemName) return false;
+	}
+
+	// Check that the time interval of the item to be inserted does not overlap with that of an existing item.
+	// The existing items do not overlap: only the items with the last start time before the stop time
+	// of the new item have to be checked.
+	multimap<UTC, size_t>::const_iterator i_item = m_startIndex.lower_bound(bkItem.m_stop);
+	while (i_item != m_startIndex.begin()) {
+		i_item--;
+		const BKItem & item = m_items[i_item->second];
+		if (item.m_stop>bkItem.m_start) {
+			throw runtime_error("Error in Bookkeeping::Insert: The time interval for the item to be inserted ("
+					+bkItem.m_start.getUtc(true)+" - "+bkItem.m_stop.getUtc(true)
+					+") overlaps with the time interval of the following existing item: "
+					+GetItemName(item, "Insert"));
+		}
+		if (i_item != m_startIndex.begin() && prev(i_item)->first != item.m_start) break;
+	}
+
+	// Append the item to the log file in one write
+	string line = itemName + " ";
+	char crc[9];
+	snprintf(crc, sizeof(crc), "%08x", LineCrc(itemName));
+	line += crc;
+	line += "\n";
+
+	int fd = open(m_logFileName.c_str(), O_RDWR | O_APPEND | O_CREAT, 0644);
+	if (fd < 0) {
+		throw runtime_error("Error in Bookkeeping::Insert: cannot open the log file "+m_logFileName);
+	}
+	// Complete a line that was not completely written by a crashed program
+	struct stat logStat;
+	char lastChar = '\n';
+	if (fstat(fd, &logStat) == 0 && logStat.st_size > 0)
+		if (pread(fd, &lastChar, 1, logStat.st_size - 1) != 1) lastChar = '\n';
+	if (lastChar != '\n') line = "\n" + line;
+
+	ssize_t written = write(fd, line.data(), line.size());
+	close(fd);
+	if (written != (ssize_t)line.size()) {
+		throw runtime_error("Error in Bookkeeping::Insert: cannot write to the log file "+m_logFileName);
+	}
+
+	return true;
+}
+
+void Bookkeeping::Insert(const BKItem & bkItem) {
+
+	string itemName = GetItemName(bkItem, "Insert");
+
+	// The lines appended by other instances are read under the lock, the
+	// overlap check and the append are therefore one atomic step
+	{
+		GroupLock lock(m_lockFileName, "Insert");
+		ReadLog();
+		if (!InsertItem(bkItem, itemName)) return;
 	}
+	ReadLog();
+}
+
+std::list<BKItem> Bookkeeping::Find(const BKItem & bkItem) {
+
+	// Check the BKNumbers against the master
+	GetItemName(bkItem, "Find");
+
+	ReadLog();
 
 	// List of matching  BKItems to be returned
 	std::list<BKItem> bkItems;
 
-	// Loop over existing items in the bookkeeping group
+	auto i_key = m_keyIndex.find(GetKey(bkItem));
+	if (i_key != m_keyIndex.end()) {
+		for (size_t index : i_key->second) {
+			bkItems.push_back(m_items[index]);
+		}
+	}
+
+	return bkItems;
+}
+
+uint64_t Bookkeeping::ImportItemFiles() {
+
+	GroupLock lock(m_lockFileName, "ImportItemFiles");
+	ReadLog();
+
+	uint64_t numInserted = 0;
+
+	// Loop over the item files in the bookkeeping group
 	boost::filesystem::directory_iterator it(m_groupDir), eod;
 	for (;it != eod; ++it) {
 		if (is_regular_file(it->path())) {
 
-			BKItem item;
-
-			// Split the filename into substrings, using underscore as the separator
-			vector<string> substrings;
-			boost::split(substrings,it->path().filename().string(),boost::is_any_of("_"));
-
-			// Skip the master list file
-			if (substrings[0] == "master") continue;
-
-			// Extract the start and stop UTC times from the filename
-			item.m_start = UTC(substrings[0]);
-			item.m_stop = UTC(substrings[1]);
-
-			// Extract the BKNumber names and values from the filename
-			vector<string> names,values;
-			unsigned istr = 2; //Skip the start and stop times from the filename
-			for (unsigned i=0; i<m_master.size(); i++) {
-				string name = substrings[istr++];
-				// Take into account that names can include an underscore, requiring concatenation of substrings
-				// since underscore is used as the substring separator
-				unsigned count = boost::count(m_master[i].m_name, '_');
-				for (unsigned j=0; j<count; j++) {
-					name += "_";
-					name += substrings[istr++];
-				}
-				names.push_back(name);
-				values.push_back(substrings[istr++]);
-			}
-//			for (unsigned i=0; i<m_master.size(); i++) {
-//				cout << m_master[i].m_name << " " << names[i] << " " << values[i] << endl;
-//			}
-
-			// Create a vector of BKNumbers corresponding to the filename
-			vector<BKNumber> numbers;
-			for (unsigned i=0; i<names.size(); i++) {
-				// Check that the ordering of the BKNumber names names matches the master
-				if (names[i] != m_master[i].m_name) {
-					throw runtime_error("Error in Bookkeeping::Find: ordering of BKNumber names does not match master list for BKItem "
-							+it->path().filename().string());
-				}
-				// Make a copy of the master BKNumber and assign the value
-				BKNumber number = m_master[i];
-				if (number.m_bkDataType == bk_uint8) {
-					number.m_uint8Number = static_cast<uint8_t>(stoi(values[i]));
-				} else if (number.m_bkDataType == bk_uint16) {
-					number.m_uint16Number = static_cast<uint16_t>(stoi(values[i]));
-        } else if (number.m_bkDataType == bk_UTC) {
-          number.m_utc = UTC(values[i]);
-				} else if (number.m_bkDataType == bk_uint32) {
-					number.m_uint32Number = static_cast<uint32_t>(stoi(values[i]));
-				} else {
-					throw runtime_error("Error in Bookkeeping::Find: invalid BKDataType: "+number.m_bkDataType);
-				}
-				numbers.push_back(number);
-			}
-			item.m_bkNumbers = numbers;
-
-			// Check if the set of BKNumber values for the current item matches those of the item being searched for
-			bool match = true;
-			for (unsigned i=0; i<bkItem.m_bkNumbers.size(); i++) {
-				if (bkItem.m_bkNumbers[i].m_key) { // Only consider BKNumbers for which the key is true
-					if (bkItem.m_bkNumbers[i].m_bkDataType == bk_uint8) {
-						if (item.m_bkNumbers[i].m_uint8Number != bkItem.m_bkNumbers[i].m_uint8Number) match = false;
-					} else if (bkItem.m_bkNumbers[i].m_bkDataType == bk_uint16) {
-						if (item.m_bkNumbers[i].m_uint16Number != bkItem.m_bkNumbers[i].m_uint16Number) match = false;
-          } else if (bkItem.m_bkNumbers[i].m_bkDataType == bk_UTC) {
-            if (item.m_bkNumbers[i].m_utc != bkItem.m_bkNumbers[i].m_utc) match = false;
-					} else if (bkItem.m_bkNumbers[i].m_bkDataType == bk_uint32) {
-						if (item.m_bkNumbers[i].m_uint32Number != bkItem.m_bkNumbers[i].m_uint32Number) match = false;
-					} else {
-						throw runtime_error("Error in Bookkeeping::Find: invalid BKDataType: "+bkItem.m_bkNumbers[i].m_bkDataType);
-					}
-				}
-			}
-			if (match) bkItems.push_back(item);
+			string itemName = it->path().filename().string();
+
+			// Skip the master list file and the log file
+			if (itemName.compare(0, 7, "master_") == 0) continue;
+			if (itemName.compare(0, LOG_FILE_NAME.size(), LOG_FILE_NAME) == 0) continue;
 
+			if (InsertItem(ParseItemName(itemName), itemName))
+				numInserted++;
 		}
+		// the log file is read after every inserted item to find the identical items
+		ReadLog();
 	}
 
-	return bkItems;
+	return numInserted;
+}
+
+uint64_t Bookkeeping::ExportItemFiles() {
+
+	ReadLog();
+
+	uint64_t numCreated = 0;
+	for (const BKItem & item : m_items) {
+		string filename = m_groupDir+"/"+GetItemName(item, "ExportItemFiles");
+		if (!boost::filesystem::exists(filename)) {
+			// Create the bookkeeping item file and close it
+			ofstream ofs(filename);
+			ofs.close();
+			numCreated++;
+		}
+	}
+
+	return numCreated;
+}
+
+void Bookkeeping::Compact() {
+
+	// No item may be appended to the old log file after it was read
+	GroupLock lock(m_lockFileName, "Compact");
+	ReadLog();
+
+	// Write the new log file, sorted by start time
+	string tmpFileName = m_logFileName+".tmp";
+	FILE * tmpFile = fopen(tmpFileName.c_str(), "w");
+	if (!tmpFile) {
+		throw runtime_error("Error in Bookkeeping::Compact: cannot create the file "+tmpFileName);
+	}
+	for (const auto & start : m_startIndex) {
+		string itemName = GetItemName(m_items[start.second], "Compact");
+		fprintf(tmpFile, "%s %08x\n", itemName.c_str(), LineCrc(itemName));
+	}
+	bool ok = fflush(tmpFile) == 0 && fsync(fileno(tmpFile)) == 0;
+	ok = (fclose(tmpFile) == 0) && ok;
+
+	// The rename replaces the log file in one step
+	if (!ok || rename(tmpFileName.c_str(), m_logFileName.c_str()) != 0) {
+		remove(tmpFileName.c_str());
+		throw runtime_error("Error in Bookkeeping::Compact: cannot write the file "+m_logFileName);
+	}
+
+	// Write the rename to disk
+	int dirFd = open(m_groupDir.c_str(), O_RDONLY);
+	if (dirFd >= 0) {
+		fsync(dirFd);
+		close(dirFd);
+	}
+
+	// The items are read again from the new log file
+	m_logInode = 0;
+	ReadLog();
+}
+
+uint64_t Bookkeeping::GetNumItems() {
+
+	ReadLog();
+	return m_items.size();
 }
@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-041 tests of the log file of the items
+ *                             and of concurrent processes (user-042)
  *  @version 7.0   2017-01-20 RRO first version
  *
  */
@@ -18,6 +20,14 @@
 #include <stdexcept>
 #include <string>
 #include <initializer_list>
+#include <fstream>
+#include <cstdio>
+#include <chrono>
+#include <iostream>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include "boost/filesystem.hpp"
 
 #include "LeapSeconds.hxx"
 #include "DeltaTime.hxx"
@@ -418,5 +428,202 @@ BOOST_AUTO_TEST_CASE( Unsigned32BitInteger )
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// An item of the group of the IndexedItems test: one hour per visit
+static BKItem IndexedItem(int visit) {
+
+   UTC start = UTC("2020-01-01T00:00:00") + DeltaTime(visit * 3600.0);
+   BKItem item {start, start + DeltaTime(3000.0),
+                {{"OrId",     true,  bk_uint16, 0, uint16_t(visit % 100)},
+                 {"VisitCtr", false, bk_uint32, 0, 0, UTC(), uint32_t(visit)}}};
+   return item;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE( IndexedItems )
+{
+
+   list<string> leapSecondFile {string("./resources/CH_TU1972-01-01T00-00-00_SOC_APP_LeapSeconds_V0002.fits")};
+   LeapSeconds::setLeapSecondsFileNames(leapSecondFile);
+
+   system("rm -rf results/IndexedItems");
+
+   std::vector<BKNumber> master = {{"OrId",     true,  bk_uint16},
+                                   {"VisitCtr", false, bk_uint32}};
+
+   const int numVisits = 10000;
+   Bookkeeping bookkeeping1("results", "IndexedItems", master);
+   for (int visit = 0; visit < numVisits; visit++)
+      bookkeeping1.Insert(IndexedItem(visit));
+   BOOST_CHECK_EQUAL(bookkeeping1.GetNumItems(), numVisits);
+
+   // the items are in the log file, not in the directory of the group
+   BOOST_CHECK(boost::filesystem::exists("results/IndexedItems/items.bklog"));
+
+   // an other instance sees the inserted items, also the new ones
+   Bookkeeping bookkeeping2("results", "IndexedItems", master);
+   BOOST_CHECK_EQUAL(bookkeeping2.Find(IndexedItem(42)).size(), numVisits / 100);
+   bookkeeping1.Insert(IndexedItem(numVisits));
+   BOOST_CHECK_EQUAL(bookkeeping2.Find(IndexedItem(0)).size(), numVisits / 100 + 1);
+
+   // inserting an identical item does nothing, an overlapping one throws
+   bookkeeping2.Insert(IndexedItem(7));
+   BOOST_CHECK_EQUAL(bookkeeping2.GetNumItems(), numVisits + 1);
+   BKItem overlap = IndexedItem(7);
+   overlap.m_bkNumbers[1].m_uint32Number = 0;
+   BOOST_CHECK_THROW(bookkeeping2.Insert(overlap), std::runtime_error);
+
+   // a line which was not completely written by a crashed program is ignored
+   {
+      std::ofstream log("results/IndexedItems/items.bklog", std::ios::app);
+      log << "TU2030-01-01T00-00-00_TU2030-01";
+   }
+   bookkeeping2.Insert(IndexedItem(numVisits + 1));
+   Bookkeeping bookkeeping3("results", "IndexedItems", master);
+   BOOST_CHECK_EQUAL(bookkeeping3.GetNumItems(), numVisits + 2);
+
+   // the compacted log file has the same items
+   bookkeeping3.Compact();
+   BOOST_CHECK_EQUAL(bookkeeping3.GetNumItems(), numVisits + 2);
+   BOOST_CHECK_EQUAL(bookkeeping1.Find(IndexedItem(1)).size(), numVisits / 100 + 1);
+   BOOST_CHECK_EQUAL(bookkeeping1.GetNumItems(), numVisits + 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE( ItemFiles )
+{
+
+   list<string> leapSecondFile {string("./resources/CH_TU1972-01-01T00-00-00_SOC_APP_LeapSeconds_V0002.fits")};
+   LeapSeconds::setLeapSecondsFileNames(leapSecondFile);
+
+   system("rm -rf results/ItemFiles results/ItemFilesCopy");
+
+   std::vector<BKNumber> master = {{"OrId",     true,  bk_uint16},
+                                   {"VisitCtr", false, bk_uint32}};
+
+   // export the items as files of the former format
+   Bookkeeping bookkeeping1("results", "ItemFiles", master);
+   for (int visit = 0; visit < 10; visit++)
+      bookkeeping1.Insert(IndexedItem(visit));
+   BOOST_CHECK_EQUAL(bookkeeping1.ExportItemFiles(), 10);
+   BOOST_CHECK_EQUAL(bookkeeping1.ExportItemFiles(), 0);
+
+   // a group of the former format, without log file, is imported
+   system("cp -r results/ItemFiles results/ItemFilesCopy");
+   system("rm results/ItemFilesCopy/items.bklog");
+   Bookkeeping bookkeeping2("results", "ItemFilesCopy", master);
+   BOOST_CHECK_EQUAL(bookkeeping2.GetNumItems(), 10);
+   BOOST_CHECK_EQUAL(bookkeeping2.Find(IndexedItem(3)).size(), 1);
+   BOOST_CHECK_EQUAL(bookkeeping2.ImportItemFiles(), 0);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// An item of the group of the ConcurrentProcesses test: slot @b slot
+/// inserted by the process @b process
+static BKItem SlotItem(int slot, int process) {
+
+   UTC start = UTC("2021-01-01T00:00:00") + DeltaTime(slot * 3600.0);
+   BKItem item {start, start + DeltaTime(3000.0),
+                {{"OrId",     true,  bk_uint16, 0, uint16_t(slot % 100)},
+                 {"VisitCtr", false, bk_uint32, 0, 0, UTC(), uint32_t(process)}}};
+   return item;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+BOOST_AUTO_TEST_CASE( ConcurrentProcesses )
+{
+
+   list<string> leapSecondFile {string("./resources/CH_TU1972-01-01T00-00-00_SOC_APP_LeapSeconds_V0002.fits")};
+   LeapSeconds::setLeapSecondsFileNames(leapSecondFile);
+
+   system("rm -rf results/ConcurrentProcesses");
+
+   std::vector<BKNumber> master = {{"OrId",     true,  bk_uint16},
+                                   {"VisitCtr", false, bk_uint32}};
+   Bookkeeping bookkeeping("results", "ConcurrentProcesses", master);
+
+   // All processes try to insert an item into every slot, each starting at
+   // another slot. The items of different processes for the same slot
+   // overlap, exactly one process can insert it.
+   const int numProcesses = 8;
+   const int numSlots = 400;
+
+   auto startTime = chrono::steady_clock::now();
+
+   vector<pid_t> pids;
+   vector<int>   pipes;
+   for (int process = 0; process < numProcesses; process++) {
+      int fds[2];
+      BOOST_REQUIRE(pipe(fds) == 0);
+      pid_t pid = fork();
+      BOOST_REQUIRE(pid >= 0);
+      if (pid == 0) {
+         // the child process: the test framework must not be used
+         close(fds[0]);
+         int result = 0;
+         uint32_t numInserted = 0;
+         try {
+            Bookkeeping group("results", "ConcurrentProcesses", master);
+            uint64_t numItems = 0;
+            for (int i = 0; i < numSlots; i++) {
+               int slot = (i + process * numSlots / numProcesses) % numSlots;
+               try {
+                  group.Insert(SlotItem(slot, process));
+                  numInserted++;
+               }
+               catch (runtime_error & error) {
+                  // the slot is used by another process
+               }
+
+               // the readers see a growing number of items
+               if (i % 10 == 0) {
+                  uint64_t numFound = 0;
+                  for (int orId = 0; orId < 100; orId++)
+                     numFound += group.Find(SlotItem(orId, process)).size();
+                  if (numFound < numItems || numFound > (uint64_t)numSlots) result = 1;
+                  numItems = numFound;
+               }
+               if (process == 0 && i % 100 == 50)
+                  group.Compact();
+            }
+         }
+         catch (exception & error) {
+            result = 2;
+         }
+         if (write(fds[1], &numInserted, sizeof(numInserted)) != sizeof(numInserted))
+            result = 3;
+         close(fds[1]);
+         _exit(result);
+      }
+      close(fds[1]);
+      pids.push_back(pid);
+      pipes.push_back(fds[0]);
+   }
+
+   uint32_t sumInserted = 0;
+   for (int process = 0; process < numProcesses; process++) {
+      uint32_t numInserted = 0;
+      BOOST_CHECK(read(pipes[process], &numInserted, sizeof(numInserted)) == sizeof(numInserted));
+      close(pipes[process]);
+      int status;
+      waitpid(pids[process], &status, 0);
+      BOOST_CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+      sumInserted += numInserted;
+   }
+
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - startTime).count();
+   cout << "ConcurrentProcesses: " << numProcesses << " processes, "
+        << numProcesses * numSlots / seconds << " inserts/s" << endl;
+
+   // every slot is used by exactly one item
+   BOOST_CHECK_EQUAL(sumInserted, numSlots);
+   BOOST_CHECK_EQUAL(bookkeeping.GetNumItems(), numSlots);
+   Bookkeeping bookkeeping2("results", "ConcurrentProcesses", master);
+   BOOST_CHECK_EQUAL(bookkeeping2.GetNumItems(), numSlots);
+   for (int slot = 0; slot < numSlots; slot++)
+      BOOST_CHECK_THROW(bookkeeping2.Insert(SlotItem(slot, numProcesses)), std::runtime_error);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
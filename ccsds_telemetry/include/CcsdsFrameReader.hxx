@@ -6,6 +6,7 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2  2026-10-19 agent user-028 Added GetBuffer method.
 *  @version 6.0   2016-06-24 FGE  Frames include a 4-byte Secondary Header.
 *  @version 5.1   2016-03-15 FGE  Fixed field readings for correct version of standard.
 *  @version 1.0   2015-06-18 FGE  First released version
@@ -88,6 +89,9 @@ public:
     void ValidateFrame() const;
 
 
+    /// Returns the pointer to the memory buffer containing the frame.
+    const uint8_t* GetBuffer() const { return m_buffer; }
+
     /// Gets the total length of the frame; including all headers, data and trailer.
     uint16_t GetFrameLength() const { return m_frameLength; }
     /// Gets the value of the Spacecraft ID (SCID) header field.
@@ -6,6 +6,7 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2  2026-10-19 agent user-026 Slicing-by-8 computation with thread-safe tables.
 *  @version 1.0   2015-04-17 FGE first released version
 *
 *  CRC computation code taken and adapted from annex A.1 of the ECSS-E-70-41A
@@ -28,4 +29,3 @@
 *  @param [in] length   Length of the memory buffer.
 */
 extern uint16_t CcsdsPacketCrcCompute(const uint8_t *buffer, size_t length);
-
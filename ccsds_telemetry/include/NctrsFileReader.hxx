@@ -6,6 +6,8 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2  2026-10-19 agent user-028 Added NctrsMappedFile, memory mapping of a NCTRS file for sequential reading.
+*                                           Added NctrsFileReader::ReadHeader (user-029).
 *  @version 6.0   2016-06-24 FGE  Initial implementation, can iterate the NCTRS Telemetry Data Units from a NCTRS file loading in memory.
 *
 */
@@ -14,6 +16,7 @@
 
 // include standard header files
 #include <cstdint>   // For explicit size integers (e.g. uint8_t, uint16_t)
+#include <string>
 
 // include headers of this module
 #include "CcsdsFieldReader.hxx"
@@ -125,6 +128,12 @@ public:
     /// @param [in] length  The number of bytes in the memory buffer/mapped file.
     NctrsFileReader(const uint8_t* data, size_t length);
 
+    /// @brief Reads the NCTRS header of a Telemetry Data Unit.
+    /// @param [in]  data   Pointer to the first byte of the data unit, at least
+    ///                     NctrsHeaderLength bytes must be readable.
+    /// @param [out] tmDu   The values of the header, UserData points after it.
+    static void ReadHeader(const uint8_t* data, NctrsTmDu& tmDu);
+
     /// The iterator type.
     typedef NctrsFileReaderIterator const_iterator;
 
@@ -134,3 +143,41 @@ public:
     NctrsFileReaderIterator end() { return NctrsFileReaderIterator(m_end, m_end); }
 };
 
+/** ****************************************************************************
+*  @ingroup ccsds_telemetry
+*
+*  @brief Read-only memory mapping of a NCTRS file.
+*
+*  The file is mapped into memory instead of being read, the operating system
+*  loads the pages when they are accessed and is advised that the access is
+*  sequential, so that it reads ahead and can drop already read pages. Files
+*  larger than the available RAM can therefore be processed.
+*/
+class NctrsMappedFile
+{
+private:
+    /// Pointer to the first byte of the mapped file, nullptr for an empty file.
+    const uint8_t* m_data;
+    /// The number of bytes of the file.
+    size_t m_length;
+
+public:
+    /// @brief Maps a NCTRS file into memory.
+    /// @param [in] fileName  Path of the NCTRS file.
+    /// @throw std::runtime_error  The file cannot be opened or mapped.
+    explicit NctrsMappedFile(const std::string& fileName);
+
+    /// Unmaps the file.
+    ~NctrsMappedFile();
+
+    NctrsMappedFile(const NctrsMappedFile&) = delete;
+    NctrsMappedFile& operator=(const NctrsMappedFile&) = delete;
+
+    /// Gets the pointer to the first byte of the mapped file.
+    const uint8_t* GetData() const { return m_data; }
+    /// Gets the number of bytes of the file.
+    size_t GetLength() const { return m_length; }
+
+    /// Gets a NCTRS File Reader of the mapped file, valid as long as this object exists.
+    NctrsFileReader GetReader() const { return NctrsFileReader(m_data, m_length); }
+};
@@ -0,0 +1,113 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Declaration of the NctrsStreamReader class
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-029 first released version
+*
+*/
+
+#pragma once
+
+#include <stdint.h>   // For explicit size integers (e.g. uint8_t, uint16_t)
+#include <stdexcept>  // For standard base exceptions such as runtime_exception
+#include <vector>
+
+#include "NctrsFileReader.hxx"
+
+/** ****************************************************************************
+*  @ingroup ccsds_telemetry
+*
+*  @brief Incremental reading of the NCTRS Telemetry Data Units from a file
+*         descriptor: a pipe, a socket or a file that is still being written.
+*
+*  Data units are parsed as soon as their bytes arrive. The memory used is
+*  bounded: at most maxDataUnits data units of maxDataUnitLength bytes are
+*  buffered. Bytes are only read from the file descriptor when the caller asks
+*  for the next data unit, so a slow consumer (e.g. a PacketExtractor) makes
+*  the kernel buffers of the pipe or socket fill up, which blocks the
+*  producer: this is the back-pressure.
+*
+*  Usage:
+*  @code
+*  NctrsStreamReader reader(fd);
+*  NctrsTmDu tmDu;
+*  while (reader.Next(tmDu))
+*      packetExtractor.Add(CcsdsFrameReader(tmDu.UserData, frameLength));
+*  @endcode
+*
+*  The file descriptor is not closed by this class.
+*/
+class NctrsStreamReader
+{
+private:
+    /// The file descriptor data is read from.
+    int m_fd;
+    /// Maximum length of a data unit.
+    size_t m_maxDataUnitLength;
+    /// Buffer of the bytes read and not yet consumed.
+    std::vector<uint8_t> m_buffer;
+    /// Offset in m_buffer of the first byte not yet consumed.
+    size_t m_begin = 0;
+    /// Offset in m_buffer past the last byte read.
+    size_t m_end = 0;
+    /// Time to wait for new bytes at end of file, in milliseconds, 0 to stop at end of file.
+    int m_followTimeout = 0;
+    /// Set when the end of the stream was reached.
+    bool m_endOfStream = false;
+
+    /// Counter of bytes read from the file descriptor.
+    uint64_t m_byteCount = 0;
+    /// Counter of data units returned.
+    uint64_t m_dataUnitCount = 0;
+
+    /// Reads available bytes into the buffer, blocks until at least one byte is read.
+    /// @return false at end of stream.
+    bool fill();
+
+public:
+    /// Default maximum length of a data unit: NCTRS header, ASM, frame of up to 2048 bytes and Reed-Solomon symbols.
+    static const size_t DefaultMaxDataUnitLength = 4096;
+
+    /** ****************************************************************************
+    *  @brief Creates a NCTRS Stream Reader for a file descriptor.
+    *
+    *  @param [in] fd                 The file descriptor to read from.
+    *  @param [in] maxDataUnits       Maximum number of data units held in memory.
+    *  @param [in] maxDataUnitLength  Maximum length of a data unit, including the NCTRS header.
+    *  @throw std::invalid_argument   Invalid file descriptor or buffer size.
+    */
+    NctrsStreamReader(int fd, size_t maxDataUnits = 64, size_t maxDataUnitLength = DefaultMaxDataUnitLength);
+
+    /** ****************************************************************************
+    *  @brief Follow a file that is still being written, like "tail -f".
+    *
+    *  At end of file, waits for new bytes to be appended instead of ending the
+    *  stream. The stream ends when no byte was appended during the timeout.
+    *  Not needed for pipes and sockets, their end is signaled by the writer.
+    *
+    *  @param [in] timeoutMs  Time to wait for new bytes, in milliseconds.
+    */
+    void Follow(int timeoutMs) { m_followTimeout = timeoutMs; }
+
+    /** ****************************************************************************
+    *  @brief Gets the next data unit, blocks until all its bytes are received.
+    *
+    *  @param [out] tmDu  The next data unit. Its UserData is only valid until
+    *                     the next call, it must be copied to be kept.
+    *  @return false at the end of the stream.
+    *  @throw std::runtime_error  Read error, invalid data unit length, or the
+    *                             stream ends in the middle of a data unit.
+    */
+    bool Next(NctrsTmDu& tmDu);
+
+    /// Gets the number of bytes read from the file descriptor.
+    uint64_t GetByteCount() const { return m_byteCount; }
+    /// Gets the number of data units returned by Next().
+    uint64_t GetDataUnitCount() const { return m_dataUnitCount; }
+    /// Gets the size in bytes of the buffer, the maximum memory used.
+    size_t GetBufferLength() const { return m_buffer.size(); }
+};
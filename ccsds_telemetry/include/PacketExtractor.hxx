@@ -6,6 +6,8 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2  2026-10-19 agent user-027 Pre-allocated reconstruction buffer, counters of anomalies.
+*                                           Added GetReconstructedPacketStart (user-030).
 *  @version 5.1   2016-03-15 FGE  first released version
 *
 */
@@ -33,6 +35,11 @@ using PacketCallback = std::function<void(CcsdsPacketReader packetReader, bool r
  *
  *  @brief Provides extraction of the telemetry packets from the stream of
  *         telemetry frames.
+ *
+ *  Packets fully contained in a frame are passed to the callback directly from
+ *  the memory of the frame, without copy. Only packets split across frames are
+ *  copied into a reconstruction buffer, which is allocated once for the
+ *  largest possible packet and reused for all packets.
  */
 class PacketExtractor
 {
@@ -45,8 +52,11 @@ private:
     /// Expected Virtual Channel Frame Count value of next frame
     uint8_t m_expectedVcFrameCount = 0;
     
-    /// Contains the bytes of the current partial packet being reconstructed
+    /// Contains the bytes of the current partial packet being reconstructed.
+    /// Its capacity is reserved for the largest packet, it never reallocates.
     std::vector<uint8_t> m_packetBytes;
+    /// Location of the first byte of the packet being reconstructed, in the frame where it started.
+    const uint8_t* m_packetStart = nullptr;
 
     /// Counter of processed frames.
     uint32_t m_frameCount = 0;
@@ -56,8 +66,20 @@ private:
     uint32_t m_missingFrameCount = 0;
     /// Counter of lost packets.
     uint32_t m_lostPacketCount = 0;
+    /// Counter of reconstructed packets, i.e. split across frames.
+    uint32_t m_reconstructedPacketCount = 0;
+    /// Counter of frame protocol violations.
+    uint32_t m_protocolViolationCount = 0;
+    /// Counter of frames with trailing idle data.
+    uint32_t m_idleDataCount = 0;
+
+    /// Appends bytes to the packet being reconstructed.
+    void appendPacketBytes(const uint8_t* data, uint16_t length);
     
 public:
+    /// Maximum length of a CCSDS packet: 16-bit Packet Length field + 7.
+    static const size_t MaxPacketLength = 0xFFFF + 7;
+
     /** ****************************************************************************
      *  @brief Creates a Packet Extractor for the given Virtual Channel.
      *
@@ -88,6 +110,22 @@ public:
     uint32_t GetMissingFrameCount()    const { return m_missingFrameCount; }
     /// Gets the number of lost packets detected. It is a low estimation, can be greater due to lost frames.
     uint32_t GetLostPacketCount()      const { return m_lostPacketCount; }
+    /// Gets the number of processed frames.
+    uint32_t GetFrameCount()           const { return m_frameCount; }
+    /// Gets the number of extracted packets that were split across frames and had to be reconstructed.
+    uint32_t GetReconstructedPacketCount() const { return m_reconstructedPacketCount; }
+    /// Gets the number of frame protocol violations detected.
+    uint32_t GetProtocolViolationCount()   const { return m_protocolViolationCount; }
+    /// @brief Gets the location of the first byte of the packet being reconstructed,
+    ///        in the memory of the frame where it started.
+    ///
+    /// During the callback of a reconstructed packet, it is the start of this packet.
+    /// It is nullptr if no packet is being reconstructed, e.g. after it was lost.
+    /// The pointer is only valid if the memory of the frames is still valid,
+    /// e.g. frames read from a NctrsMappedFile.
+    const uint8_t* GetReconstructedPacketStart() const { return m_packetStart; }
+    /// Gets the number of frames in which remaining bytes were idle data.
+    uint32_t GetIdleDataCount()            const { return m_idleDataCount; }
     
 };
 
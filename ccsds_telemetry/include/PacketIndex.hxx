@@ -0,0 +1,191 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Declaration of the PacketIndexer and PacketIndex classes
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-030 first released version
+*
+*/
+
+#pragma once
+
+#include <stdint.h>   // For explicit size integers (e.g. uint8_t, uint16_t)
+#include <stdexcept>  // For standard base exceptions such as runtime_exception
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CcsdsFrameReader.hxx"
+#include "NctrsFileReader.hxx"
+#include "PacketExtractor.hxx"
+
+/// @brief Function returning the telemetry frame contained in a NCTRS Telemetry Data Unit.
+///
+/// Depends on the ground station, e.g. the user data can start with an Attached
+/// Sync Marker and end with Reed-Solomon symbols.
+using FrameLocator = std::function<CcsdsFrameReader(const NctrsTmDu& tmDu)>;
+
+/// Frame locator of data units whose user data is exactly one frame.
+CcsdsFrameReader NctrsUserDataFrame(const NctrsTmDu& tmDu);
+
+
+/** ****************************************************************************
+*  @ingroup ccsds_telemetry
+*
+*  @brief Record of one packet in a packet index file.
+*
+*  Records are stored in binary form in the index file, in the byte order of
+*  the machine that wrote it.
+*/
+struct PacketIndexEntry
+{
+    /// APID of the packet.
+    uint16_t Apid;
+    /// Sequence Count of the packet.
+    uint16_t SequenceCount;
+    /// Service Type of the packet.
+    uint8_t ServiceType;
+    /// Service Subtype of the packet.
+    uint8_t ServiceSubtype;
+    /// Virtual Channel of the frames containing the packet.
+    uint8_t VirtualChannel;
+    /// 1 if the packet is split across frames, 0 if it is fully inside one frame.
+    uint8_t Reconstructed;
+    /// Total length of the packet.
+    uint32_t PacketLength;
+    /// Unused, always 0.
+    uint32_t Reserved;
+    /// CUC time of the packet data field header, see CcsdsPacketReader::GetTime.
+    uint64_t Time;
+    /// Offset in the NCTRS file of the first byte of the packet.
+    uint64_t PacketOffset;
+    /// Offset in the NCTRS file of the data unit in which the packet starts.
+    uint64_t DataUnitOffset;
+};
+
+
+/** ****************************************************************************
+*  @ingroup ccsds_telemetry
+*
+*  @brief Builds the packet index of a NCTRS file.
+*
+*  The packets of all Virtual Channels are extracted once and a record is kept
+*  for each of them. The index is then written into a sidecar file, sorted by
+*  APID and time, which allows to find packets with PacketIndex without
+*  decoding the whole NCTRS file again.
+*/
+class PacketIndexer
+{
+private:
+    /// Start of the NCTRS file in memory.
+    const uint8_t* m_data;
+    /// Length of the NCTRS file.
+    size_t m_length;
+    /// Returns the frame of a data unit.
+    FrameLocator m_frameLocator;
+    /// Extraction state of a Virtual Channel.
+    struct Channel
+    {
+        /// The packet extractor of the Virtual Channel.
+        std::unique_ptr<PacketExtractor> extractor;
+        /// Offset of the data unit being extracted.
+        uint64_t dataUnitOffset = 0;
+        /// Start of the last packet that started to be reconstructed.
+        const uint8_t* packetStart = nullptr;
+        /// Offset of the data unit in which this packet started.
+        uint64_t packetStartDataUnitOffset = 0;
+    };
+    /// The Virtual Channels, by Virtual Channel ID.
+    std::map<uint8_t, Channel> m_channels;
+    /// Records of the packets.
+    std::vector<PacketIndexEntry> m_entries;
+
+    /// Records a packet extracted from a Virtual Channel.
+    void addPacket(uint8_t virtualChannel, const CcsdsPacketReader& packet, bool reconstructed);
+
+public:
+    /** ****************************************************************************
+    *  @brief Creates a packet indexer of a NCTRS file in memory.
+    *
+    *  @param [in] data          Pointer to the first byte of the NCTRS file,
+    *                            typically NctrsMappedFile::GetData().
+    *  @param [in] length        Length of the NCTRS file.
+    *  @param [in] frameLocator  Returns the frame of a data unit.
+    */
+    PacketIndexer(const uint8_t* data, size_t length, FrameLocator frameLocator = NctrsUserDataFrame);
+
+    /// @brief Extracts all packets of the NCTRS file and records them.
+    /// @throw std::runtime_error  A frame is not valid.
+    void Run();
+
+    /// Gets the records of the packets, in extraction order.
+    const std::vector<PacketIndexEntry>& GetEntries() const { return m_entries; }
+
+    /// @brief Writes the index file, records sorted by APID, time and offset.
+    /// @throw std::runtime_error  The file cannot be written.
+    void Write(const std::string& fileName);
+};
+
+
+/** ****************************************************************************
+*  @ingroup ccsds_telemetry
+*
+*  @brief Queries a packet index file written by PacketIndexer.
+*
+*  The index file is mapped into memory, queries are binary searches.
+*/
+class PacketIndex
+{
+private:
+    /// The mapped index file.
+    std::unique_ptr<NctrsMappedFile> m_file;
+    /// The records, sorted by APID, time and offset.
+    const PacketIndexEntry* m_entries;
+    /// Number of records.
+    size_t m_count;
+
+public:
+    /// Identifies packet index files, first 8 bytes of the file.
+    static const char Magic[8];
+
+    /// @brief Opens a packet index file.
+    /// @throw std::runtime_error  The file cannot be read or is not a packet index.
+    explicit PacketIndex(const std::string& fileName);
+
+    /// Gets the number of indexed packets.
+    size_t GetCount() const { return m_count; }
+
+    /** ****************************************************************************
+    *  @brief Finds the packets of an APID within a time window.
+    *
+    *  @param [in] apid       The APID of the packets.
+    *  @param [in] timeStart  First time of the window, inclusive.
+    *  @param [in] timeStop   Last time of the window, exclusive.
+    *  @return The records of the packets, sorted by time.
+    */
+    std::vector<PacketIndexEntry> Find(uint16_t apid, uint64_t timeStart, uint64_t timeStop) const;
+
+    /// @brief Finds the packets of all APIDs within a time window, sorted by APID and time.
+    std::vector<PacketIndexEntry> Find(uint64_t timeStart, uint64_t timeStop) const;
+
+    /** ****************************************************************************
+    *  @brief Reads an indexed packet from the NCTRS file.
+    *
+    *  A packet inside a frame is copied directly, a packet split across frames
+    *  is reconstructed from the data unit where it starts.
+    *
+    *  @param [in]  data          Pointer to the first byte of the NCTRS file.
+    *  @param [in]  length        Length of the NCTRS file.
+    *  @param [in]  entry         The record of the packet.
+    *  @param [out] packet        The bytes of the packet.
+    *  @param [in]  frameLocator  Returns the frame of a data unit, as used to build the index.
+    *  @throw std::runtime_error  The packet cannot be found at its recorded location.
+    */
+    static void ReadPacket(const uint8_t* data, size_t length, const PacketIndexEntry& entry,
+                           std::vector<uint8_t>& packet, FrameLocator frameLocator = NctrsUserDataFrame);
+};
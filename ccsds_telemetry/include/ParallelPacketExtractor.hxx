@@ -0,0 +1,142 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Declaration of the ParallelPacketExtractor class
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-028 first released version
+*
+*/
+
+#pragma once
+
+#include <stdint.h>   // For explicit size integers (e.g. uint8_t, uint16_t)
+#include <stdexcept>  // For standard base exceptions such as runtime_exception
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "CcsdsFrameReader.hxx"
+#include "PacketExtractor.hxx"
+
+/** ****************************************************************************
+ *  @ingroup ccsds_telemetry
+ *
+ *  @brief Extracts the telemetry packets of several Virtual Channels in
+ *         parallel, one PacketExtractor per Virtual Channel, each in its own
+ *         thread.
+ *
+ *  Frames are dispatched to the Virtual Channel's thread through a bounded
+ *  queue, so the order of the frames, and therefore of the packets, is kept
+ *  within each Virtual Channel. There is no ordering between packets of
+ *  different Virtual Channels.
+ *
+ *  Frames are not copied: the memory of a frame passed to Add() must remain
+ *  valid until End() returns, which is the case when reading from a
+ *  NctrsMappedFile.
+ *
+ *  The callback of a Virtual Channel is always called from the thread of this
+ *  Virtual Channel, callbacks of different Virtual Channels are called
+ *  concurrently. Add() and End() must be called from a single thread.
+ */
+class ParallelPacketExtractor
+{
+private:
+    /// A Virtual Channel, its packet extractor and its queue of frames.
+    struct Channel
+    {
+        Channel(uint8_t virtualChannel, PacketCallback callback)
+            : extractor(virtualChannel, callback) {}
+
+        /// The packet extractor, only used by the thread of the channel until it ends.
+        PacketExtractor extractor;
+        /// Frames waiting to be processed: pointer and length.
+        std::deque<std::pair<const uint8_t*, uint16_t>> frames;
+        /// Set when no more frames will be added.
+        bool ended = false;
+        /// Protects frames and ended.
+        std::mutex mutex;
+        /// Signaled when a frame is added or the channel is ended.
+        std::condition_variable notEmpty;
+        /// Signaled when a frame is removed from the queue.
+        std::condition_variable notFull;
+        /// Exception thrown while processing a frame, processing stops after it.
+        std::exception_ptr exception;
+        /// The thread processing the frames.
+        std::thread thread;
+    };
+
+    /// Maximum number of frames waiting in the queue of a Virtual Channel.
+    size_t m_queueLength;
+    /// The Virtual Channels, by Virtual Channel ID.
+    std::map<uint8_t, std::unique_ptr<Channel>> m_channels;
+    /// Counter of frames of Virtual Channels without extractor.
+    uint32_t m_ignoredFrameCount = 0;
+    /// Set when End() was called.
+    bool m_ended = false;
+
+    /// Processes the frames of a Virtual Channel until it is ended.
+    void run(Channel& channel);
+
+    /// Ends all channels and waits for the threads, without reporting errors.
+    void stop();
+
+public:
+    /** ****************************************************************************
+     *  @brief Creates the packet extractors and starts one thread per Virtual Channel.
+     *
+     *  @param [in] callbacks    The callback of each Virtual Channel to extract,
+     *                           by Virtual Channel ID.
+     *  @param [in] queueLength  Maximum number of frames waiting to be processed
+     *                           per Virtual Channel, Add() blocks when reached.
+     */
+    ParallelPacketExtractor(const std::map<uint8_t, PacketCallback>& callbacks, size_t queueLength = 1024);
+
+    /// Stops the threads if End() was not called.
+    ~ParallelPacketExtractor();
+
+    ParallelPacketExtractor(const ParallelPacketExtractor&) = delete;
+    ParallelPacketExtractor& operator=(const ParallelPacketExtractor&) = delete;
+
+    /** ****************************************************************************
+     *  @brief Adds the next frame of a Virtual Channel.
+     *
+     *  @param [in] virtualChannel  The Virtual Channel of the frame, e.g. the
+     *                              VirtualChannelId field of the NCTRS TM data unit.
+     *  @param [in] frame           The frame, its memory must remain valid until End().
+     *  @return false if there is no extractor for this Virtual Channel and the
+     *          frame was ignored.
+     *
+     *  @throw std::runtime_error  The VCID header field of the frame is not
+     *                             @b virtualChannel, or End() was already called.
+     */
+    bool Add(uint8_t virtualChannel, const CcsdsFrameReader& frame);
+
+    /// @brief Adds the next frame, dispatched according to its VCID header field.
+    /// @throw std::runtime_error  End() was already called.
+    bool Add(const CcsdsFrameReader& frame) { return Add(frame.GetVcId(), frame); }
+
+    /** ****************************************************************************
+     *  @brief Waits until all frames are processed and ends the packet extractors.
+     *
+     *  @throw std::exception  The first exception thrown while processing the
+     *                         frames of a Virtual Channel, for instance by its
+     *                         callback.
+     */
+    void End();
+
+    /// @brief Gets the packet extractor of a Virtual Channel, to read its counters after End().
+    /// @throw std::out_of_range  There is no extractor for this Virtual Channel.
+    const PacketExtractor& GetExtractor(uint8_t virtualChannel) const { return m_channels.at(virtualChannel)->extractor; }
+
+    /// Gets the number of frames ignored because there is no extractor for their Virtual Channel.
+    uint32_t GetIgnoredFrameCount() const { return m_ignoredFrameCount; }
+};
@@ -6,63 +6,97 @@
 *
 *  @author Florian George ELSE
 *
-*  @version 1.0   2015-04-17 FGE first released version
+*  @version 13.2  2026-10-19 agent user-026 Slicing-by-8 table driven computation with
+*                                           thread-safe initialization of the tables.
+*  @version 1.0   2015-04-17 FGE  first released version
 *
 *  CRC computation code taken and adapted from annex A.1 of the ECSS-E-70-41A
 *  (30 january 2003 issue) standard for CCSDS packets.
+*
+*  The look-up table of the standard is extended to 8 tables to process 8 bytes
+*  per iteration ("slicing-by-8"): slice[k][i] is the syndrome contribution
+*  of byte i followed by k zero bytes.
 */
 
 #include "CcsdsPacketCrc.hxx"
 
-// CRC look-up table
-static uint16_t s_lookUpTable[256] = { 0 };
+// Number of bytes processed per iteration, i.e. number of look-up tables
+static const size_t SliceCount = 8;
 
-// Initializes the look-up table used by CcsdsPacketComputeCrc.
-static void initCcsdsPacketCrcTable(void)
+// CRC look-up tables
+struct CcsdsPacketCrcTables
 {
-    uint16_t i, tmp;
+    uint16_t slice[SliceCount][256];
 
-    for (i = 0; i<256; i++)
+    // Initializes the look-up tables used by CcsdsPacketCrcCompute.
+    CcsdsPacketCrcTables()
     {
-        tmp = 0;
-        if ((i & 1) != 0)
-            tmp = tmp ^ 0x1021;
-        if ((i & 2) != 0)
-            tmp = tmp ^ 0x2042;
-        if ((i & 4) != 0)
-            tmp = tmp ^ 0x4084;
-        if ((i & 8) != 0)
-            tmp = tmp ^ 0x8108;
-        if ((i & 16) != 0)
-            tmp = tmp ^ 0x1231;
-        if ((i & 32) != 0)
-            tmp = tmp ^ 0x2462;
-        if ((i & 64) != 0)
-            tmp = tmp ^ 0x48C4;
-        if ((i & 128) != 0)
-            tmp = tmp ^ 0x9188;
-        s_lookUpTable[i] = tmp;
+        // Look-up table of the standard, one byte at a time
+        for (uint16_t i = 0; i < 256; i++)
+        {
+            uint16_t tmp = 0;
+            if ((i & 1) != 0)
+                tmp = tmp ^ 0x1021;
+            if ((i & 2) != 0)
+                tmp = tmp ^ 0x2042;
+            if ((i & 4) != 0)
+                tmp = tmp ^ 0x4084;
+            if ((i & 8) != 0)
+                tmp = tmp ^ 0x8108;
+            if ((i & 16) != 0)
+                tmp = tmp ^ 0x1231;
+            if ((i & 32) != 0)
+                tmp = tmp ^ 0x2462;
+            if ((i & 64) != 0)
+                tmp = tmp ^ 0x48C4;
+            if ((i & 128) != 0)
+                tmp = tmp ^ 0x9188;
+            slice[0][i] = tmp;
+        }
+
+        // Each following table pushes the previous one through one more zero byte
+        for (size_t k = 1; k < SliceCount; k++)
+            for (size_t i = 0; i < 256; i++)
+            {
+                uint16_t previous = slice[k-1][i];
+                slice[k][i] = ((previous << 8) & 0xFF00) ^ slice[0][previous >> 8];
+            }
     }
+};
+
+// Returns the look-up tables, initialized once in a thread-safe way (C++11 static local)
+static const CcsdsPacketCrcTables& getCcsdsPacketCrcTables()
+{
+    static const CcsdsPacketCrcTables tables;
+    return tables;
 }
 
 // Computes the CCSDS packet CRC of a single byte with a specified syndrome.
-static uint16_t ccsdsPacketCrcComputeByte(uint8_t data, uint16_t syndrome)
+static inline uint16_t ccsdsPacketCrcComputeByte(const uint16_t (&table)[256], uint8_t data, uint16_t syndrome)
 {
-    return (((syndrome << 8) & 0xFF00) ^ s_lookUpTable[(((syndrome >> 8) ^ data) & 0x00FF)]);
+    return (((syndrome << 8) & 0xFF00) ^ table[(((syndrome >> 8) ^ data) & 0x00FF)]);
 }
 
-
-// Computes the CCSDS packet CRC of a specified memory buffer.
-uint16_t CcsdsPacketCrcCompute(const uint8_t *buffer, size_t length)
+// Computes the CCSDS packet CRC of 8 consecutive bytes with a specified syndrome.
+static inline uint16_t ccsdsPacketCrcComputeSlice(const uint16_t (&t)[SliceCount][256], const uint8_t *data, uint16_t syndrome)
 {
-    // Lazy initialize CRC look-up table if needed
-    if (s_lookUpTable[0] == 0)
-        initCcsdsPacketCrcTable();
+    return t[7][(syndrome >> 8) ^ data[0]] ^ t[6][(syndrome & 0xFF) ^ data[1]] ^
+           t[5][data[2]] ^ t[4][data[3]] ^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+}
 
-    // Compute checksum for data buffer
-    uint16_t syndrome = 0xFFFF; // Init syndrome
-    for (size_t i = 0; i < length; i++)
-        syndrome = ccsdsPacketCrcComputeByte(buffer[i], syndrome);
+// Continues the computation of the CCSDS packet CRC of a memory buffer with a specified syndrome.
+static uint16_t ccsdsPacketCrcContinue(const CcsdsPacketCrcTables& tables, const uint8_t *buffer, size_t length, uint16_t syndrome)
+{
+    for (; length >= SliceCount; length -= SliceCount, buffer += SliceCount)
+        syndrome = ccsdsPacketCrcComputeSlice(tables.slice, buffer, syndrome);
+    for (; length > 0; length--)
+        syndrome = ccsdsPacketCrcComputeByte(tables.slice[0], *(buffer++), syndrome);
     return syndrome;
 }
 
+
+// Computes the CCSDS packet CRC of a specified memory buffer.
+uint16_t CcsdsPacketCrcCompute(const uint8_t *buffer, size_t length)
+{
+    return ccsdsPacketCrcContinue(getCcsdsPacketCrcTables(), buffer, length, 0xFFFF);
+}
@@ -6,12 +6,23 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2  2026-10-19 agent user-028 Added NctrsMappedFile. Do not read a header at the end of the file.
+*                                           Header reading moved to NctrsFileReader::ReadHeader (user-029).
 *  @version 6.0   2016-06-24 FGE  Initial implementation, can iterate the NCTRS Telemetry Data Units from a NCTRS file loading in memory.
 *
 */
 
 #include "NctrsFileReader.hxx"
 
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 using namespace std;
 
 
@@ -23,6 +34,21 @@ NctrsFileReader::NctrsFileReader(const uint8_t* data, size_t length)
 {
 }
 
+// Reads the NCTRS header of a Telemetry Data Unit.
+void NctrsFileReader::ReadHeader(const uint8_t* data, NctrsTmDu& tmDu)
+{
+    CcsdsFieldReader reader(data, NctrsHeaderLength);
+    tmDu.PacketSize = reader.Read<uint32_t>();
+    tmDu.SpacecraftId = reader.Read<uint16_t>();
+    tmDu.DataStreamType = reader.Read<uint8_t>();
+    tmDu.VirtualChannelId = reader.Read<uint8_t>();
+    tmDu.RouteId = reader.Read<uint16_t>();
+    tmDu.EarthReceptionTime = reader.Read<uint64_t>();
+    tmDu.SequenceFlag = reader.Read<uint8_t>();
+    tmDu.QualityFlag = reader.Read<uint8_t>();
+    tmDu.UserData = data + NctrsHeaderLength;
+}
+
 
 //==============================
 // NctrsFileReaderIterator class
@@ -30,22 +56,17 @@ NctrsFileReader::NctrsFileReader(const uint8_t* data, size_t length)
 NctrsFileReaderIterator::NctrsFileReaderIterator(const uint8_t* start, const uint8_t* end)
     : m_pointer(start), m_end(end)
 {
-    readCurrent();
+    // Do not read past the end of the file, e.g. for the end iterator
+    if (m_pointer < m_end && (size_t)(m_end - m_pointer) >= NctrsFileReader::NctrsHeaderLength)
+        readCurrent();
+    else
+        m_pointer = m_end;
 }
 
 // Reads the values of the current NCTRS header.
 void NctrsFileReaderIterator::readCurrent()
 {
-    CcsdsFieldReader reader(m_pointer, NctrsFileReader::NctrsHeaderLength);
-    m_current.PacketSize = reader.Read<uint32_t>();
-    m_current.SpacecraftId = reader.Read<uint16_t>();
-    m_current.DataStreamType = reader.Read<uint8_t>();
-    m_current.VirtualChannelId = reader.Read<uint8_t>();
-    m_current.RouteId = reader.Read<uint16_t>();
-    m_current.EarthReceptionTime = reader.Read<uint64_t>();
-    m_current.SequenceFlag = reader.Read<uint8_t>();
-    m_current.QualityFlag = reader.Read<uint8_t>();
-    m_current.UserData = m_pointer + NctrsFileReader::NctrsHeaderLength;
+    NctrsFileReader::ReadHeader(m_pointer, m_current);
 }
 
 // Returns the current NCTRS header.
@@ -58,7 +79,7 @@ const NctrsTmDu& NctrsFileReaderIterator::operator*() const
 NctrsFileReaderIterator& NctrsFileReaderIterator::operator++()
 {
     m_pointer += m_current.PacketSize;
-    if (m_pointer >= m_end)
+    if (m_pointer >= m_end || (size_t)(m_end - m_pointer) < NctrsFileReader::NctrsHeaderLength)
         m_pointer = m_end;
     else
         readCurrent();
@@ -76,3 +97,48 @@ bool NctrsFileReaderIterator::operator!=(const NctrsFileReaderIterator& other) c
 {
     return (m_pointer != other.m_pointer);
 }
+
+
+//==============================
+// NctrsMappedFile class
+
+NctrsMappedFile::NctrsMappedFile(const string& fileName)
+    : m_data(nullptr), m_length(0)
+{
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw runtime_error("Cannot open NCTRS file " + fileName + ": " + strerror(errno));
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0)
+    {
+        int fstatErrno = errno;
+        close(fd);
+        throw runtime_error("Cannot get size of NCTRS file " + fileName + ": " + strerror(fstatErrno));
+    }
+    m_length = (size_t)fileStat.st_size;
+
+    // An empty file cannot be mapped, it simply has no data
+    if (m_length > 0)
+    {
+        void* data = mmap(nullptr, m_length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED)
+        {
+            int mmapErrno = errno;
+            close(fd);
+            throw runtime_error("Cannot map NCTRS file " + fileName + " into memory: " + strerror(mmapErrno));
+        }
+        // Only a hint, failure is not an error
+        madvise(data, m_length, MADV_SEQUENTIAL);
+        m_data = static_cast<const uint8_t*>(data);
+    }
+
+    // The mapping stays valid after closing the file descriptor
+    close(fd);
+}
+
+NctrsMappedFile::~NctrsMappedFile()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<uint8_t*>(m_data), m_length);
+}
@@ -0,0 +1,116 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Implementation of the NctrsStreamReader class
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-029 first released version
+*
+*/
+
+#include "NctrsStreamReader.hxx"
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include <poll.h>
+#include <unistd.h>
+
+using namespace std;
+
+
+NctrsStreamReader::NctrsStreamReader(int fd, size_t maxDataUnits, size_t maxDataUnitLength)
+    : m_fd(fd), m_maxDataUnitLength(maxDataUnitLength)
+{
+    if (fd < 0)
+        throw invalid_argument("Invalid file descriptor for the NCTRS stream.");
+    if (maxDataUnits == 0 || maxDataUnitLength < NctrsFileReader::NctrsHeaderLength)
+        throw invalid_argument("The NCTRS stream buffer must hold at least one data unit.");
+
+    m_buffer.resize(maxDataUnits * maxDataUnitLength);
+}
+
+// Reads available bytes into the buffer, blocks until at least one byte is read
+bool NctrsStreamReader::fill()
+{
+    // Move the remaining bytes of the current data unit to the start of the buffer
+    if (m_begin > 0)
+    {
+        memmove(&m_buffer[0], &m_buffer[m_begin], m_end - m_begin);
+        m_end -= m_begin;
+        m_begin = 0;
+    }
+
+    int waited = 0;
+    while (true)
+    {
+        ssize_t count = read(m_fd, &m_buffer[m_end], m_buffer.size() - m_end);
+        if (count > 0)
+        {
+            m_end += count;
+            m_byteCount += count;
+            return true;
+        }
+
+        if (count == 0)
+        {
+            // End of file: it may still grow when following a file
+            if (waited >= m_followTimeout)
+                return false;
+            const int pollPeriod = 10;
+            usleep(pollPeriod * 1000);
+            waited += pollPeriod;
+        }
+        else if (errno == EAGAIN || errno == EWOULDBLOCK)
+        {
+            // Non-blocking file descriptor, wait for data
+            pollfd pfd;
+            pfd.fd = m_fd;
+            pfd.events = POLLIN;
+            poll(&pfd, 1, -1);
+        }
+        else if (errno != EINTR)
+        {
+            throw runtime_error(string("Cannot read from the NCTRS stream: ") + strerror(errno));
+        }
+    }
+}
+
+// Gets the next data unit, blocks until all its bytes are received
+bool NctrsStreamReader::Next(NctrsTmDu& tmDu)
+{
+    if (m_endOfStream)
+        return false;
+
+    // Wait for the header, to know the length of the data unit
+    while (m_end - m_begin < NctrsFileReader::NctrsHeaderLength)
+        if (!fill())
+        {
+            m_endOfStream = true;
+            if (m_end != m_begin)
+                throw runtime_error("The NCTRS stream ends in the middle of a data unit header.");
+            return false;
+        }
+
+    NctrsFileReader::ReadHeader(&m_buffer[m_begin], tmDu);
+    if (tmDu.PacketSize < NctrsFileReader::NctrsHeaderLength || tmDu.PacketSize > m_maxDataUnitLength)
+        throw runtime_error("Invalid NCTRS data unit length " + to_string(tmDu.PacketSize) +
+                            ", maximum is " + to_string(m_maxDataUnitLength) + ".");
+
+    // Wait for the rest of the data unit
+    while (m_end - m_begin < tmDu.PacketSize)
+        if (!fill())
+        {
+            m_endOfStream = true;
+            throw runtime_error("The NCTRS stream ends in the middle of a data unit.");
+        }
+
+    // The data unit may have been moved in the buffer while waiting
+    tmDu.UserData = &m_buffer[m_begin] + NctrsFileReader::NctrsHeaderLength;
+    m_begin += tmDu.PacketSize;
+    m_dataUnitCount++;
+    return true;
+}
@@ -6,6 +6,9 @@
 *
 *  @author Florian George ELSE
 *
+*  @version 13.2   2026-10-19 agent user-027 Reuse a pre-allocated buffer for reconstructed packets,
+*                                            count anomalies, no message formatting before logging.
+*                                            Limit the number of log entries of anomalies per VC (user-047).
 *  @version 12.0.2 2020-02-19 FGE  Do not count a FHP!=0 in first frame as an error anymore, log info instead (#20932).
 *  @version 11.4.1 2019-07-05 FGE  Ignore remaining bytes of last frame if only zeroes or start of idle packet (#19175). Log when incomplete packet at end of last frame.
 *  @version 10.3   2018-10-29 FGE  Use common_sw's logger module for logging by default, use cerr when NO_COMMON_SW defined (#16198).
@@ -26,15 +29,40 @@ using namespace std;
     string error("Error: ");
     string warn("Warning: ");
     string info("Info: ");
+
+    // All anomalies are logged
+    struct NoLogLimiter { bool allow(const string&) { return true; } };
+    static NoLogLimiter s_missingFrameLog, s_protocolViolationLog, s_idleDataLog;
 #else
 #include <Logger.hxx>
+#include <LogLimiter.hxx>
+
+    // Limit the log entries of anomalies that can be found in every frame of a bad pass
+    static LogLimiter s_missingFrameLog(WARN_LEVEL, "Missing frame(s)");
+    static LogLimiter s_protocolViolationLog(ERROR_LEVEL, "CCSDS Frame protocol violation");
+    static LogLimiter s_idleDataLog(INFO_LEVEL, "Found idle data in frame");
 #endif
 
+// Key of the log limiters
+static string vcKey(uint8_t virtualChannel)
+{
+    return "VC " + to_string((int)virtualChannel);
+}
+
 
 // Creates a Packet Extractor for the given memory Virtual Channel
 PacketExtractor::PacketExtractor(uint8_t virtualChannel, PacketCallback callback)
     : m_virtualChannel(virtualChannel), m_callback(callback)
 {
+    // Allocate once the memory for the largest packet to reconstruct
+    m_packetBytes.reserve(MaxPacketLength);
+}
+
+// Appends bytes to the packet being reconstructed
+void PacketExtractor::appendPacketBytes(const uint8_t* data, uint16_t length)
+{
+    // Within reserved capacity for valid packets, insert does not allocate
+    m_packetBytes.insert(m_packetBytes.end(), data, data + length);
 }
 
 // Adds the next frame of the telemetry stream and calls the callback for each packet that are fully extracted
@@ -59,13 +87,15 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
         missedFrame = true;
         
         // Output missing frame details for debug
-        logger << warn << "Missing " << (int)missedCount << " frame(s) between counter "
-            << (int)(uint8_t)(m_expectedVcFrameCount-1) << " and " << (int)vcFrameCount << "." << endl;
+        if (s_missingFrameLog.allow(vcKey(m_virtualChannel)))
+            logger << warn << "Missing " << (int)missedCount << " frame(s) between counter "
+                << (int)(uint8_t)(m_expectedVcFrameCount-1) << " and " << (int)vcFrameCount << "." << endl;
         
         // If we have a partial packet being reconstructed, it is lost as well
         if(m_packetBytes.size() != 0)
         {
             m_packetBytes.clear();
+            m_packetStart = nullptr;
             m_lostPacketCount++;
         }
     }
@@ -91,9 +121,14 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
     {
         // No frame was missed, should not be happening
         if (!missedFrame)
-            logger << error << "CCSDS Frame protocol violation: expected remaining bytes of packet started in previous frame, but got FHP=0 (VCFC="<<(int)vcFrameCount<<")." << endl;
+        {
+            m_protocolViolationCount++;
+            if (s_protocolViolationLog.allow(vcKey(m_virtualChannel)))
+                logger << error << "CCSDS Frame protocol violation: expected remaining bytes of packet started in previous frame, but got FHP=0 (VCFC="<<(int)vcFrameCount<<")." << endl;
+        }
 
         m_packetBytes.clear();
+        m_packetStart = nullptr;
         m_lostPacketCount++;
     }
     // End/next bytes of segmented packet, we don't have its start
@@ -104,17 +139,20 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
         // Protocol violation, FHP value is wrong, should be 0
         if (!missedFrame)
         {
-            string message = (boost::format("CCSDS Frame protocol violation in frame #%1%: expected FHP=0 but got FHP=%2% (VCFC=%3%).") % m_frameCount % (int)fhp % (int)vcFrameCount).str();
             // Not an error if in first frame, see #20932
             if (m_frameCount == 1)
             {
-                logger << info << message << endl;
+                logger << info << "CCSDS Frame protocol violation in frame #" << m_frameCount << ": expected FHP=0 but got FHP="
+                       << (int)fhp << " (VCFC=" << (int)vcFrameCount << ")." << endl;
             }
             // Otherwise an error and assume packet lost (bytes before FHP value)
             else
             {
                 m_lostPacketCount++;
-                logger << error << message << endl;
+                m_protocolViolationCount++;
+                if (s_protocolViolationLog.allow(vcKey(m_virtualChannel)))
+                    logger << error << "CCSDS Frame protocol violation in frame #" << m_frameCount << ": expected FHP=0 but got FHP="
+                           << (int)fhp << " (VCFC=" << (int)vcFrameCount << ")." << endl;
             }
         }
 
@@ -140,7 +178,7 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
             byteCount = bytesRemaining;
 
         // Append bytes to packet be reconstructed
-        m_packetBytes.insert(m_packetBytes.end(), dataPtr, dataPtr+byteCount);
+        appendPacketBytes(dataPtr, byteCount);
         dataPtr += byteCount;
         bytesRemaining -= byteCount;
 
@@ -157,21 +195,28 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
                 // Packet is complete, can callback the extraction
                 m_callback(reader, true);
                 m_packetExtractedCount++;
+                m_reconstructedPacketCount++;
                 hasCompletePacket = true;
 
                 // Reset packet buffer for next partial packet
                 m_packetBytes.clear();
+                m_packetStart = nullptr;
             }
         }
         
         // If packet was supposed to end but we don't have enough bytes, it is lost
         if(!hasCompletePacket && fhp != CcsdsFrameReader::FhpNoPacketStart)
         {
-            if (packetLength > 0)
-                logger << error << "CCSDS Frame protocol violation: missing " << (int64_t)(packetLength-m_packetBytes.size()) << " bytes to reconstruct packet of " << packetLength << " bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
-            else
-                logger << error << "CCSDS Frame protocol violation: missing bytes to reconstruct packet, only had " << (uint64_t)(m_packetBytes.size()) << " bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
+            m_protocolViolationCount++;
+            if (s_protocolViolationLog.allow(vcKey(m_virtualChannel)))
+            {
+                if (packetLength > 0)
+                    logger << error << "CCSDS Frame protocol violation: missing " << (int64_t)(packetLength-m_packetBytes.size()) << " bytes to reconstruct packet of " << packetLength << " bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
+                else
+                    logger << error << "CCSDS Frame protocol violation: missing bytes to reconstruct packet, only had " << (uint64_t)(m_packetBytes.size()) << " bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
+            }
             m_packetBytes.clear();
+            m_packetStart = nullptr;
             m_lostPacketCount++;
         }
     }
@@ -192,7 +237,9 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
             // TODO: Ensure using correct idle bytes value, currently assuming zeros
             if (packetLength == 7 && reader.GetPacketErrorControl() == 0x0000)
             {
-                logger << info << "Found idle data in frame, ignoring remaining bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
+                m_idleDataCount++;
+                if (s_idleDataLog.allow(vcKey(m_virtualChannel)))
+                    logger << info << "Found idle data in frame, ignoring remaining bytes (VCFC="<<(int)vcFrameCount<<")." << endl;
                 bytesRemaining = 0;
                 continue;
             }
@@ -215,7 +262,8 @@ void PacketExtractor::Add(const CcsdsFrameReader& frame)
         {
             // Packet starts in frame, but is not complete, copy its start into packet buffer
             m_packetBytes.clear();
-            m_packetBytes.insert(m_packetBytes.end(), dataPtr, dataPtr+bytesRemaining);
+            m_packetStart = dataPtr;
+            appendPacketBytes(dataPtr, bytesRemaining);
             dataPtr += bytesRemaining;
             bytesRemaining = 0;
         }
@@ -243,5 +291,6 @@ void PacketExtractor::End()
             logger << warn << (int)m_packetBytes[0] << "-" << (int)m_packetBytes[1] << "-" << (int)m_packetBytes[2] << "-" << (int)m_packetBytes[3] << "-" << endl;
             m_lostPacketCount++;
         }
+        m_packetStart = nullptr;
     }
 }
\ No newline at end of file
@@ -0,0 +1,253 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Implementation of the PacketIndexer and PacketIndex classes
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-030 first released version
+*
+*  Layout of the index file: the 8 bytes of PacketIndex::Magic, the number of
+*  records as uint64_t, then the PacketIndexEntry records.
+*/
+
+#include "PacketIndex.hxx"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+using namespace std;
+
+static_assert(sizeof(PacketIndexEntry) == 40, "PacketIndexEntry is written as is in index files");
+
+// Length of the index file header: magic and number of records
+static const size_t IndexHeaderLength = 16;
+
+const char PacketIndex::Magic[8] = { 'P', 'K', 'T', 'I', 'D', 'X', '0', '1' };
+
+// Order of the records in the index file
+static bool entryLess(const PacketIndexEntry& a, const PacketIndexEntry& b)
+{
+    if (a.Apid != b.Apid)
+        return a.Apid < b.Apid;
+    if (a.Time != b.Time)
+        return a.Time < b.Time;
+    return a.PacketOffset < b.PacketOffset;
+}
+
+// Frame locator of data units whose user data is exactly one frame
+CcsdsFrameReader NctrsUserDataFrame(const NctrsTmDu& tmDu)
+{
+    return CcsdsFrameReader(tmDu.UserData, (uint16_t)(tmDu.PacketSize - NctrsFileReader::NctrsHeaderLength));
+}
+
+
+//==============================
+// PacketIndexer class
+
+PacketIndexer::PacketIndexer(const uint8_t* data, size_t length, FrameLocator frameLocator)
+    : m_data(data), m_length(length), m_frameLocator(frameLocator)
+{
+}
+
+// Records a packet extracted from a Virtual Channel
+void PacketIndexer::addPacket(uint8_t virtualChannel, const CcsdsPacketReader& packet, bool reconstructed)
+{
+    Channel& channel = m_channels[virtualChannel];
+
+    PacketIndexEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.Apid = packet.GetApid();
+    entry.SequenceCount = packet.GetSequenceCount();
+    entry.VirtualChannel = virtualChannel;
+    entry.Reconstructed = reconstructed ? 1 : 0;
+    entry.PacketLength = packet.GetPacketLength();
+
+    // Packets without a full data field header have no service type nor time
+    if (entry.PacketLength >= CcsdsPacketReader::HeaderLength + CcsdsPacketReader::DataHeaderLength)
+    {
+        entry.ServiceType = packet.GetServiceType();
+        entry.ServiceSubtype = packet.GetServiceSubtype();
+        entry.Time = packet.GetTime();
+    }
+
+    if (reconstructed)
+    {
+        // The packet was copied, its location is where it started
+        entry.PacketOffset = channel.extractor->GetReconstructedPacketStart() - m_data;
+        entry.DataUnitOffset = channel.packetStartDataUnitOffset;
+    }
+    else
+    {
+        entry.PacketOffset = packet.GetBuffer() - m_data;
+        entry.DataUnitOffset = channel.dataUnitOffset;
+    }
+    m_entries.push_back(entry);
+}
+
+// Extracts all packets of the NCTRS file and records them
+void PacketIndexer::Run()
+{
+    NctrsFileReader reader(m_data, m_length);
+    for (const auto& tmDu : reader)
+    {
+        uint8_t virtualChannel = tmDu.VirtualChannelId;
+        Channel& channel = m_channels[virtualChannel];
+        if (!channel.extractor)
+            channel.extractor.reset(new PacketExtractor(virtualChannel,
+                [this, virtualChannel](CcsdsPacketReader packet, bool reconstructed)
+                {
+                    addPacket(virtualChannel, packet, reconstructed);
+                }));
+
+        channel.dataUnitOffset = (tmDu.UserData - NctrsFileReader::NctrsHeaderLength) - m_data;
+        channel.extractor->Add(m_frameLocator(tmDu));
+
+        // Remember in which data unit a new packet started to be reconstructed
+        const uint8_t* packetStart = channel.extractor->GetReconstructedPacketStart();
+        if (packetStart != channel.packetStart)
+        {
+            channel.packetStart = packetStart;
+            channel.packetStartDataUnitOffset = channel.dataUnitOffset;
+        }
+    }
+
+    for (auto& channel : m_channels)
+        channel.second.extractor->End();
+}
+
+// Writes the index file, records sorted by APID, time and offset
+void PacketIndexer::Write(const string& fileName)
+{
+    vector<PacketIndexEntry> entries(m_entries);
+    stable_sort(entries.begin(), entries.end(), entryLess);
+
+    ofstream file(fileName.c_str(), ios::binary | ios::trunc);
+    uint64_t count = entries.size();
+    file.write(PacketIndex::Magic, sizeof(PacketIndex::Magic));
+    file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    if (count > 0)
+        file.write(reinterpret_cast<const char*>(&entries[0]), count * sizeof(PacketIndexEntry));
+    file.close();
+    if (!file)
+        throw runtime_error("Cannot write packet index file " + fileName);
+}
+
+
+//==============================
+// PacketIndex class
+
+PacketIndex::PacketIndex(const string& fileName)
+    : m_file(new NctrsMappedFile(fileName)), m_entries(nullptr), m_count(0)
+{
+    const uint8_t* data = m_file->GetData();
+    size_t length = m_file->GetLength();
+    if (length < IndexHeaderLength || memcmp(data, Magic, sizeof(Magic)) != 0)
+        throw runtime_error("The file " + fileName + " is not a packet index file.");
+
+    // The count is compared to the length first, a corrupted count cannot overflow
+    uint64_t count;
+    memcpy(&count, data + sizeof(Magic), sizeof(count));
+    if (count > (length - IndexHeaderLength) / sizeof(PacketIndexEntry) ||
+        length != IndexHeaderLength + count * sizeof(PacketIndexEntry))
+        throw runtime_error("The packet index file " + fileName + " is truncated or corrupted.");
+
+    m_entries = reinterpret_cast<const PacketIndexEntry*>(data + IndexHeaderLength);
+    m_count = count;
+}
+
+// Finds the packets of an APID within a time window
+vector<PacketIndexEntry> PacketIndex::Find(uint16_t apid, uint64_t timeStart, uint64_t timeStop) const
+{
+    PacketIndexEntry first;
+    memset(&first, 0, sizeof(first));
+    first.Apid = apid;
+    first.Time = timeStart;
+    PacketIndexEntry last = first;
+    last.Time = timeStop;
+
+    const PacketIndexEntry* end = m_entries + m_count;
+    const PacketIndexEntry* begin = lower_bound(m_entries, end, first, entryLess);
+    return vector<PacketIndexEntry>(begin, lower_bound(begin, end, last, entryLess));
+}
+
+// Finds the packets of all APIDs within a time window
+vector<PacketIndexEntry> PacketIndex::Find(uint64_t timeStart, uint64_t timeStop) const
+{
+    vector<PacketIndexEntry> result;
+    const PacketIndexEntry* end = m_entries + m_count;
+    const PacketIndexEntry* position = m_entries;
+    while (position != end)
+    {
+        // Binary search of the window in the records of this APID, then jump to next APID
+        uint16_t apid = position->Apid;
+        vector<PacketIndexEntry> found = Find(apid, timeStart, timeStop);
+        result.insert(result.end(), found.begin(), found.end());
+        if (apid == 0xFFFF)
+            break;
+        PacketIndexEntry nextApid;
+        memset(&nextApid, 0, sizeof(nextApid));
+        nextApid.Apid = apid + 1;
+        position = lower_bound(position, end, nextApid, entryLess);
+    }
+    return result;
+}
+
+// Reads an indexed packet from the NCTRS file
+void PacketIndex::ReadPacket(const uint8_t* data, size_t length, const PacketIndexEntry& entry,
+                             vector<uint8_t>& packet, FrameLocator frameLocator)
+{
+    // Packet inside one frame, no decoding needed
+    if (!entry.Reconstructed)
+    {
+        if (entry.PacketOffset > length || entry.PacketLength > length - entry.PacketOffset)
+            throw runtime_error("The indexed packet is outside of the NCTRS file.");
+        packet.assign(data + entry.PacketOffset, data + entry.PacketOffset + entry.PacketLength);
+        return;
+    }
+
+    // Packet split across frames, it must start in the user data of the data unit
+    if (entry.DataUnitOffset > length || length - entry.DataUnitOffset < NctrsFileReader::NctrsHeaderLength)
+        throw runtime_error("The data unit of the indexed packet is outside of the NCTRS file.");
+    NctrsTmDu dataUnit;
+    NctrsFileReader::ReadHeader(data + entry.DataUnitOffset, dataUnit);
+    if (dataUnit.PacketSize < NctrsFileReader::NctrsHeaderLength || dataUnit.PacketSize > length - entry.DataUnitOffset ||
+        entry.PacketOffset < entry.DataUnitOffset + NctrsFileReader::NctrsHeaderLength ||
+        entry.PacketOffset >= entry.DataUnitOffset + dataUnit.PacketSize)
+        throw runtime_error("The indexed packet is outside of its data unit in the NCTRS file.");
+
+    // Reconstruct it from the data unit where it starts
+    const uint8_t* packetStart = data + entry.PacketOffset;
+    bool found = false;
+    PacketExtractor* extractorPtr = nullptr;
+    PacketExtractor extractor(entry.VirtualChannel, [&](CcsdsPacketReader reader, bool reconstructed)
+    {
+        if (reconstructed && extractorPtr->GetReconstructedPacketStart() == packetStart)
+        {
+            packet.assign(reader.GetBuffer(), reader.GetBuffer() + reader.GetPacketLength());
+            found = true;
+        }
+    });
+    extractorPtr = &extractor;
+
+    const uint8_t* end = data + length;
+    NctrsFileReader reader(data + entry.DataUnitOffset, length - entry.DataUnitOffset);
+    for (auto it = reader.begin(); it != reader.end() && !found; ++it)
+    {
+        // A truncated last data unit ends the search
+        const uint8_t* dataUnitStart = (*it).UserData - NctrsFileReader::NctrsHeaderLength;
+        if ((*it).PacketSize < NctrsFileReader::NctrsHeaderLength || (*it).PacketSize > (size_t)(end - dataUnitStart))
+            break;
+        if ((*it).VirtualChannelId != entry.VirtualChannel)
+            continue;
+        extractor.Add(frameLocator(*it));
+        // The packet is lost if it is not being reconstructed anymore
+        if (!found && extractor.GetReconstructedPacketStart() != packetStart)
+            break;
+    }
+
+    if (!found)
+        throw runtime_error("The indexed packet cannot be reconstructed from the NCTRS file.");
+}
@@ -0,0 +1,135 @@
+/** ****************************************************************************
+*  @file
+*
+*  @ingroup ccsds_telemetry
+*  @brief Implementation of the ParallelPacketExtractor class
+*
+*  @author agent
+*
+*  @version 13.2  2026-10-19 agent user-028 first released version
+*
+*/
+
+#include "ParallelPacketExtractor.hxx"
+
+using namespace std;
+
+
+// Creates the packet extractors and starts one thread per Virtual Channel
+ParallelPacketExtractor::ParallelPacketExtractor(const map<uint8_t, PacketCallback>& callbacks, size_t queueLength)
+    : m_queueLength(queueLength > 0 ? queueLength : 1)
+{
+    for (auto& callback : callbacks)
+        m_channels[callback.first].reset(new Channel(callback.first, callback.second));
+
+    // Start threads once all channels exist
+    for (auto& channel : m_channels)
+    {
+        Channel& ch = *channel.second;
+        ch.thread = thread([this, &ch] { run(ch); });
+    }
+}
+
+ParallelPacketExtractor::~ParallelPacketExtractor()
+{
+    stop();
+}
+
+// Processes the frames of a Virtual Channel until it is ended
+void ParallelPacketExtractor::run(Channel& channel)
+{
+    deque<pair<const uint8_t*, uint16_t>> frames;
+    while (true)
+    {
+        // Take all waiting frames at once, to lock once per batch instead of once per frame
+        {
+            unique_lock<mutex> lock(channel.mutex);
+            channel.notEmpty.wait(lock, [&channel] { return !channel.frames.empty() || channel.ended; });
+            if (channel.frames.empty())
+                return;
+            frames.swap(channel.frames);
+        }
+        channel.notFull.notify_one();
+
+        for (auto& frame : frames)
+        {
+            // After an error, the remaining frames are only drained
+            if (channel.exception)
+                break;
+            try
+            {
+                channel.extractor.Add(CcsdsFrameReader(frame.first, frame.second));
+            }
+            catch (...)
+            {
+                channel.exception = current_exception();
+            }
+        }
+        frames.clear();
+    }
+}
+
+// Adds the next frame of a Virtual Channel
+bool ParallelPacketExtractor::Add(uint8_t virtualChannel, const CcsdsFrameReader& frame)
+{
+    if (m_ended)
+        throw runtime_error("Cannot add a frame to the parallel packet extractor after End().");
+
+    auto it = m_channels.find(virtualChannel);
+    if (it == m_channels.end())
+    {
+        m_ignoredFrameCount++;
+        return false;
+    }
+
+    // Checked here, the extractor would only report it from its thread at End()
+    if (frame.GetVcId() != virtualChannel)
+        throw runtime_error("Telemetry transfer frame belongs to virtual channel " + to_string((int)frame.GetVcId()) +
+                            ", it was added to virtual channel " + to_string((int)virtualChannel) + ".");
+
+    Channel& channel = *it->second;
+    bool wasEmpty;
+    {
+        unique_lock<mutex> lock(channel.mutex);
+        channel.notFull.wait(lock, [this, &channel] { return channel.frames.size() < m_queueLength; });
+        wasEmpty = channel.frames.empty();
+        channel.frames.push_back(make_pair(frame.GetBuffer(), frame.GetFrameLength()));
+    }
+    // The thread only waits when the queue is empty
+    if (wasEmpty)
+        channel.notEmpty.notify_one();
+    return true;
+}
+
+// Ends all channels and waits for the threads
+void ParallelPacketExtractor::stop()
+{
+    for (auto& channel : m_channels)
+    {
+        {
+            lock_guard<mutex> lock(channel.second->mutex);
+            channel.second->ended = true;
+        }
+        channel.second->notEmpty.notify_one();
+    }
+    for (auto& channel : m_channels)
+        if (channel.second->thread.joinable())
+            channel.second->thread.join();
+}
+
+// Waits until all frames are processed and ends the packet extractors
+void ParallelPacketExtractor::End()
+{
+    if (m_ended)
+        return;
+    m_ended = true;
+    stop();
+
+    // Threads are finished, extractors can be used from this thread
+    for (auto& channel : m_channels)
+    {
+        if (channel.second->exception)
+            rethrow_exception(channel.second->exception);
+        channel.second->extractor.End();
+    }
+}
@@ -7,6 +7,20 @@
 #include <memory>
 #include <stdint.h>   // For explicit size integers (e.g. uint8_t, uint16_t)
 #include <stdexcept>  // For standard base exceptions such as runtime_exception
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <boost/iostreams/device/mapped_file.hpp>
 
@@ -16,6 +30,9 @@
 #include "CcsdsFrameReader.hxx"
 #include "PacketExtractor.hxx"
 #include "NctrsFileReader.hxx"
+#include "ParallelPacketExtractor.hxx"
+#include "NctrsStreamReader.hxx"
+#include "PacketIndex.hxx"
 
 using namespace std;
 using namespace boost::unit_test;
@@ -64,6 +81,52 @@ BOOST_AUTO_TEST_CASE ( testCrc )
     BOOST_CHECK( CcsdsPacketCrcCompute(data4, sizeof(data4)) == result4 );
 }
 
+// Reference byte per byte CRC computation of ECSS-E-70-41A Annex A.1
+static uint16_t referenceCrc(const uint8_t* buffer, size_t length)
+{
+    uint16_t syndrome = 0xFFFF;
+    for (size_t i = 0; i < length; i++)
+    {
+        syndrome ^= buffer[i] << 8;
+        for (int bit = 0; bit < 8; bit++)
+            syndrome = (syndrome & 0x8000) ? (syndrome << 1) ^ 0x1021 : (syndrome << 1);
+    }
+    return syndrome;
+}
+
+// Test slicing-by-8 CRC computation against the reference for all tail lengths
+BOOST_AUTO_TEST_CASE ( testCrcSlicing )
+{
+    vector<uint8_t> data(1024);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 131 + 7);
+
+    for (size_t length = 0; length < 100; length++)
+        BOOST_CHECK( CcsdsPacketCrcCompute(&data[3], length) == referenceCrc(&data[3], length) );
+    BOOST_CHECK( CcsdsPacketCrcCompute(&data[0], data.size()) == referenceCrc(&data[0], data.size()) );
+}
+
+// Measure throughput of the CRC computation
+BOOST_AUTO_TEST_CASE ( testCrcThroughput )
+{
+    const size_t packetLength = 1024;
+    const size_t packetCount = 16 * 1024;
+    vector<uint8_t> data(packetLength * packetCount);
+    for (size_t i = 0; i < data.size(); i++)
+        data[i] = (uint8_t)(i * 131 + 7);
+
+    auto start = std::chrono::steady_clock::now();
+    uint16_t check = 0;
+    for (size_t i = 0; i < packetCount; i++)
+        check ^= CcsdsPacketCrcCompute(&data[i * packetLength], packetLength);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    // All packets are identical and their number is even
+    BOOST_CHECK( check == 0 );
+
+    cout << "CRC throughput: " << data.size() / elapsed.count() / 1e9 << " GB/s" << endl;
+}
+
 // Test CcsdsFieldReader exceptions
 BOOST_AUTO_TEST_CASE ( testFieldReaderExceptions )
 {
@@ -417,6 +480,41 @@ BOOST_AUTO_TEST_CASE ( testNctrsFileReaderIterator )
 }
 
 
+// Test memory mapping of a NCTRS file
+BOOST_AUTO_TEST_CASE ( testNctrsMappedFile )
+{
+    MappedFile mappedFile(testNctrsFilePath);
+    NctrsMappedFile nctrsFile(testNctrsFilePath);
+
+    // Same content as the file
+    BOOST_REQUIRE( nctrsFile.GetLength() == mappedFile.size() );
+    BOOST_CHECK( memcmp(nctrsFile.GetData(), mappedFile.buffer(), mappedFile.size()) == 0 );
+
+    // Iterate the 4 frames of the sample
+    int frameCount = 0;
+    for (const auto& nctrsTmDu : nctrsFile.GetReader())
+    {
+        BOOST_CHECK( nctrsTmDu.VirtualChannelId == VirtualChannelHousekeeping );
+        frameCount++;
+    }
+    BOOST_CHECK( frameCount == 4 );
+
+    // Empty file has no data unit
+    const string emptyFileName = "empty_nctrs.bin";
+    ofstream(emptyFileName.c_str()).close();
+    {
+        NctrsMappedFile emptyFile(emptyFileName);
+        BOOST_CHECK( emptyFile.GetLength() == 0 );
+        NctrsFileReader reader = emptyFile.GetReader();
+        BOOST_CHECK( reader.begin() == reader.end() );
+    }
+    remove(emptyFileName.c_str());
+
+    // Missing file
+    BOOST_CHECK_EXCEPTION(NctrsMappedFile("resources/missing.bin"), std::runtime_error, P_EX_MESS("Cannot open NCTRS file"));
+}
+
+
 // ***************************** PacketExtractor *******************************
 BOOST_AUTO_TEST_CASE ( testPacketExtractorWrongVc )
 {
@@ -678,4 +776,613 @@ BOOST_FIXTURE_TEST_CASE ( testPacketExtractorMissingPacketEndSmall, PacketExtrac
     BOOST_CHECK ( packetExtractor.GetPacketExtractedCount() == packetsCount );
 
     cout << "------" << endl;
-}
\ No newline at end of file
+}
+
+// Counts the memory allocations of the current thread while an instance exists,
+// used to verify that packet extraction does not allocate memory per packet.
+// Outside of its scope the operator new below behaves as the default one.
+struct AllocationCounter
+{
+    static thread_local size_t* s_count;
+
+    size_t count = 0;
+
+    AllocationCounter() { s_count = &count; }
+    ~AllocationCounter() { s_count = nullptr; }
+};
+
+thread_local size_t* AllocationCounter::s_count = nullptr;
+
+void* operator new(size_t size)
+{
+    if (AllocationCounter::s_count != nullptr)
+        (*AllocationCounter::s_count)++;
+    void* pointer = malloc(size == 0 ? 1 : size);
+    if (pointer == nullptr)
+        throw std::bad_alloc();
+    return pointer;
+}
+
+// Not inlined, otherwise g++ reports the free() of memory from operator new
+__attribute__((noinline)) void operator delete(void* pointer) noexcept
+{
+    free(pointer);
+}
+
+__attribute__((noinline)) void operator delete(void* pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+// Builds a stream of VC1 frames containing valid packets of various lengths,
+// most of them split across two or more frames.
+struct FrameStream
+{
+    static const uint16_t FrameLength = 1115;
+    static const uint16_t DataLength = FrameLength - CcsdsFrameReader::PrimaryHeaderLength - CcsdsFrameReader::SecondaryHeaderLength;
+
+    vector<uint8_t> frames;
+    size_t frameCount = 0;
+    size_t packetCount = 0;
+
+    FrameStream(size_t packets, uint8_t virtualChannel = VirtualChannelHousekeeping)
+    {
+        // Packet zone of all frames, one packet after the other
+        vector<uint8_t> stream;
+        vector<size_t> packetStarts;
+        for (packetCount = 0; packetCount < packets; packetCount++)
+        {
+            size_t length = 20 + (packetCount * 397) % 3000;
+            packetStarts.push_back(stream.size());
+            size_t start = stream.size();
+            stream.resize(start + length);
+            uint8_t* packet = &stream[start];
+            for (size_t i = 0; i < length; i++)
+                packet[i] = (uint8_t)(i + packetCount);
+            packet[0] = 0x08 | 0x03;                   // TM, data field header, APID MSB
+            packet[2] = 0xC0 | ((packetCount >> 8) & 0x3F);
+            packet[3] = (uint8_t)packetCount;
+            packet[4] = (uint8_t)((length - 7) >> 8);
+            packet[5] = (uint8_t)(length - 7);
+            uint16_t crc = CcsdsPacketCrcCompute(packet, length - 2);
+            packet[length - 2] = (uint8_t)(crc >> 8);
+            packet[length - 1] = (uint8_t)crc;
+        }
+
+        // Cut the packet zone into frames, computing the First Header Pointer of each
+        frameCount = (stream.size() + DataLength - 1) / DataLength;
+        stream.resize(frameCount * DataLength, 0);
+        frames.resize(frameCount * FrameLength, 0);
+        size_t nextStart = 0;
+        for (size_t f = 0; f < frameCount; f++)
+        {
+            size_t dataStart = f * DataLength;
+            while (nextStart < packetStarts.size() && packetStarts[nextStart] < dataStart)
+                nextStart++;
+            uint16_t fhp = CcsdsFrameReader::FhpNoPacketStart;
+            if (nextStart < packetStarts.size() && packetStarts[nextStart] < dataStart + DataLength)
+                fhp = (uint16_t)(packetStarts[nextStart] - dataStart);
+
+            uint8_t* frame = &frames[f * FrameLength];
+            frame[0] = 0x00;
+            frame[1] = (uint8_t)(virtualChannel << 1);  // VCID, no Operational Control Field
+            frame[2] = frame[3] = (uint8_t)f;
+            frame[4] = 0x98 | (uint8_t)(fhp >> 8);
+            frame[5] = (uint8_t)fhp;
+            memcpy(frame + CcsdsFrameReader::PrimaryHeaderLength + CcsdsFrameReader::SecondaryHeaderLength,
+                   &stream[dataStart], DataLength);
+        }
+    }
+
+    CcsdsFrameReader Frame(size_t index) const
+    {
+        return CcsdsFrameReader(&frames[index * FrameLength], FrameLength);
+    }
+};
+
+// Test extraction of a long stream of packets, measure throughput and allocations
+BOOST_AUTO_TEST_CASE ( testPacketExtractorThroughput )
+{
+    FrameStream stream(20000);
+
+    size_t validCount = 0;
+    size_t reconstructedCount = 0;
+    PacketExtractor packetExtractor(VirtualChannelHousekeeping, [&](CcsdsPacketReader packetReader, bool reconstructed)
+    {
+        packetReader.ValidatePacket();
+        validCount++;
+        if (reconstructed)
+            reconstructedCount++;
+    });
+
+    size_t allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    {
+        AllocationCounter allocationCounter;
+        for (size_t f = 0; f < stream.frameCount; f++)
+            packetExtractor.Add(stream.Frame(f));
+        allocations = allocationCounter.count;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    packetExtractor.End();
+
+    BOOST_CHECK( validCount == stream.packetCount );
+    BOOST_CHECK( packetExtractor.GetPacketExtractedCount() == stream.packetCount );
+    BOOST_CHECK( packetExtractor.GetReconstructedPacketCount() == reconstructedCount );
+    BOOST_CHECK( reconstructedCount > 0 );
+    BOOST_CHECK( packetExtractor.GetLostPacketCount() == 0 );
+    BOOST_CHECK( packetExtractor.GetMissingFrameCount() == 0 );
+    BOOST_CHECK( packetExtractor.GetProtocolViolationCount() == 0 );
+    BOOST_CHECK( packetExtractor.GetFrameCount() == stream.frameCount );
+    // No memory allocation per packet, the reconstruction buffer is allocated in constructor
+    BOOST_CHECK( allocations == 0 );
+
+    cout << "Packet extraction: " << stream.packetCount / elapsed.count() << " packets/s, "
+         << (double)allocations / stream.packetCount << " allocations/packet" << endl;
+}
+
+// Test extraction of several Virtual Channels in parallel
+BOOST_AUTO_TEST_CASE ( testParallelPacketExtractor )
+{
+    const uint8_t channels[] = { VirtualChannelHousekeeping, VirtualChannelScience, VirtualChannelEvents };
+    vector<unique_ptr<FrameStream>> streams;
+    for (uint8_t vc : channels)
+        streams.emplace_back(new FrameStream(5000, vc));
+
+    // Each callback counts the packets arriving out of order, by their sequence count.
+    // Boost.Test assertions are not thread-safe, they are made after End().
+    map<uint8_t, size_t> packetCounts;
+    map<uint8_t, size_t> outOfOrderCounts;
+    map<uint8_t, PacketCallback> callbacks;
+    for (uint8_t vc : channels)
+    {
+        size_t& count = packetCounts[vc];
+        size_t& outOfOrder = outOfOrderCounts[vc];
+        callbacks[vc] = [&count, &outOfOrder](CcsdsPacketReader packetReader, bool)
+        {
+            packetReader.ValidatePacket();
+            if (packetReader.GetSequenceCount() != (count & 0x3FFF))
+                outOfOrder++;
+            count++;
+        };
+    }
+
+    ParallelPacketExtractor extractor(callbacks, 64);
+
+    // Interleave the frames of the channels, plus frames of a channel without extractor
+    FrameStream other(10, 2);
+    auto start = std::chrono::steady_clock::now();
+    for (size_t f = 0; f < streams[0]->frameCount; f++)
+    {
+        for (auto& stream : streams)
+            if (f < stream->frameCount)
+                extractor.Add(stream->Frame(f));
+        if (f < other.frameCount)
+            BOOST_CHECK( !extractor.Add(other.Frame(f)) );
+    }
+    extractor.End();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    size_t total = 0;
+    for (size_t i = 0; i < streams.size(); i++)
+    {
+        BOOST_CHECK( packetCounts[channels[i]] == streams[i]->packetCount );
+        BOOST_CHECK( outOfOrderCounts[channels[i]] == 0 );
+        BOOST_CHECK( extractor.GetExtractor(channels[i]).GetPacketExtractedCount() == streams[i]->packetCount );
+        BOOST_CHECK( extractor.GetExtractor(channels[i]).GetLostPacketCount() == 0 );
+        total += packetCounts[channels[i]];
+    }
+    BOOST_CHECK( extractor.GetIgnoredFrameCount() == other.frameCount );
+    BOOST_CHECK_THROW( extractor.GetExtractor(2), std::out_of_range );
+
+    cout << "Parallel packet extraction: " << total / elapsed.count() << " packets/s" << endl;
+}
+
+// Test that an exception in a callback is reported by End()
+BOOST_AUTO_TEST_CASE ( testParallelPacketExtractorException )
+{
+    FrameStream stream(100, VirtualChannelScience);
+    map<uint8_t, PacketCallback> callbacks;
+    callbacks[VirtualChannelScience] = [](CcsdsPacketReader, bool)
+    {
+        throw std::runtime_error("callback failure");
+    };
+
+    ParallelPacketExtractor extractor(callbacks, 4);
+    for (size_t f = 0; f < stream.frameCount; f++)
+        extractor.Add(stream.Frame(f));
+    BOOST_CHECK_EXCEPTION( extractor.End(), std::runtime_error, P_EX_MESS("callback failure") );
+}
+
+// Test that a frame added to the wrong Virtual Channel is rejected at once
+BOOST_AUTO_TEST_CASE ( testParallelPacketExtractorWrongChannel )
+{
+    FrameStream stream(10, VirtualChannelScience);
+    map<uint8_t, PacketCallback> callbacks;
+    callbacks[VirtualChannelHousekeeping] = [](CcsdsPacketReader, bool) {};
+
+    ParallelPacketExtractor extractor(callbacks);
+    BOOST_CHECK_THROW( extractor.Add(VirtualChannelHousekeeping, stream.Frame(0)), std::runtime_error );
+    extractor.End();
+    BOOST_CHECK( extractor.GetExtractor(VirtualChannelHousekeeping).GetFrameCount() == 0 );
+}
+
+// Test extraction of the NCTRS sample file through a memory mapping, dispatched by NCTRS Virtual Channel ID
+BOOST_AUTO_TEST_CASE ( testParallelPacketExtractorNctrs )
+{
+    NctrsMappedFile nctrsFile(testNctrsFilePath);
+
+    map<uint8_t, PacketCallback> callbacks;
+    callbacks[VirtualChannelHousekeeping] = [](CcsdsPacketReader packetReader, bool) { packetReader.ValidatePacket(); };
+    callbacks[VirtualChannelScience] = [](CcsdsPacketReader packetReader, bool) { packetReader.ValidatePacket(); };
+    ParallelPacketExtractor extractor(callbacks);
+
+    for (const auto& nctrsTmDu : nctrsFile.GetReader())
+    {
+        // Sample file contains ASM and Reed-Solomon symbols, skip them
+        auto length = nctrsTmDu.PacketSize - NctrsFileReader::NctrsHeaderLength - 4 - 160;
+        extractor.Add(nctrsTmDu.VirtualChannelId, CcsdsFrameReader(nctrsTmDu.UserData + 4, (uint16_t)length));
+    }
+    extractor.End();
+
+    // Same result as the serial extraction of testNctrsReading
+    BOOST_CHECK( extractor.GetExtractor(VirtualChannelHousekeeping).GetMissingFrameCount() == 0 );
+    BOOST_CHECK( extractor.GetExtractor(VirtualChannelHousekeeping).GetLostPacketCount() == 1 );
+    BOOST_CHECK( extractor.GetExtractor(VirtualChannelScience).GetPacketExtractedCount() == 0 );
+}
+
+// Wraps the frames of a frame stream into NCTRS Telemetry Data Units
+static vector<uint8_t> makeNctrsStream(const FrameStream& stream)
+{
+    const uint32_t dataUnitLength = NctrsFileReader::NctrsHeaderLength + FrameStream::FrameLength;
+    vector<uint8_t> nctrs(stream.frameCount * dataUnitLength, 0);
+    for (size_t f = 0; f < stream.frameCount; f++)
+    {
+        uint8_t* dataUnit = &nctrs[f * dataUnitLength];
+        dataUnit[0] = (uint8_t)(dataUnitLength >> 24);
+        dataUnit[1] = (uint8_t)(dataUnitLength >> 16);
+        dataUnit[2] = (uint8_t)(dataUnitLength >> 8);
+        dataUnit[3] = (uint8_t)dataUnitLength;
+        dataUnit[7] = stream.Frame(f).GetVcId();
+        memcpy(dataUnit + NctrsFileReader::NctrsHeaderLength, stream.Frame(f).GetBuffer(), FrameStream::FrameLength);
+    }
+    return nctrs;
+}
+
+// Writes the NCTRS stream to a file descriptor by chunks, with a
+// pause between chunks to replay it at line rate, then closes it
+static void replayNctrsStream(int fd, const vector<uint8_t>& nctrs, size_t chunkLength, int pauseUs)
+{
+    for (size_t offset = 0; offset < nctrs.size(); offset += chunkLength)
+    {
+        size_t length = std::min(chunkLength, nctrs.size() - offset);
+        size_t written = 0;
+        while (written < length)
+        {
+            ssize_t count = write(fd, &nctrs[offset + written], length - written);
+            if (count <= 0)
+                _exit(1);
+            written += count;
+        }
+        if (pauseUs > 0)
+            usleep(pauseUs);
+    }
+    close(fd);
+}
+
+// Reads the NCTRS data units of a file descriptor and extracts their packets
+static void extractNctrsStream(int fd, const FrameStream& stream, size_t maxDataUnits)
+{
+    size_t packetCount = 0;
+    PacketExtractor packetExtractor(VirtualChannelHousekeeping, [&](CcsdsPacketReader packetReader, bool)
+    {
+        packetReader.ValidatePacket();
+        packetCount++;
+    });
+
+    NctrsStreamReader reader(fd, maxDataUnits);
+    NctrsTmDu tmDu;
+    while (reader.Next(tmDu))
+        packetExtractor.Add(CcsdsFrameReader(tmDu.UserData, (uint16_t)(tmDu.PacketSize - NctrsFileReader::NctrsHeaderLength)));
+    packetExtractor.End();
+
+    BOOST_CHECK( reader.GetDataUnitCount() == stream.frameCount );
+    BOOST_CHECK( reader.GetBufferLength() == maxDataUnits * NctrsStreamReader::DefaultMaxDataUnitLength );
+    BOOST_CHECK( packetCount == stream.packetCount );
+    BOOST_CHECK( packetExtractor.GetLostPacketCount() == 0 );
+    BOOST_CHECK( packetExtractor.GetMissingFrameCount() == 0 );
+}
+
+// Test streaming of NCTRS data units from a pipe, written by another process at line rate
+BOOST_AUTO_TEST_CASE ( testNctrsStreamReaderPipe )
+{
+    FrameStream stream(1000);
+    vector<uint8_t> nctrs = makeNctrsStream(stream);
+
+    int fds[2];
+    BOOST_REQUIRE( pipe(fds) == 0 );
+    pid_t pid = fork();
+    BOOST_REQUIRE( pid >= 0 );
+    if (pid == 0)
+    {
+        close(fds[0]);
+        replayNctrsStream(fds[1], nctrs, NctrsFileReader::NctrsHeaderLength + FrameStream::FrameLength, 20);
+        _exit(0);
+    }
+    close(fds[1]);
+
+    auto start = std::chrono::steady_clock::now();
+    extractNctrsStream(fds[0], stream, 2);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    close(fds[0]);
+
+    int status;
+    waitpid(pid, &status, 0);
+    BOOST_CHECK( WIFEXITED(status) && WEXITSTATUS(status) == 0 );
+
+    cout << "NCTRS pipe streaming: " << nctrs.size() * 8 / elapsed.count() / 1e6 << " Mbit/s" << endl;
+}
+
+// Test streaming of NCTRS data units from a local TCP socket, stand-in for the ground station feed
+BOOST_AUTO_TEST_CASE ( testNctrsStreamReaderSocket )
+{
+    FrameStream stream(1000);
+    vector<uint8_t> nctrs = makeNctrsStream(stream);
+
+    // Listen on any free port of the loopback interface
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    BOOST_REQUIRE( server >= 0 );
+    sockaddr_in address;
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    socklen_t addressLength = sizeof(address);
+    BOOST_REQUIRE( ::bind(server, (sockaddr*)&address, sizeof(address)) == 0 );
+    BOOST_REQUIRE( listen(server, 1) == 0 );
+    BOOST_REQUIRE( getsockname(server, (sockaddr*)&address, &addressLength) == 0 );
+
+    pid_t pid = fork();
+    BOOST_REQUIRE( pid >= 0 );
+    if (pid == 0)
+    {
+        close(server);
+        int client = socket(AF_INET, SOCK_STREAM, 0);
+        if (client < 0 || connect(client, (sockaddr*)&address, sizeof(address)) != 0)
+            _exit(1);
+        replayNctrsStream(client, nctrs, 4096, 0);
+        _exit(0);
+    }
+
+    int connection = accept(server, nullptr, nullptr);
+    BOOST_REQUIRE( connection >= 0 );
+    extractNctrsStream(connection, stream, 4);
+    close(connection);
+    close(server);
+
+    int status;
+    waitpid(pid, &status, 0);
+    BOOST_CHECK( WIFEXITED(status) && WEXITSTATUS(status) == 0 );
+}
+
+// Test streaming of NCTRS data units from a file that is still being written
+BOOST_AUTO_TEST_CASE ( testNctrsStreamReaderGrowingFile )
+{
+    FrameStream stream(200);
+    vector<uint8_t> nctrs = makeNctrsStream(stream);
+    const string fileName = "growing_nctrs.bin";
+
+    // First half of the file, cut in the middle of a data unit
+    size_t half = nctrs.size() / 2 + 7;
+    {
+        ofstream file(fileName.c_str(), ios::binary);
+        file.write((const char*)&nctrs[0], half);
+    }
+
+    // Rest of the file appended later, while reading
+    std::thread writer([&]
+    {
+        usleep(50000);
+        ofstream file(fileName.c_str(), ios::binary | ios::app);
+        file.write((const char*)&nctrs[half], nctrs.size() - half);
+    });
+
+    FILE* file = fopen(fileName.c_str(), "rb");
+    BOOST_REQUIRE( file != nullptr );
+    NctrsStreamReader reader(fileno(file), 8);
+    reader.Follow(500);
+    NctrsTmDu tmDu;
+    while (reader.Next(tmDu))
+        ;
+    writer.join();
+    fclose(file);
+    remove(fileName.c_str());
+
+    BOOST_CHECK( reader.GetDataUnitCount() == stream.frameCount );
+    BOOST_CHECK( reader.GetByteCount() == nctrs.size() );
+}
+
+// Test errors of NctrsStreamReader
+BOOST_AUTO_TEST_CASE ( testNctrsStreamReaderErrors )
+{
+    BOOST_CHECK_THROW( NctrsStreamReader(-1), std::invalid_argument );
+
+    // Stream ending in the middle of a data unit
+    FrameStream stream(10);
+    vector<uint8_t> nctrs = makeNctrsStream(stream);
+    int fds[2];
+    BOOST_REQUIRE( pipe(fds) == 0 );
+    BOOST_REQUIRE( write(fds[1], &nctrs[0], 100) == 100 );
+    close(fds[1]);
+    NctrsStreamReader reader(fds[0], 1);
+    NctrsTmDu tmDu;
+    BOOST_CHECK_EXCEPTION( reader.Next(tmDu), std::runtime_error, P_EX_MESS("ends in the middle") );
+    close(fds[0]);
+
+    // Data unit longer than the maximum
+    BOOST_REQUIRE( pipe(fds) == 0 );
+    BOOST_REQUIRE( write(fds[1], &nctrs[0], 100) == 100 );
+    close(fds[1]);
+    NctrsStreamReader smallReader(fds[0], 1, 1000);
+    BOOST_CHECK_EXCEPTION( smallReader.Next(tmDu), std::runtime_error, P_EX_MESS("Invalid NCTRS data unit length") );
+    close(fds[0]);
+}
+
+// Test the packet index of a NCTRS file with two interleaved Virtual Channels
+BOOST_AUTO_TEST_CASE ( testPacketIndex )
+{
+    FrameStream housekeeping(3000, VirtualChannelHousekeeping);
+    FrameStream science(1000, VirtualChannelScience);
+    vector<uint8_t> housekeepingNctrs = makeNctrsStream(housekeeping);
+    vector<uint8_t> scienceNctrs = makeNctrsStream(science);
+
+    // One science data unit after every three housekeeping data units
+    const size_t dataUnitLength = NctrsFileReader::NctrsHeaderLength + FrameStream::FrameLength;
+    const string nctrsFileName = "indexed_nctrs.bin";
+    const string indexFileName = "indexed_nctrs.idx";
+    {
+        ofstream file(nctrsFileName.c_str(), ios::binary);
+        size_t h = 0, s = 0;
+        while (h < housekeeping.frameCount || s < science.frameCount)
+        {
+            for (int i = 0; i < 3 && h < housekeeping.frameCount; i++, h++)
+                file.write((const char*)&housekeepingNctrs[h * dataUnitLength], dataUnitLength);
+            if (s < science.frameCount)
+                file.write((const char*)&scienceNctrs[s++ * dataUnitLength], dataUnitLength);
+        }
+    }
+
+    // Reference: all packets extracted by a full decoding, by VC and sequence count
+    NctrsMappedFile nctrsFile(nctrsFileName);
+    map<pair<uint8_t, uint16_t>, vector<uint8_t>> packets;
+    {
+        map<uint8_t, unique_ptr<PacketExtractor>> extractors;
+        for (uint8_t vc : { VirtualChannelHousekeeping, VirtualChannelScience })
+            extractors[vc].reset(new PacketExtractor(vc, [&packets, vc](CcsdsPacketReader packetReader, bool)
+            {
+                packets[make_pair(vc, packetReader.GetSequenceCount())].assign(
+                    packetReader.GetBuffer(), packetReader.GetBuffer() + packetReader.GetPacketLength());
+            }));
+        for (const auto& tmDu : nctrsFile.GetReader())
+            extractors[tmDu.VirtualChannelId]->Add(NctrsUserDataFrame(tmDu));
+    }
+    BOOST_REQUIRE( packets.size() == housekeeping.packetCount + science.packetCount );
+
+    auto start = std::chrono::steady_clock::now();
+    PacketIndexer indexer(nctrsFile.GetData(), nctrsFile.GetLength());
+    indexer.Run();
+    indexer.Write(indexFileName);
+    std::chrono::duration<double> indexing = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK( indexer.GetEntries().size() == packets.size() );
+
+    PacketIndex index(indexFileName);
+    BOOST_REQUIRE( index.GetCount() == packets.size() );
+
+    // Every indexed packet, split across frames or not, reads back identical to the decoded one
+    size_t reconstructedCount = 0;
+    vector<uint8_t> packet;
+    for (const auto& entry : indexer.GetEntries())
+    {
+        PacketIndex::ReadPacket(nctrsFile.GetData(), nctrsFile.GetLength(), entry, packet);
+        BOOST_REQUIRE( packet == packets[make_pair(entry.VirtualChannel, entry.SequenceCount)] );
+        reconstructedCount += entry.Reconstructed;
+    }
+    BOOST_CHECK( reconstructedCount > 0 );
+
+    // Query by APID and time window, compared with a linear scan of the entries
+    const PacketIndexEntry& sample = indexer.GetEntries()[1234];
+    uint64_t timeStart = sample.Time - 1000000;
+    uint64_t timeStop = sample.Time + 1000000;
+    size_t expectedApid = 0, expectedAll = 0;
+    for (const auto& entry : indexer.GetEntries())
+        if (entry.Time >= timeStart && entry.Time < timeStop)
+        {
+            expectedAll++;
+            if (entry.Apid == sample.Apid)
+                expectedApid++;
+        }
+
+    start = std::chrono::steady_clock::now();
+    vector<PacketIndexEntry> found = index.Find(sample.Apid, timeStart, timeStop);
+    std::chrono::duration<double> query = std::chrono::steady_clock::now() - start;
+    BOOST_CHECK( found.size() == expectedApid );
+    BOOST_CHECK( !found.empty() );
+    for (size_t i = 0; i < found.size(); i++)
+    {
+        BOOST_CHECK( found[i].Apid == sample.Apid );
+        BOOST_CHECK( i == 0 || found[i - 1].Time <= found[i].Time );
+    }
+    BOOST_CHECK( index.Find(timeStart, timeStop).size() == expectedAll );
+    BOOST_CHECK( index.Find(sample.Apid, timeStop, timeStart).empty() );
+
+    cout << "Packet indexing: " << nctrsFile.GetLength() / indexing.count() / 1e6 << " MB/s, query: "
+         << query.count() * 1e6 << " us" << endl;
+
+    remove(nctrsFileName.c_str());
+    remove(indexFileName.c_str());
+}
+
+// Test errors of the packet index
+BOOST_AUTO_TEST_CASE ( testPacketIndexErrors )
+{
+    BOOST_CHECK_EXCEPTION( PacketIndex index("missing.idx"), std::runtime_error, P_EX_MESS("Cannot open") );
+    BOOST_CHECK_EXCEPTION( PacketIndex index(testNctrsFilePath), std::runtime_error, P_EX_MESS("is not a packet index file") );
+
+    // Entry of a reconstructed packet pointing to a location without packet
+    FrameStream stream(10);
+    vector<uint8_t> nctrs = makeNctrsStream(stream);
+    PacketIndexEntry entry;
+    memset(&entry, 0, sizeof(entry));
+    entry.VirtualChannel = VirtualChannelHousekeeping;
+    entry.Reconstructed = 1;
+    entry.PacketOffset = 100;
+    vector<uint8_t> packet;
+    BOOST_CHECK_EXCEPTION( PacketIndex::ReadPacket(&nctrs[0], nctrs.size(), entry, packet),
+                           std::runtime_error, P_EX_MESS("cannot be reconstructed") );
+
+    // Offsets outside of the file or of the data unit
+    entry.PacketOffset = 10;
+    BOOST_CHECK_EXCEPTION( PacketIndex::ReadPacket(&nctrs[0], nctrs.size(), entry, packet),
+                           std::runtime_error, P_EX_MESS("outside of its data unit") );
+    entry.DataUnitOffset = nctrs.size() + 100;
+    entry.PacketOffset = entry.DataUnitOffset + 100;
+    BOOST_CHECK_EXCEPTION( PacketIndex::ReadPacket(&nctrs[0], nctrs.size(), entry, packet),
+                           std::runtime_error, P_EX_MESS("data unit of the indexed packet is outside") );
+    entry.Reconstructed = 0;
+    entry.PacketOffset = 100;
+    entry.PacketLength = UINT32_MAX;
+    BOOST_CHECK_EXCEPTION( PacketIndex::ReadPacket(&nctrs[0], nctrs.size(), entry, packet),
+                           std::runtime_error, P_EX_MESS("outside of the NCTRS file") );
+    entry.PacketOffset = UINT64_MAX - 10;
+    entry.PacketLength = 20;
+    BOOST_CHECK_EXCEPTION( PacketIndex::ReadPacket(&nctrs[0], nctrs.size(), entry, packet),
+                           std::runtime_error, P_EX_MESS("outside of the NCTRS file") );
+
+    // Number of records for which the expected file length overflows to 16 bytes
+    const string indexFileName = "corrupted.idx";
+    {
+        uint64_t count = (uint64_t)1 << 61;
+        ofstream file(indexFileName.c_str(), ios::binary);
+        file.write(PacketIndex::Magic, sizeof(PacketIndex::Magic));
+        file.write((const char*)&count, sizeof(count));
+    }
+    BOOST_CHECK_EXCEPTION( PacketIndex index(indexFileName), std::runtime_error, P_EX_MESS("truncated or corrupted") );
+    remove(indexFileName.c_str());
+}
+
+// Test that the start of a lost packet is not reported as being reconstructed
+BOOST_AUTO_TEST_CASE ( testReconstructedPacketStartLost )
+{
+    FrameStream stream(100);
+    PacketExtractor packetExtractor(VirtualChannelHousekeeping, [](CcsdsPacketReader, bool) {});
+
+    // Find a frame after which a packet is being reconstructed, then skip the next frame
+    size_t f = 0;
+    while (f < stream.frameCount && packetExtractor.GetReconstructedPacketStart() == nullptr)
+        packetExtractor.Add(stream.Frame(f++));
+    BOOST_REQUIRE( f + 1 < stream.frameCount );
+    packetExtractor.Add(stream.Frame(f + 1));
+    BOOST_CHECK( packetExtractor.GetLostPacketCount() == 1 );
+    BOOST_CHECK( packetExtractor.GetReconstructedPacketStart() == nullptr ||
+                 packetExtractor.GetReconstructedPacketStart() >= stream.Frame(f + 1).GetBuffer() );
+}
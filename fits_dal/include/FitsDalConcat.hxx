@@ -0,0 +1,55 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup FitsDal
+ *  @brief Declaration of the function ConcatenateTables() to merge the FITS
+ *         tables of several files into one table
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-037 first released version
+ *
+ */
+
+#ifndef _FITS_DAL_CONCAT_HXX_
+#define _FITS_DAL_CONCAT_HXX_
+
+#include <string>
+#include <vector>
+
+#include "FitsDalTable.hxx"
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Appends the rows of the tables of @b inputFiles to @b outputTable,
+ *         sorted by @b sortColumn.
+ *
+ *  The input tables are opened in READONLY mode and their rows are copied
+ *  with FitsDalTable::ConcatenateRows(), see there for the details. The
+ *  @b outputTable is typically an object of a fits_data_model class, opened
+ *  in CREATE or APPEND mode, for example to merge the per-pass HK tables of
+ *  a visit:
+ *
+ *  @code
+ *  SciRawHkextended visitHk("visit_hk.fits", "CREATE");
+ *  ConcatenateTables(visitHk, passHkFiles);
+ *  @endcode
+ *
+ *  @param [in] outputTable  the table to which the rows are appended
+ *  @param [in] inputFiles   names of the FITS files, with the extension of
+ *                           the table if it is not the first extension, for
+ *                           example pass1.fits[SCI_RAW_HkExtended]
+ *  @param [in] sortColumn   a scalar numerical column, or an empty string to
+ *                           copy the tables in the order of @b inputFiles.
+ *
+ *  @return the number of appended rows, without the skipped duplicate rows.
+ *
+ *  @throw std::runtime_error if an input table cannot be opened, if it has
+ *         other columns than @b outputTable or on a cfitsio error.
+ */
+uint64_t ConcatenateTables(FitsDalTable & outputTable,
+                           const std::vector<std::string> & inputFiles,
+                           const std::string & sortColumn = "OBT_TIME");
+
+#endif /* _FITS_DAL_CONCAT_HXX_ */
@@ -0,0 +1,159 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup FitsDal
+ *  @brief Inline conversions of FITS table cells, used by the row layouts
+ *         of the fits_data_model classes.
+ *
+ *  The functions have the same result as the corresponding functions of the
+ *  RdCopy and WrCopy arrays for columns of which the FITS data type is the
+ *  data type of the variable. They are selected at compile time by the data
+ *  type of the column, so that the compiler can inline them.
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-035 first released version
+ *
+ */
+
+#ifndef _FITS_DAL_ROW_LAYOUT_HXX_
+#define _FITS_DAL_ROW_LAYOUT_HXX_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "FitsDalTable.hxx"
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Unsigned integer of @b SIZE bytes, used to swap the bytes of a value.
+ */
+template <int SIZE> struct FitsBits;
+template <> struct FitsBits<1> { typedef uint8_t  type;  static uint8_t  Swap(uint8_t  v) {return v;} };
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+template <> struct FitsBits<2> { typedef uint16_t type;  static uint16_t Swap(uint16_t v) {return v;} };
+template <> struct FitsBits<4> { typedef uint32_t type;  static uint32_t Swap(uint32_t v) {return v;} };
+template <> struct FitsBits<8> { typedef uint64_t type;  static uint64_t Swap(uint64_t v) {return v;} };
+#else
+template <> struct FitsBits<2> { typedef uint16_t type;  static uint16_t Swap(uint16_t v) {return __builtin_bswap16(v);} };
+template <> struct FitsBits<4> { typedef uint32_t type;  static uint32_t Swap(uint32_t v) {return __builtin_bswap32(v);} };
+template <> struct FitsBits<8> { typedef uint64_t type;  static uint64_t Swap(uint64_t v) {return __builtin_bswap64(v);} };
+#endif
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Conversion of a numerical column of type @b T between the FITS
+ *         table row and a variable.
+ *
+ *  @tparam T         the data type of the column and of the variable
+ *  @tparam FLIP_SIGN true for the columns stored with a TZERO offset in the
+ *                    FITS file: signed bytes and unsigned integers of 2, 4
+ *                    and 8 bytes.
+ */
+template <typename T, bool FLIP_SIGN>
+struct FitsNumberCodec {
+
+   typedef T value_type;
+   typedef typename FitsBits<sizeof(T)>::type Bits;
+
+   /// The first bit is flipped to apply the TZERO offset.
+   static Bits Flip() {return FLIP_SIGN ? Bits(Bits(1) << (sizeof(T) * 8 - 1)) : Bits(0);}
+
+   /// Copies @b arraySize values of a FITS cell into @b dest.
+   static void Read(T * dest, const unsigned char * src, int arraySize) {
+      for (int numVal = 0; numVal < arraySize; numVal++) {
+         Bits bits;
+         memcpy(&bits, src + numVal * sizeof(T), sizeof(T));
+         bits = FitsBits<sizeof(T)>::Swap(bits) ^ Flip();
+         memcpy(dest + numVal, &bits, sizeof(T));
+      }
+   }
+
+   /// Copies @b arraySize values of @b src into a FITS cell.
+   static void Write(unsigned char * dest, const T * src, int arraySize) {
+      for (int numVal = 0; numVal < arraySize; numVal++) {
+         Bits bits;
+         memcpy(&bits, src + numVal, sizeof(T));
+         bits = FitsBits<sizeof(T)>::Swap(bits ^ Flip());
+         memcpy(dest + numVal * sizeof(T), &bits, sizeof(T));
+      }
+   }
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Conversion of a logical column. 0 or 'F' is false, everything else
+ *         is true.
+ */
+struct FitsBoolCodec {
+
+   typedef bool value_type;
+
+   static void Read(bool * dest, const unsigned char * src, int arraySize) {
+      for (int numVal = 0; numVal < arraySize; numVal++)
+         dest[numVal] = src[numVal] != 0 && src[numVal] != 'F';
+   }
+
+   static void Write(unsigned char * dest, const bool * src, int arraySize) {
+      for (int numVal = 0; numVal < arraySize; numVal++)
+         dest[numVal] = src[numVal] ? 'T' : 'F';
+   }
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Conversion of a string column. Blanks at the end of the string are
+ *         removed while reading and added while writing.
+ */
+struct FitsStringCodec {
+
+   typedef std::string value_type;
+
+   static void Read(std::string * dest, const unsigned char * src, int arraySize) {
+      const char * str = reinterpret_cast<const char *>(src);
+      int length = arraySize;
+      while (length > 1 && str[length - 1] == ' ')
+         length--;
+      const char * end = static_cast<const char *>(memchr(str, 0, length));
+      dest->assign(str, end ? end - str : length);
+   }
+
+   static void Write(unsigned char * dest, const std::string * src, int arraySize) {
+      int srcLength = src->length();
+      memcpy(dest, src->c_str(), arraySize < srcLength ? arraySize : srcLength);
+      if (srcLength < arraySize)
+         memset(dest + srcLength, ' ', arraySize - srcLength);
+      if (srcLength == 0)  // this is the NULL value of a string
+         dest[0] = 0;
+   }
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Selects the conversion of a column by its data type.
+ *
+ *  @code
+ *  FitsColCodec<col_double>::Read(m_cellValue, ioBuffer + 8, 2);
+ *  @endcode
+ */
+template <ColDataType TYPE> struct FitsColCodec;
+template <> struct FitsColCodec<col_bool>   : FitsBoolCodec {};
+template <> struct FitsColCodec<col_int8>   : FitsNumberCodec<int8_t,   true>  {};
+template <> struct FitsColCodec<col_uint8>  : FitsNumberCodec<uint8_t,  false> {};
+template <> struct FitsColCodec<col_int16>  : FitsNumberCodec<int16_t,  false> {};
+template <> struct FitsColCodec<col_uint16> : FitsNumberCodec<uint16_t, true>  {};
+template <> struct FitsColCodec<col_int32>  : FitsNumberCodec<int32_t,  false> {};
+template <> struct FitsColCodec<col_uint32> : FitsNumberCodec<uint32_t, true>  {};
+template <> struct FitsColCodec<col_int64>  : FitsNumberCodec<int64_t,  false> {};
+template <> struct FitsColCodec<col_uint64> : FitsNumberCodec<uint64_t, true>  {};
+template <> struct FitsColCodec<col_float>  : FitsNumberCodec<float,    false> {};
+template <> struct FitsColCodec<col_double> : FitsNumberCodec<double,   false> {};
+template <> struct FitsColCodec<col_string> : FitsStringCodec {};
+
+#endif /* _FITS_DAL_ROW_LAYOUT_HXX_ */
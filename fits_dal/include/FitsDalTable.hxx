@@ -7,6 +7,17 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-031 new methods GetNumRows(),
+ *                                ReadRows() and WriteRows() to transfer many
+ *                                rows at once, row layouts of derived classes:
+ *                                UseRowLayout(), DecodeRow() and EncodeRow()
+ *                                (user-035), CopyRows() to copy a whole table
+ *                                (user-036), ConcatenateRows() to merge tables
+ *                                (user-037), running statistics of columns
+ *                                while writing: EnableColumnStatistics() and
+ *                                GetColumnStatistics() (user-038),
+ *                                UpdateColumns() to update columns of
+ *                                existing rows in place (user-039)
  *  @version 9.3.1 2018-06-18 RRO #16505: new method: SetReadRow()
  *  @version 9.0.1 2018-01-31 RRO #15376: update of method IsUnsignedColumn()
  *  @version 9.0   2018-01-04 RRO #15057: new method: GetColUnit and update of
@@ -26,6 +37,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "FitsDalHeader.hxx"
 
@@ -153,6 +165,123 @@ struct FitsColMetaData {
                                  ///   1: normal column (no vector column)
 };
 
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Location of one column in a user buffer holding several rows.
+ *
+ *  Used by FitsDalTable::ReadRows() and FitsDalTable::WriteRows(). The values
+ *  of a row are stored in the buffer in the byte order of the machine, the
+ *  values of a vector column one after the other. String columns are stored
+ *  as fixed length character arrays of @b m_arraySize bytes, padded with 0.
+ */
+struct FitsColBuffer {
+
+   /** *************************************************************************
+    *  @brief The only constructor, initializing all member variables.
+    */
+   FitsColBuffer(const std::string & colName, ColDataType colDataType,
+                 int32_t arraySize, size_t offset)
+      : m_colName(colName), m_colDataType(colDataType),
+        m_arraySize(arraySize), m_offset(offset) { }
+
+   std::string    m_colName;     ///<  name of the column
+   ColDataType    m_colDataType; ///<  data type of the values in the buffer
+   int32_t        m_arraySize;   ///<  @brief number of bins of a vector column,
+                                 ///   or length of a string column
+   size_t         m_offset;      ///<  @brief offset in bytes of the column in
+                                 ///   one row of the buffer
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Statistics of the values written into one column, see
+ *         FitsDalTable::EnableColumnStatistics().
+ *
+ *  The statistics include the rows from the first to the last row written
+ *  after the statistics were enabled, each row only once. All bins of a vector column are included. The values are converted to
+ *  double, 64 bit integers with more than 53 significant bits are therefore
+ *  rounded. Only m_numValues and m_numNull are set for string columns.
+ */
+struct FitsColStatistics {
+
+   /** *************************************************************************
+    *  @brief The only constructor, initializing all member variables with 0.
+    */
+   FitsColStatistics()
+      : m_numValues(0), m_numNull(0), m_numNaN(0), m_min(0), m_max(0),
+        m_sum(0), m_first(0), m_last(0) { }
+
+   /** *************************************************************************
+    *  @brief Returns the mean of the values or NaN if no value was written.
+    */
+   double GetMean() const;
+
+   uint64_t  m_numValues;  ///< number of values, without NULL and NaN values
+   uint64_t  m_numNull;    ///< @brief number of NULL values (TNULL of integer
+                           ///  columns, empty strings)
+   uint64_t  m_numNaN;     ///< number of NaN values of float and double columns
+   double    m_min;        ///< minimum value
+   double    m_max;        ///< maximum value
+   double    m_sum;        ///< sum of all values
+   double    m_first;      ///< value of the first row, for example the first time
+   double    m_last;       ///< value of the last row, for example the last time
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Structure to store the statistics of one column and the information
+ *         needed to get its values from the read/write - buffer.
+ *
+ *  This Structure is used only internally in FitsDalTable.
+ */
+struct ColStatistics
+{
+   std::string  m_colName;        ///< name of the column
+   int          m_colOffset;      ///< Offset in bytes in the read/write buffer
+   int          m_dataTypeIndex;  ///< index of the data type in the RdCopy array
+   int          m_arraySize;      ///< number of bins, or length of a string column
+   int          m_valueSize;      ///< number of bytes of one bin
+   bool         m_hasNull;        ///< true if the column has a TNULL keyword
+   unsigned char m_nullBytes[8];  ///< the TNULL value as it is stored in the row
+   bool         m_writeKeywords;  ///< write the statistics as header keywords
+   double     (*ValueFct) (const unsigned char *);  ///< converts a bin to double
+   FitsColStatistics m_statistics;  ///< the statistics of the written values
+   uint64_t     m_firstRow;       ///< first row of the statistics, 0 if no row was written
+   uint64_t     m_lastRow;        ///< last row of the statistics
+   bool         m_recompute;      ///< @brief a row of the statistics was written
+                                  ///  again, m_statistics is not valid and the
+                                  ///  statistics are computed from the table
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDal
+ *
+ *  @brief Description of one column of a row layout, known at compile time.
+ *
+ *  The classes of the fits_data_model define the layout of their rows as a
+ *  constexpr array of this struct, see FitsDalTable::UseRowLayout().
+ */
+struct FitsRowLayoutColumn {
+
+   /** *************************************************************************
+    *  @brief The only constructor, initializing all member variables.
+    */
+   constexpr FitsRowLayoutColumn(const char * colName, ColDataType colDataType,
+                                 int32_t arraySize, int32_t offset)
+      : m_colName(colName), m_colDataType(colDataType),
+        m_arraySize(arraySize), m_offset(offset) { }
+
+   const char *   m_colName;     ///<  name of the column
+   ColDataType    m_colDataType; ///<  data type of the column and of its variable
+   int32_t        m_arraySize;   ///<  @brief number of bins of a vector column,
+                                 ///   or length of a string column
+   int32_t        m_offset;      ///<  @brief offset in bytes of the column in
+                                 ///   the FITS table row
+};
+
 /** ****************************************************************************
  *  @ingroup FitsDal
  *  @author Reiner Rohlfs UGE
@@ -320,8 +449,284 @@ public:
     */
 	bool SetReadRow(uint64_t row);
 
+   /** ****************************************************************************
+    *  @brief Returns the number of rows of the table.
+    */
+	uint64_t GetNumRows();
+
+   /** ****************************************************************************
+    *  @brief Reads many rows of the FITS table into a user buffer.
+    *
+    *  The rows are read in large blocks, not one by one, and the values are
+    *  converted with the same functions as used by ReadRow(). The assigned
+    *  variables and the row read by the next call of ReadRow(0) are not
+    *  modified.\n
+    *  Columns of @b columns that do not exist in the FITS table are set to 0.
+    *
+    *  @param [in]  firstRow  first row to read, first row in the table = 1
+    *  @param [in]  numRows   number of rows to read
+    *  @param [in]  columns   location of the columns in one row of @b buffer
+    *  @param [out] buffer    buffer of at least @b numRows * @b rowSize bytes
+    *  @param [in]  rowSize   number of bytes of one row in @b buffer
+    *
+    *  @return the number of rows read, less than @b numRows if the end of the
+    *          table is reached.
+    */
+	uint64_t ReadRows(uint64_t firstRow, uint64_t numRows,
+	                  const std::vector<FitsColBuffer> & columns,
+	                  void * buffer, size_t rowSize);
+
+   /** ****************************************************************************
+    *  @brief Writes many rows from a user buffer into the FITS table.
+    *
+    *  The rows are written like @b numRows calls of WriteRow(), starting at the
+    *  end of the table or at the row defined by PrepareWriteRow(), but in
+    *  large blocks. Columns of the table that are not in @b columns keep their
+    *  value in already existing rows and are set to 0 in new rows.
+    *
+    *  @param [in] numRows   number of rows to write
+    *  @param [in] columns   location of the columns in one row of @b buffer
+    *  @param [in] buffer    buffer of at least @b numRows * @b rowSize bytes
+    *  @param [in] rowSize   number of bytes of one row in @b buffer
+    *
+    *  @throw std::runtime_error if the table was opened in READONLY mode, if
+    *         a column of @b columns does not exist or on a cfitsio error.
+    */
+	void WriteRows(uint64_t numRows, const std::vector<FitsColBuffer> & columns,
+	               const void * buffer, size_t rowSize);
+
+   /** ****************************************************************************
+    *  @brief Updates some columns of already written rows in place.
+    *
+    *  Only the bytes of the columns of @b columns are written, the other
+    *  columns of the rows are neither read nor written and the assigned
+    *  variables are not modified. The values are converted in large blocks
+    *  of rows, this is much faster than PrepareWriteRow() and WriteRow() to
+    *  fill for example a time or a flag column after the rows are written.
+    *  The next row written by WriteRow() does not change.\n
+    *  If a vector column in @b columns has less bins than the FITS column,
+    *  the other bins keep their values.
+    *
+    *  @param [in] firstRow  first row to update, first row in the table = 1
+    *  @param [in] numRows   number of rows to update
+    *  @param [in] columns   location of the columns in one row of @b buffer
+    *  @param [in] buffer    buffer of at least @b numRows * @b rowSize bytes
+    *  @param [in] rowSize   number of bytes of one row in @b buffer
+    *
+    *  @throw std::runtime_error if the table was opened in READONLY mode, if
+    *         a row was not written yet, if a column of @b columns does not
+    *         exist or on a cfitsio error.
+    */
+	void UpdateColumns(uint64_t firstRow, uint64_t numRows,
+	                   const std::vector<FitsColBuffer> & columns,
+	                   const void * buffer, size_t rowSize);
+
+   /** ****************************************************************************
+    *  @brief Appends all rows of @b sourceTable to this table.
+    *
+    *  The result is the same as calling ReadRow() of @b sourceTable and
+    *  WriteRow() of this table for every row, with the same variables
+    *  assigned to all columns of this table in both tables. But if both
+    *  tables have the same columns, with the same data types, sizes and
+    *  offsets, the rows are copied as they are, in large blocks, without
+    *  any conversion. Otherwise many rows are converted at once with
+    *  ReadRows() and WriteRows().\n
+    *  Columns that do not exist in @b sourceTable are set to 0. Bins of
+    *  vector columns that do not exist in @b sourceTable are set to the
+    *  current value of the assigned variable.
+    *
+    *  @param [in] sourceTable  the table of which all rows are copied.
+    *
+    *  @return the number of copied rows.
+    *
+    *  @throw std::runtime_error if this table was opened in READONLY mode,
+    *         if a column cannot be converted or on a cfitsio error.
+    */
+	uint64_t CopyRows(FitsDalTable & sourceTable);
+
+   /** ****************************************************************************
+    *  @brief Appends all rows of several tables with the same columns to this
+    *         table, sorted by the column @b sortColumn.
+    *
+    *  All tables of @b sourceTables must have the same columns as this table,
+    *  with the same data types, sizes and offsets. This is verified once,
+    *  before any row is copied. The rows of every source table have to be
+    *  sorted by @b sortColumn already, as for example the OBT_TIME of the
+    *  per-pass HK tables of a visit.\n
+    *  The rows are copied as they are, in large blocks. If the ranges of
+    *  @b sortColumn of the source tables do not overlap, the tables are copied
+    *  one after the other, ordered by their first value of @b sortColumn.
+    *  Otherwise the rows of all source tables are merged by @b sortColumn
+    *  and rows that are identical to a row already copied with the same
+    *  value of @b sortColumn are skipped. Rows with the same value of
+    *  @b sortColumn keep the order of @b sourceTables.\n
+    *  The memory used does not depend on the number of rows of the tables.
+    *
+    *  @param [in] sourceTables  the tables of which all rows are copied.
+    *  @param [in] sortColumn    a scalar numerical column. If empty, the
+    *                            tables are copied in the order of
+    *                            @b sourceTables, without any sorting.
+    *
+    *  @return the number of copied rows, without the skipped duplicate rows.
+    *
+    *  @throw std::runtime_error if this table was opened in READONLY mode,
+    *         if a source table has other columns than this table, if
+    *         @b sortColumn is not a scalar numerical column or on a cfitsio
+    *         error.
+    */
+	uint64_t ConcatenateRows(const std::vector<FitsDalTable *> & sourceTables,
+	                         const std::string & sortColumn = "OBT_TIME");
+
+   /** ****************************************************************************
+    *  @brief Computes statistics of the values of a column while the rows are
+    *         written.
+    *
+    *  The minimum, maximum, mean, first and last value and the number of NULL
+    *  and NaN values of the column are updated by every row written by
+    *  WriteRow(), WriteRows(), CopyRows() or ConcatenateRows() after this
+    *  call. A row that is written again, for example after a call of
+    *  PrepareWriteRow() or by UpdateColumns(), is included only once with its
+    *  new values. The statistics are returned by GetColumnStatistics(), as
+    *  long as no row is written again no row has to be read from the table.\n
+    *  If @b writeKeywords is true, the minimum and maximum of the column are
+    *  written into the header with the standard keywords TDMINn and TDMAXn,
+    *  where n is the column number, when the table is closed. These keywords
+    *  describe all rows of the table: if the statistics do not include all
+    *  rows, for example if rows were written before this call, the column is
+    *  read again from the table. They are not written for string columns and if no row was
+    *  written.
+    *
+    *  @param [in] colName        an assigned column, or an empty string for
+    *                             all assigned columns.
+    *  @param [in] writeKeywords  write the statistics into the header.
+    *
+    *  @throw std::runtime_error if the table was opened in READONLY mode or
+    *         if the column is not assigned.
+    */
+	void EnableColumnStatistics(const std::string & colName = std::string(),
+	                            bool writeKeywords = false);
+
+   /** ****************************************************************************
+    *  @brief Returns the statistics of the values written into the column
+    *         @b colName, see EnableColumnStatistics().
+    *
+    *  @throw std::runtime_error if EnableColumnStatistics() was not called
+    *         for this column.
+    */
+	FitsColStatistics GetColumnStatistics(const std::string & colName) const;
+
+   /** ****************************************************************************
+    *  @brief Returns true if ReadRow() and WriteRow() use the row layout of
+    *         the derived class, see UseRowLayout().
+    */
+	bool IsRowLayoutUsed() const { return m_useRowLayout; }
+
+protected:
+
+   /** ****************************************************************************
+    *  @brief Uses DecodeRow() and EncodeRow() of the derived class instead of
+    *         the RdCopy and WrCopy functions in ReadRow() and WriteRow().
+    *
+    *  To be called by the constructor of the derived class after all its
+    *  columns are assigned. The row layout is used only if the columns of the
+    *  FITS table have the data type, the size and the offset of
+    *  @b rowLayout and if no other column is assigned. Otherwise, for example
+    *  if an older version of the table is read, the functions of the RdCopy
+    *  and WrCopy arrays are used for all columns.
+    *
+    *  @param [in] rowLayout   the assigned columns, as expected in the FITS
+    *                          table
+    *  @param [in] numColumns  number of columns of @b rowLayout
+    *
+    *  @return true if the row layout is used.
+    */
+	bool UseRowLayout(const FitsRowLayoutColumn * rowLayout, int numColumns);
+
+   /** ****************************************************************************
+    *  @brief Copies the data of a row of the FITS table into the variables
+    *         of the derived class. Used only after UseRowLayout() returned
+    *         true.
+    */
+	virtual void DecodeRow(const unsigned char *) {}
+
+   /** ****************************************************************************
+    *  @brief Copies the variables of the derived class into a row of the FITS
+    *         table. Used only after UseRowLayout() returned true.
+    */
+	virtual void EncodeRow(unsigned char *) {}
+
 private:
 
+      /** *************************************************************************
+       *  @brief Number of rows read or written at once by ReadRows() and
+       *         WriteRows().
+       */
+	   long BlockRows();
+
+      /** *************************************************************************
+       *  @brief Returns true if all columns of this table exist in
+       *         @b sourceTable with the same data type, size and offset and
+       *         if the rows of both tables have the same length.
+       */
+	   bool HasSameRows(FitsDalTable & sourceTable);
+
+      /** *************************************************************************
+       *  @brief Adds empty rows to the end of the FITS table, if it has less
+       *         than @b lastRow rows.
+       */
+	   void InsertRows(uint64_t lastRow);
+
+      /** *************************************************************************
+       *  @brief Copies the bytes of all rows of @b sourceTable to this table,
+       *         starting at row m_nextWriteRow, using @b ioBuffer.
+       *
+       *  The rows have to be inserted before with InsertRows(). Used only if
+       *  HasSameRows() returns true.
+       */
+	   void CopyRawRows(FitsDalTable & sourceTable, std::vector<unsigned char> & ioBuffer);
+
+      /** *************************************************************************
+       *  @brief Updates the statistics of the columns with @b numRows rows of
+       *         the read/write - buffer @b rows.
+       *
+       *  @b firstRow is the row number of the first row in the table. Rows
+       *  that are already included in the statistics are not added again,
+       *  the statistics are then computed from the table when they are
+       *  needed.\n
+       *  By default a row of @b rows is a whole FITS row. Otherwise a row has
+       *  @b rowLength bytes and contains the @b numBytes bytes of the FITS
+       *  row starting at @b firstByte, only the columns in this range are
+       *  updated.
+       */
+	   void AccumulateStatistics(const unsigned char * rows, uint64_t firstRow, uint64_t numRows,
+	                             size_t rowLength = 0, int firstByte = 0, int numBytes = 0);
+
+      /** *************************************************************************
+       *  @brief Computes the statistics of a column from the rows @b firstRow
+       *         to @b lastRow of the table.
+       */
+	   FitsColStatistics ComputeStatistics(const ColStatistics & colStatistics,
+	                                       uint64_t firstRow, uint64_t lastRow) const;
+
+      /** *************************************************************************
+       *  @brief Reads the exact minimum and maximum of the 64 bit integer
+       *         column with data type @b TYPE from the rows @b firstRow to
+       *         @b lastRow of the table, the statistics convert the values to
+       *         double.
+       */
+	   template <ColDataType TYPE, class T>
+	   void ComputeLimits(const ColStatistics & colStatistics,
+	                      uint64_t firstRow, uint64_t lastRow, T & minValue, T & maxValue) const;
+
+      /** *************************************************************************
+       *  @brief Writes the statistics of the columns as header keywords, if
+       *         requested by EnableColumnStatistics().
+       *
+       *  TDMIN and TDMAX of integer columns are written as integer keywords
+       *  with the exact limits.
+       */
+	   void WriteStatisticsKeywords();
+
       /** *************************************************************************
        *  @brief Returns true if column with column number @b col is an unsigned
        *         column.
@@ -339,6 +744,12 @@ private:
 	   /// copy information about all columns, used during the Read() and Write() functions
 	   std::list<ColCopy> m_colCopy;
 
+	   /// true if DecodeRow() and EncodeRow() are used instead of m_colCopy
+	   bool   m_useRowLayout;
+
+	   /// statistics of the columns, updated by every written row
+	   std::vector<ColStatistics> m_colStatistics;
+
 	   /// Meta data of all columns, found while the table was opened in READONLY mode
 	   std::map<std::string, FitsColMetaDataIntern>  m_fitsColMetaData;
 
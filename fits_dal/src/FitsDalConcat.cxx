@@ -0,0 +1,33 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup FitsDal
+ *  @brief Implementation of the function ConcatenateTables()
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-037 first released version
+ *
+ */
+
+#include <memory>
+
+#include "FitsDalConcat.hxx"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t ConcatenateTables(FitsDalTable & outputTable,
+                           const vector<string> & inputFiles,
+                           const string & sortColumn)
+{
+   // all input tables are open while their rows are merged
+   vector<unique_ptr<FitsDalTable> > inputTables;
+   vector<FitsDalTable *> sourceTables;
+   for (const string & inputFile : inputFiles) {
+      inputTables.push_back(unique_ptr<FitsDalTable>(new FitsDalTable(inputFile)));
+      sourceTables.push_back(inputTables.back().get());
+   }
+
+   return outputTable.ConcatenateRows(sourceTables, sortColumn);
+}
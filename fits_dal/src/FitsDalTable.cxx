@@ -6,6 +6,13 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-031 new methods GetNumRows(),
+ *                                ReadRows() and WriteRows() to transfer many
+ *                                rows at once, row layouts of derived classes:
+ *                                UseRowLayout() (user-035), CopyRows()
+ *                                (user-036), ConcatenateRows() (user-037),
+ *                                running statistics of the written columns
+ *                                (user-038), UpdateColumns() (user-039)
  *  @version 9.3.1 2018-06-18 RRO #16505: new method: SetReadRow()
  *  @version 9.0.1 2018-01-31 RRO #15376: update of method IsUnsignedColumn()
  *  @version 9.0   2018-01-04 RRO #15057: new method: GetColUnit() and update of
@@ -37,8 +44,12 @@
 #include <sys/stat.h>
 #include <cmath>
 #include <limits>
+#include <algorithm>
+#include <queue>
+#include <type_traits>
 
 #include "FitsDalTable.hxx"
+#include "FitsDalRowLayout.hxx"
 
 using namespace std;
 
@@ -116,6 +127,7 @@ FitsDalTable::FitsDalTable(const string & filename, const char *mode )
    m_nextWriteRow = 1;
    m_nextReadRow = 1;
    m_rowLength    = 0;
+   m_useRowLayout = false;
 
    m_update = false;
 
@@ -257,6 +269,13 @@ FitsDalTable::~FitsDalTable()
       // nothing to do
       return;
 
+  try {
+     WriteStatisticsKeywords();
+  }
+  catch (...) {
+     // the table is closed also if the statistics keywords cannot be written
+  }
+
   // m_nextWriteRow - 1 is the number of rows the table should have. For performance
   // optimization some more rows may be inserted in the Write() function.
   // The real number of rows in the table is tableLength. Here, the additional
@@ -281,6 +300,8 @@ void FitsDalTable::Assign(const std::string & colName, T * varPointer, int binSi
                           const std::string & comment, const std::string & unit,
                           T * nullValue)
 {
+   // a new column is not part of the row layout of the derived class
+   m_useRowLayout = false;
 
    if (m_update)
       {
@@ -490,6 +511,9 @@ void FitsDalTable::Assign(const std::string & colName, T * varPointer, int binSi
 ///////////////////////////////////////////////////////////////////////////////
 void FitsDalTable::ReAssign(const std::string & colName, void * varPointer) {
 
+   // the row layout copies into the variables of the derived class
+   m_useRowLayout = false;
+
    std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
    while (i_colCopy != m_colCopy.end()) {
       if (i_colCopy->m_colName == colName) {
@@ -596,15 +620,22 @@ void FitsDalTable::WriteRow()
    unsigned char * ioBuffer = (unsigned char*) malloc(m_rowLength);
    memset(ioBuffer, 0, m_rowLength);
 
-   std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
-   while (i_colCopy != m_colCopy.end())
+   if (m_useRowLayout)
+      EncodeRow(ioBuffer);
+   else
       {
-      i_colCopy->WriteFct(ioBuffer + i_colCopy->m_colOffset,
-                          i_colCopy->m_variable,
-                          i_colCopy->m_arraySize);
-      ++i_colCopy;
+      std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
+      while (i_colCopy != m_colCopy.end())
+         {
+         i_colCopy->WriteFct(ioBuffer + i_colCopy->m_colOffset,
+                             i_colCopy->m_variable,
+                             i_colCopy->m_arraySize);
+         ++i_colCopy;
+         }
       }
 
+   AccumulateStatistics(ioBuffer, m_nextWriteRow, 1);
+
    // we are prepared and write all data to the table.
    fits_write_tblbytes(m_fitsFile, m_nextWriteRow, 1, m_rowLength,
                        ioBuffer, &status);
@@ -672,14 +703,19 @@ bool FitsDalTable::ReadRow(uint64_t row)
                           ". cfitsio error: " + to_string(status) );
 
    // copy the data from the buffer into the variables
-   std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
-   while (i_colCopy != m_colCopy.end())
-       {
-       i_colCopy->ReadFct(i_colCopy->m_variable,
-                          ioBuffer + i_colCopy->m_colOffset,
-                          i_colCopy->m_arraySize);
-       ++i_colCopy;
-       }
+   if (m_useRowLayout)
+      DecodeRow(ioBuffer);
+   else
+      {
+      std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
+      while (i_colCopy != m_colCopy.end())
+          {
+          i_colCopy->ReadFct(i_colCopy->m_variable,
+                             ioBuffer + i_colCopy->m_colOffset,
+                             i_colCopy->m_arraySize);
+          ++i_colCopy;
+          }
+      }
 
    free (ioBuffer);
 
@@ -707,6 +743,1098 @@ bool FitsDalTable::SetReadRow(uint64_t row) {
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+bool FitsDalTable::UseRowLayout(const FitsRowLayoutColumn * rowLayout, int numColumns) {
+
+   m_useRowLayout = false;
+
+   // other columns are assigned, or columns of the layout do not exist
+   if (m_colCopy.size() != static_cast<size_t>(numColumns))
+      return false;
+
+   for (int col = 0; col < numColumns; col++) {
+      map<string, FitsColMetaDataIntern>::iterator i_colMD =
+            m_fitsColMetaData.find(rowLayout[col].m_colName);
+      if (i_colMD == m_fitsColMetaData.end() ||
+          i_colMD->second.m_dataTypeIndex != rowLayout[col].m_colDataType ||
+          i_colMD->second.m_arraySize     != rowLayout[col].m_arraySize   ||
+          i_colMD->second.m_offset        != rowLayout[col].m_offset)
+         // the FITS table differs from the layout, use the RdCopy and WrCopy functions
+         return false;
+   }
+
+   m_useRowLayout = true;
+   return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t FitsDalTable::GetNumRows() {
+
+   if (m_update)
+      // rows may have been added in advance by WriteRow()
+      return m_numWrittenRows;
+
+   int status = 0;
+   long tableLength;
+   fits_get_num_rows(m_fitsFile, &tableLength, &status);
+   if (status != 0)
+      throw runtime_error("Failed to get the number of rows of table " + GetFileName() +
+                          ". cfitsio error: " + to_string(status) );
+
+   return tableLength;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+long FitsDalTable::BlockRows() {
+
+   // optimal number of rows to read and write in one step
+   int status = 0;
+   long bestNumRows = 1;
+   fits_get_rowsize(m_fitsFile, &bestNumRows, &status);
+
+   return bestNumRows > 0 ? bestNumRows : 1;
+}
+
+/// Copy information of one column between the FITS rows and a user buffer,
+/// used by ReadRows() and WriteRows()
+struct BufferCopy
+{
+   void  (*m_copyFct) (void *, void *, int); ///< conversion function, nullptr for strings
+   int    m_fitsOffset;     ///< offset of the column in the FITS row, -1 if the column does not exist
+   int    m_fitsArraySize;  ///< number of bins of the FITS column
+   size_t m_bufferOffset;   ///< offset of the column in a row of the user buffer
+   int    m_arraySize;      ///< number of bins of the column in the user buffer
+   int    m_valueSize;      ///< number of bytes of one bin in the user buffer
+};
+
+/// number of bytes of one value in a user buffer, index is ColDataType
+static const int COL_DATA_TYPE_SIZE[12] = {1, 1, 1, 2, 2, 4, 4, 8, 8, 4, 8, 1};
+
+/// minimum number of bytes copied at once by CopyRows()
+static const uint64_t COPY_BLOCK_BYTES = 8 * 1024 * 1024;
+
+/// Resolves the copy functions of the columns of a user buffer
+static vector<BufferCopy> GetBufferCopy(const vector<FitsColBuffer> & columns,
+                                        const map<string, FitsColMetaDataIntern> & fitsColMetaData,
+                                        bool read, const string & fileName)
+{
+   vector<BufferCopy> bufferCopy;
+   for (const FitsColBuffer & column : columns) {
+
+      BufferCopy copy;
+      copy.m_copyFct       = nullptr;
+      copy.m_fitsOffset    = -1;
+      copy.m_fitsArraySize = 0;
+      copy.m_bufferOffset  = column.m_offset;
+      copy.m_arraySize     = column.m_arraySize;
+      copy.m_valueSize     = COL_DATA_TYPE_SIZE[column.m_colDataType];
+
+      map<string, FitsColMetaDataIntern>::const_iterator i_fitsColMetaData =
+            fitsColMetaData.find(column.m_colName);
+      if (i_fitsColMetaData == fitsColMetaData.end()) {
+         if (!read)
+            throw runtime_error("Failed to write rows, column " + column.m_colName +
+                                " does not exist in table " + fileName);
+         bufferCopy.push_back(copy);
+         continue;
+      }
+
+      int fitsDataTypeIndex = i_fitsColMetaData->second.m_dataTypeIndex;
+      int userDataTypeIndex = column.m_colDataType;
+      if ((fitsDataTypeIndex == col_string) != (userDataTypeIndex == col_string))
+         throw runtime_error("Column " + column.m_colName + " of table " + fileName +
+                             " cannot be converted between a string and a number.");
+
+      if (userDataTypeIndex != col_string)
+         copy.m_copyFct = read ? RdCopy[fitsDataTypeIndex][userDataTypeIndex] :
+                                 WrCopy[userDataTypeIndex][fitsDataTypeIndex];
+      copy.m_fitsOffset    = i_fitsColMetaData->second.m_offset;
+      copy.m_fitsArraySize = i_fitsColMetaData->second.m_arraySize;
+      bufferCopy.push_back(copy);
+   }
+
+   return bufferCopy;
+}
+
+/// Copies the value(s) of one column of a row of a user buffer into a FITS row
+static void CopyToFitsCell(const BufferCopy & copy, unsigned char * dest, const unsigned char * userCell)
+{
+   unsigned char * src = const_cast<unsigned char *>(userCell);
+   int arraySize = min(copy.m_arraySize, copy.m_fitsArraySize);
+
+   if (copy.m_copyFct)
+      copy.m_copyFct(dest, src, arraySize);
+   else {
+      // string: fill with blanks, as WriteRow()
+      int length = strnlen((const char *)src, arraySize);
+      memcpy(dest, src, length);
+      memset(dest + length, ' ', copy.m_fitsArraySize - length);
+      if (length == 0)  // this is the NULL value of a string
+         dest[0] = 0;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t FitsDalTable::ReadRows(uint64_t firstRow, uint64_t numRows,
+                                const vector<FitsColBuffer> & columns,
+                                void * buffer, size_t rowSize)
+{
+   if (firstRow == 0)
+      firstRow = 1;
+
+   uint64_t tableLength = GetNumRows();
+   if (firstRow > tableLength)
+      return 0;
+   if (numRows > tableLength - firstRow + 1)
+      numRows = tableLength - firstRow + 1;
+
+   vector<BufferCopy> bufferCopy = GetBufferCopy(columns, m_fitsColMetaData, true, GetFileName());
+
+   uint64_t blockRows = BlockRows();
+   vector<unsigned char> ioBuffer(min(blockRows, numRows) * m_rowLength);
+
+   uint64_t row = 0;
+   while (row < numRows) {
+
+      uint64_t rows = min(blockRows, numRows - row);
+
+      int status = 0;
+      fits_read_tblbytes(m_fitsFile, firstRow + row, 1, rows * m_rowLength,
+                         ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to read rows " + to_string(firstRow + row) +
+                             " to " + to_string(firstRow + row + rows - 1) +
+                             " in table " + GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      for (uint64_t blockRow = 0; blockRow < rows; blockRow++) {
+         unsigned char * fitsRow = ioBuffer.data() + blockRow * m_rowLength;
+         unsigned char * userRow = (unsigned char *)buffer + (row + blockRow) * rowSize;
+
+         for (const BufferCopy & copy : bufferCopy) {
+            unsigned char * dest = userRow + copy.m_bufferOffset;
+            int arraySize = min(copy.m_arraySize, copy.m_fitsArraySize);
+
+            // bins that are not in the FITS column are set to 0
+            if (arraySize < copy.m_arraySize)
+               memset(dest + arraySize * copy.m_valueSize, 0,
+                      (copy.m_arraySize - arraySize) * copy.m_valueSize);
+            if (arraySize == 0)
+               continue;
+
+            if (copy.m_copyFct)
+               copy.m_copyFct(dest, fitsRow + copy.m_fitsOffset, arraySize);
+            else {
+               // string: remove the blanks at the end of the string, as ReadRow()
+               memcpy(dest, fitsRow + copy.m_fitsOffset, arraySize);
+               int length = arraySize;
+               while (length > 0 && (dest[length - 1] == ' ' || dest[length - 1] == 0))
+                  length--;
+               memset(dest + length, 0, arraySize - length);
+            }
+         }
+      }
+
+      row += rows;
+   }
+
+   return numRows;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::WriteRows(uint64_t numRows, const vector<FitsColBuffer> & columns,
+                             const void * buffer, size_t rowSize)
+{
+   if (!m_update)
+      throw runtime_error("Failed to write rows into table " + GetFileName() +
+                          ", the table was opened in READONLY mode.");
+   if (numRows == 0)
+      return;
+
+   vector<BufferCopy> bufferCopy = GetBufferCopy(columns, m_fitsColMetaData, false, GetFileName());
+
+   // add rows if we would write behind the end of the table
+   uint64_t lastRow = m_nextWriteRow + numRows - 1;
+   InsertRows(lastRow);
+
+   int status = 0;
+
+   uint64_t blockRows = BlockRows();
+   vector<unsigned char> ioBuffer(min(blockRows, numRows) * m_rowLength);
+
+   uint64_t row = 0;
+   while (row < numRows) {
+
+      uint64_t rows = min(blockRows, numRows - row);
+      uint64_t fitsRow = m_nextWriteRow + row;
+
+      // already written rows are updated: keep the values of the other columns
+      uint64_t existingRows = 0;
+      if (fitsRow <= (uint64_t)m_numWrittenRows)
+         existingRows = min(rows, m_numWrittenRows - fitsRow + 1);
+      if (existingRows > 0) {
+         fits_read_tblbytes(m_fitsFile, fitsRow, 1, existingRows * m_rowLength,
+                            ioBuffer.data(), &status);
+         if (status != 0)
+            throw runtime_error("Failed to read from row " + to_string(fitsRow) +
+                                " in table " + GetFileName() +
+                                ". cfitsio error: " + to_string(status) );
+      }
+      memset(ioBuffer.data() + existingRows * m_rowLength, 0, (rows - existingRows) * m_rowLength);
+
+      for (uint64_t blockRow = 0; blockRow < rows; blockRow++) {
+         unsigned char * fitsData = ioBuffer.data() + blockRow * m_rowLength;
+         const unsigned char * userRow = (const unsigned char *)buffer + (row + blockRow) * rowSize;
+
+         for (const BufferCopy & copy : bufferCopy)
+            CopyToFitsCell(copy, fitsData + copy.m_fitsOffset, userRow + copy.m_bufferOffset);
+      }
+
+      AccumulateStatistics(ioBuffer.data(), fitsRow, rows);
+
+      fits_write_tblbytes(m_fitsFile, fitsRow, 1, rows * m_rowLength,
+                          ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to write to rows " + to_string(fitsRow) +
+                             " to " + to_string(fitsRow + rows - 1) +
+                             " in table " +  GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      row += rows;
+   }
+
+   if ((long)lastRow > m_numWrittenRows)
+      m_numWrittenRows = lastRow;
+   m_nextWriteRow = lastRow + 1;
+
+   // as WriteRow(): read the next row before it is updated with new values
+   if (m_nextWriteRow <= m_numWrittenRows)
+      ReadRow(m_nextWriteRow);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::UpdateColumns(uint64_t firstRow, uint64_t numRows,
+                                 const vector<FitsColBuffer> & columns,
+                                 const void * buffer, size_t rowSize)
+{
+   if (!m_update)
+      throw runtime_error("Failed to update rows of table " + GetFileName() +
+                          ", the table was opened in READONLY mode.");
+   if (numRows == 0 || columns.empty())
+      return;
+   if (firstRow == 0 || firstRow + numRows - 1 > (uint64_t)m_numWrittenRows)
+      throw runtime_error("Failed to update rows " + to_string(firstRow) + " to " +
+                          to_string(firstRow + numRows - 1) + " of table " + GetFileName() +
+                          ", the table has " + to_string(m_numWrittenRows) + " rows.");
+
+   vector<BufferCopy> bufferCopy = GetBufferCopy(columns, m_fitsColMetaData, false, GetFileName());
+
+   // the bytes of a cell that are written: all bins of the user buffer and
+   // the whole cell of a string column, that is filled with blanks
+   vector<pair<int, int> > cells;   // first byte and number of bytes in the FITS row
+   for (size_t index = 0; index < columns.size(); index++) {
+      const FitsColMetaDataIntern & colMD = m_fitsColMetaData.find(columns[index].m_colName)->second;
+      int valueSize = COL_DATA_TYPE_SIZE[colMD.m_dataTypeIndex];
+      int numBins   = bufferCopy[index].m_copyFct ?
+                      min(bufferCopy[index].m_arraySize, bufferCopy[index].m_fitsArraySize) :
+                      bufferCopy[index].m_fitsArraySize;
+      cells.push_back(make_pair(int(colMD.m_offset), numBins * valueSize));
+   }
+
+   // adjacent columns are written together, as one segment of the FITS row
+   vector<pair<int, int> > sortedCells(cells);
+   sort(sortedCells.begin(), sortedCells.end());
+   vector<pair<int, int> > segments;   // first byte and number of bytes in the FITS row
+   for (const pair<int, int> & cell : sortedCells) {
+      if (cell.second == 0)
+         continue;
+      if (!segments.empty() && cell.first <= segments.back().first + segments.back().second)
+         segments.back().second = max(segments.back().second,
+                                      cell.first + cell.second - segments.back().first);
+      else
+         segments.push_back(cell);
+   }
+
+   // in ioBuffer the segments of a row are stored one after the other
+   vector<size_t> segmentPos;
+   size_t updateLength = 0;
+   for (const pair<int, int> & segment : segments) {
+      segmentPos.push_back(updateLength);
+      updateLength += segment.second;
+   }
+   if (updateLength == 0)
+      return;
+
+   // position of the columns in ioBuffer
+   vector<size_t> cellPos;
+   for (const pair<int, int> & cell : cells) {
+      if (cell.second == 0) {
+         cellPos.push_back(0);
+         continue;
+      }
+      size_t segment = 0;
+      while (segment + 1 < segments.size() && segments[segment + 1].first <= cell.first)
+         segment++;
+      cellPos.push_back(segmentPos[segment] + cell.first - segments[segment].first);
+   }
+
+   // the statistics of the updated columns are computed again from the table
+   uint64_t lastRow = firstRow + numRows - 1;
+   for (ColStatistics & colStatistics : m_colStatistics) {
+      int colEnd = colStatistics.m_colOffset + colStatistics.m_arraySize * colStatistics.m_valueSize;
+      for (const pair<int, int> & segment : segments) {
+         if (segment.first < colEnd && colStatistics.m_colOffset < segment.first + segment.second) {
+            colStatistics.m_firstRow  = colStatistics.m_firstRow == 0 ?
+                                        firstRow : min(colStatistics.m_firstRow, firstRow);
+            colStatistics.m_lastRow   = max(colStatistics.m_lastRow, lastRow);
+            colStatistics.m_recompute = true;
+            break;
+         }
+      }
+   }
+
+   // The values are converted for a whole block of rows. Only the bytes of
+   // the segments are written, so the other columns of the rows are not
+   // touched, cfitsio collects the writes of the rows in its buffers. If the
+   // segment is the whole row the block is written with one call.
+   bool wholeRows = segments.size() == 1 && updateLength == (size_t)m_rowLength;
+   uint64_t blockRows = max<uint64_t>(BlockRows(), COPY_BLOCK_BYTES / updateLength);
+   vector<unsigned char> ioBuffer(min(blockRows, numRows) * updateLength);
+
+   int status = 0;
+   uint64_t row = 0;
+   while (row < numRows) {
+
+      uint64_t rows = min(blockRows, numRows - row);
+      uint64_t fitsRow = firstRow + row;
+
+      for (uint64_t blockRow = 0; blockRow < rows; blockRow++) {
+         unsigned char * updateRow = ioBuffer.data() + blockRow * updateLength;
+         const unsigned char * userRow = (const unsigned char *)buffer + (row + blockRow) * rowSize;
+         for (size_t index = 0; index < bufferCopy.size(); index++)
+            if (cells[index].second > 0)
+               CopyToFitsCell(bufferCopy[index], updateRow + cellPos[index],
+                              userRow + bufferCopy[index].m_bufferOffset);
+      }
+
+      if (wholeRows)
+         fits_write_tblbytes(m_fitsFile, fitsRow, 1, rows * updateLength,
+                             ioBuffer.data(), &status);
+      else
+         for (uint64_t blockRow = 0; blockRow < rows && status == 0; blockRow++)
+            for (size_t segment = 0; segment < segments.size(); segment++)
+               fits_write_tblbytes(m_fitsFile, fitsRow + blockRow, segments[segment].first + 1,
+                                   segments[segment].second,
+                                   ioBuffer.data() + blockRow * updateLength + segmentPos[segment],
+                                   &status);
+      if (status != 0)
+         throw runtime_error("Failed to update rows " + to_string(fitsRow) +
+                             " to " + to_string(fitsRow + rows - 1) +
+                             " in table " +  GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      row += rows;
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t FitsDalTable::CopyRows(FitsDalTable & sourceTable)
+{
+   if (!m_update)
+      throw runtime_error("Failed to copy rows into table " + GetFileName() +
+                          ", the table was opened in READONLY mode.");
+
+   uint64_t numRows = sourceTable.GetNumRows();
+   if (numRows == 0 || m_colCopy.empty())
+      return 0;
+
+   // the rows are appended at the end of the table
+   m_nextWriteRow = m_numWrittenRows + 1;
+
+   if (!HasSameRows(sourceTable)) {
+      // convert the rows in blocks, in a buffer with the assigned columns
+      vector<FitsColBuffer> columns;
+      size_t rowSize = 0;
+
+      // bins of vector columns that are not in the source table
+      struct Padding { size_t m_offset; size_t m_length; const void * m_value; };
+      vector<Padding> padding;
+
+      std::list<ColCopy>::iterator i_colCopy = m_colCopy.begin();
+      while (i_colCopy != m_colCopy.end()) {
+         const FitsColMetaDataIntern & colMD = m_fitsColMetaData.find(i_colCopy->m_colName)->second;
+         ColDataType colDataType = static_cast<ColDataType>(colMD.m_dataTypeIndex);
+         columns.push_back(FitsColBuffer(i_colCopy->m_colName, colDataType,
+                                         colMD.m_arraySize, rowSize));
+
+         map<string, FitsColMetaDataIntern>::iterator i_srcColMD =
+               sourceTable.m_fitsColMetaData.find(i_colCopy->m_colName);
+         int valueSize = COL_DATA_TYPE_SIZE[colDataType];
+         if (colDataType != col_string && i_srcColMD != sourceTable.m_fitsColMetaData.end() &&
+             i_srcColMD->second.m_arraySize < colMD.m_arraySize) {
+            Padding pad;
+            pad.m_offset = rowSize + i_srcColMD->second.m_arraySize * valueSize;
+            pad.m_length = (colMD.m_arraySize - i_srcColMD->second.m_arraySize) * valueSize;
+            pad.m_value  = (const char *)i_colCopy->m_variable + i_srcColMD->second.m_arraySize * valueSize;
+            padding.push_back(pad);
+         }
+
+         rowSize += colMD.m_arraySize * valueSize;
+         ++i_colCopy;
+      }
+
+      uint64_t blockRows = max<uint64_t>(sourceTable.BlockRows(), COPY_BLOCK_BYTES / rowSize);
+      vector<unsigned char> buffer(min(blockRows, numRows) * rowSize);
+
+      uint64_t row = 0;
+      while (row < numRows) {
+         uint64_t rows = sourceTable.ReadRows(row + 1, min(blockRows, numRows - row),
+                                              columns, buffer.data(), rowSize);
+         for (const Padding & pad : padding)
+            for (uint64_t blockRow = 0; blockRow < rows; blockRow++)
+               memcpy(buffer.data() + blockRow * rowSize + pad.m_offset, pad.m_value, pad.m_length);
+
+         WriteRows(rows, columns, buffer.data(), rowSize);
+         row += rows;
+      }
+
+      return numRows;
+   }
+
+   // identical rows: copy the bytes of the rows
+   InsertRows(m_nextWriteRow + numRows - 1);
+
+   vector<unsigned char> ioBuffer;
+   CopyRawRows(sourceTable, ioBuffer);
+
+   return numRows;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool FitsDalTable::HasSameRows(FitsDalTable & sourceTable)
+{
+   // the rows are identical if all columns have the same data type, size and offset
+   bool sameRows = sourceTable.m_rowLength == m_rowLength;
+   map<string, FitsColMetaDataIntern>::iterator i_colMD = m_fitsColMetaData.begin();
+   while (sameRows && i_colMD != m_fitsColMetaData.end()) {
+      map<string, FitsColMetaDataIntern>::iterator i_srcColMD =
+            sourceTable.m_fitsColMetaData.find(i_colMD->first);
+      sameRows = i_srcColMD != sourceTable.m_fitsColMetaData.end() &&
+                 i_srcColMD->second.m_dataTypeIndex == i_colMD->second.m_dataTypeIndex &&
+                 i_srcColMD->second.m_arraySize     == i_colMD->second.m_arraySize &&
+                 i_srcColMD->second.m_offset        == i_colMD->second.m_offset;
+      ++i_colMD;
+   }
+
+   return sameRows;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::InsertRows(uint64_t lastRow)
+{
+   int status = 0;
+   long tableLength;
+   fits_get_num_rows(m_fitsFile, &tableLength, &status);
+
+   if (lastRow > (uint64_t)tableLength) {
+      fits_insert_rows(m_fitsFile, tableLength, lastRow - tableLength, &status);
+      if (status != 0)
+         throw runtime_error("Failed to add " + to_string(lastRow - tableLength) +
+                             " rows to the end of table " +  GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::CopyRawRows(FitsDalTable & sourceTable, vector<unsigned char> & ioBuffer)
+{
+   uint64_t numRows = sourceTable.GetNumRows();
+
+   uint64_t blockRows = max<uint64_t>(BlockRows(), COPY_BLOCK_BYTES / m_rowLength);
+   if (ioBuffer.size() < min(blockRows, numRows) * m_rowLength)
+      ioBuffer.resize(min(blockRows, numRows) * m_rowLength);
+
+   int status = 0;
+   uint64_t row = 0;
+   while (row < numRows) {
+
+      uint64_t rows = min(blockRows, numRows - row);
+
+      fits_read_tblbytes(sourceTable.m_fitsFile, row + 1, 1, rows * m_rowLength,
+                         ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to read rows " + to_string(row + 1) +
+                             " to " + to_string(row + rows) +
+                             " in table " + sourceTable.GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      AccumulateStatistics(ioBuffer.data(), m_nextWriteRow + row, rows);
+
+      fits_write_tblbytes(m_fitsFile, m_nextWriteRow + row, 1, rows * m_rowLength,
+                          ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to write to rows " + to_string(m_nextWriteRow + row) +
+                             " to " + to_string(m_nextWriteRow + row + rows - 1) +
+                             " in table " +  GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      row += rows;
+   }
+
+   uint64_t lastRow = m_nextWriteRow + numRows - 1;
+   if ((long)lastRow > m_numWrittenRows)
+      m_numWrittenRows = lastRow;
+   m_nextWriteRow = lastRow + 1;
+}
+
+/// Returns a value of which the unsigned order is the numerical order of
+/// @b value, used to compare the values of the sort column of ConcatenateRows()
+template <typename T>
+static uint64_t OrderedBits(T value)
+{
+   const uint64_t signBit = 0x8000000000000000ULL;
+   if (std::is_floating_point<T>::value) {
+      double doubleValue = value;
+      uint64_t bits;
+      memcpy(&bits, &doubleValue, sizeof(bits));
+      return (bits & signBit) ? ~bits : bits ^ signBit;
+   }
+   if (std::is_signed<T>::value)
+      return uint64_t(int64_t(value)) ^ signBit;
+   return uint64_t(value);
+}
+
+/// Reads the value of a scalar column in a FITS row and returns its OrderedBits()
+template <ColDataType TYPE>
+static uint64_t SortKey(const unsigned char * cell)
+{
+   typename FitsColCodec<TYPE>::value_type value;
+   FitsColCodec<TYPE>::Read(&value, cell, 1);
+   return OrderedBits(value);
+}
+
+/// SortKey() functions of the columns, index is ColDataType
+static uint64_t (* const SORT_KEY[12]) (const unsigned char *) = {
+   nullptr,           SortKey<col_int8>,   SortKey<col_uint8>,  SortKey<col_int16>,
+   SortKey<col_uint16>, SortKey<col_int32>, SortKey<col_uint32>, SortKey<col_int64>,
+   SortKey<col_uint64>, SortKey<col_float>, SortKey<col_double>, nullptr };
+
+/// maximum number of rows with the same value of the sort column that are
+/// compared by ConcatenateRows() to find duplicate rows
+static const size_t MAX_SAME_KEY_ROWS = 64;
+
+/// One source table of ConcatenateRows() while the rows are merged
+struct MergeInput
+{
+   FitsDalTable *        m_table;      ///< the source table
+   uint64_t              m_numRows;    ///< number of rows of the source table
+   uint64_t              m_nextRow;    ///< next row to read into m_buffer, first row = 1
+   vector<unsigned char> m_buffer;     ///< a block of rows of the source table
+   uint64_t              m_bufferRows; ///< number of rows in m_buffer
+   uint64_t              m_bufferRow;  ///< the next row to merge in m_buffer
+};
+
+///////////////////////////////////////////////////////////////////////////////
+uint64_t FitsDalTable::ConcatenateRows(const vector<FitsDalTable *> & sourceTables,
+                                       const string & sortColumn)
+{
+   if (!m_update)
+      throw runtime_error("Failed to concatenate rows into table " + GetFileName() +
+                          ", the table was opened in READONLY mode.");
+
+   if (m_colCopy.empty())
+      return 0;
+
+   // verify once that all source tables have the same columns as this table
+   vector<FitsDalTable *> tables;
+   uint64_t numRows = 0;
+   for (FitsDalTable * sourceTable : sourceTables) {
+      if (!HasSameRows(*sourceTable))
+         throw runtime_error("Failed to concatenate table " + sourceTable->GetFileName() +
+                             " to table " + GetFileName() +
+                             ", the tables do not have the same columns.");
+      uint64_t sourceRows = sourceTable->GetNumRows();
+      if (sourceRows > 0) {
+         tables.push_back(sourceTable);
+         numRows += sourceRows;
+      }
+   }
+   if (numRows == 0)
+      return 0;
+
+   uint64_t (*sortKey) (const unsigned char *) = nullptr;
+   int keyOffset = 0;
+   int keySize   = 0;
+   if (!sortColumn.empty()) {
+      map<string, FitsColMetaDataIntern>::iterator i_colMD = m_fitsColMetaData.find(sortColumn);
+      if (i_colMD == m_fitsColMetaData.end() || i_colMD->second.m_arraySize != 1 ||
+          SORT_KEY[i_colMD->second.m_dataTypeIndex] == nullptr)
+         throw runtime_error("Failed to concatenate rows into table " + GetFileName() +
+                             ", " + sortColumn + " is not a scalar numerical column.");
+      sortKey   = SORT_KEY[i_colMD->second.m_dataTypeIndex];
+      keyOffset = i_colMD->second.m_offset;
+      keySize   = COL_DATA_TYPE_SIZE[i_colMD->second.m_dataTypeIndex];
+   }
+
+   // the rows are appended at the end of the table, all rows are added at once
+   m_nextWriteRow = m_numWrittenRows + 1;
+   InsertRows(m_nextWriteRow + numRows - 1);
+
+   int status = 0;
+   bool overlap = false;
+   if (sortKey) {
+      // order the tables by the first value of the sort column
+      vector<pair<uint64_t, uint64_t> > range;   // first and last value of each table
+      for (FitsDalTable * table : tables) {
+         unsigned char first[8], last[8];
+         fits_read_tblbytes(table->m_fitsFile, 1, keyOffset + 1, keySize, first, &status);
+         fits_read_tblbytes(table->m_fitsFile, table->GetNumRows(), keyOffset + 1,
+                            keySize, last, &status);
+         if (status != 0)
+            throw runtime_error("Failed to read column " + sortColumn + " in table " +
+                                table->GetFileName() + ". cfitsio error: " + to_string(status) );
+         range.push_back(make_pair(sortKey(first), sortKey(last)));
+      }
+
+      vector<size_t> order(tables.size());
+      for (size_t index = 0; index < order.size(); index++)
+         order[index] = index;
+      stable_sort(order.begin(), order.end(), [&range](size_t a, size_t b)
+                  { return range[a].first < range[b].first; });
+
+      vector<FitsDalTable *> orderedTables;
+      for (size_t index = 0; index < order.size(); index++) {
+         orderedTables.push_back(tables[order[index]]);
+         if (index > 0 && range[order[index]].first <= range[order[index - 1]].second)
+            overlap = true;
+      }
+      tables.swap(orderedTables);
+   }
+
+   if (!overlap) {
+      // copy the tables one after the other
+      vector<unsigned char> ioBuffer;
+      for (FitsDalTable * table : tables)
+         CopyRawRows(*table, ioBuffer);
+      return numRows;
+   }
+
+   // k-way merge of the rows. Every table is read in blocks, together the
+   // blocks of all tables use as much memory as the block of the merged rows.
+   uint64_t inputBlockRows  = max<uint64_t>(1, COPY_BLOCK_BYTES / (tables.size() * m_rowLength));
+   uint64_t outputBlockRows = max<uint64_t>(1, COPY_BLOCK_BYTES / m_rowLength);
+
+   vector<MergeInput> inputs(tables.size());
+   auto readBlock = [&](MergeInput & input) {
+      uint64_t rows = min(inputBlockRows, input.m_numRows - input.m_nextRow + 1);
+      input.m_bufferRow  = 0;
+      input.m_bufferRows = rows;
+      if (rows == 0)
+         return;
+      fits_read_tblbytes(input.m_table->m_fitsFile, input.m_nextRow, 1, rows * m_rowLength,
+                         input.m_buffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to read rows " + to_string(input.m_nextRow) +
+                             " to " + to_string(input.m_nextRow + rows - 1) +
+                             " in table " + input.m_table->GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+      input.m_nextRow += rows;
+   };
+
+   // the next row of every table, ordered by the sort column and by the table
+   typedef pair<uint64_t, size_t> MergeKey;
+   priority_queue<MergeKey, vector<MergeKey>, greater<MergeKey> > nextRows;
+
+   for (size_t index = 0; index < tables.size(); index++) {
+      MergeInput & input = inputs[index];
+      input.m_table   = tables[index];
+      input.m_numRows = tables[index]->GetNumRows();
+      input.m_nextRow = 1;
+      input.m_buffer.resize(min(inputBlockRows, input.m_numRows) * m_rowLength);
+      readBlock(input);
+      nextRows.push(MergeKey(sortKey(input.m_buffer.data() + keyOffset), index));
+   }
+
+   vector<unsigned char> outBuffer(min(outputBlockRows, numRows) * m_rowLength);
+   uint64_t outRows = 0;    // number of rows in outBuffer
+   uint64_t written = 0;    // number of rows written into the table
+
+   auto writeBlock = [&]() {
+      if (outRows == 0)
+         return;
+      AccumulateStatistics(outBuffer.data(), m_nextWriteRow + written, outRows);
+      fits_write_tblbytes(m_fitsFile, m_nextWriteRow + written, 1, outRows * m_rowLength,
+                          outBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to write to rows " + to_string(m_nextWriteRow + written) +
+                             " to " + to_string(m_nextWriteRow + written + outRows - 1) +
+                             " in table " +  GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+      written += outRows;
+      outRows = 0;
+   };
+
+   // rows already copied with the value currentKey of the sort column
+   vector<unsigned char> sameKeyRows;
+   uint64_t currentKey = 0;
+
+   while (!nextRows.empty()) {
+
+      MergeKey next = nextRows.top();
+      nextRows.pop();
+      MergeInput & input = inputs[next.second];
+      const unsigned char * row = input.m_buffer.data() + input.m_bufferRow * m_rowLength;
+
+      if (sameKeyRows.empty() || next.first != currentKey) {
+         sameKeyRows.clear();
+         currentKey = next.first;
+      }
+
+      // skip rows that are in several tables
+      bool duplicate = false;
+      for (size_t offset = 0; offset < sameKeyRows.size() && !duplicate; offset += m_rowLength)
+         duplicate = memcmp(sameKeyRows.data() + offset, row, m_rowLength) == 0;
+
+      if (!duplicate) {
+         if (sameKeyRows.size() < MAX_SAME_KEY_ROWS * m_rowLength)
+            sameKeyRows.insert(sameKeyRows.end(), row, row + m_rowLength);
+
+         memcpy(outBuffer.data() + outRows * m_rowLength, row, m_rowLength);
+         if (++outRows == outputBlockRows)
+            writeBlock();
+      }
+
+      // the next row of this table
+      input.m_bufferRow++;
+      if (input.m_bufferRow == input.m_bufferRows)
+         readBlock(input);
+      if (input.m_bufferRow < input.m_bufferRows)
+         nextRows.push(MergeKey(sortKey(input.m_buffer.data() + input.m_bufferRow * m_rowLength +
+                                        keyOffset), next.second));
+   }
+   writeBlock();
+
+   // the rows added for the skipped duplicate rows are deleted by the destructor
+   m_numWrittenRows = m_nextWriteRow + written - 1;
+   m_nextWriteRow   = m_numWrittenRows + 1;
+
+   return written;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double FitsColStatistics::GetMean() const
+{
+   return m_numValues > 0 ? m_sum / m_numValues : numeric_limits<double>::quiet_NaN();
+}
+
+/// Reads one value of a column in a FITS row and converts it to double, used
+/// by the statistics of the columns
+template <ColDataType TYPE>
+static double ValueOf(const unsigned char * cell)
+{
+   typename FitsColCodec<TYPE>::value_type value;
+   FitsColCodec<TYPE>::Read(&value, cell, 1);
+   return double(value);
+}
+
+/// ValueOf() functions of the columns, index is ColDataType
+static double (* const VALUE_OF[12]) (const unsigned char *) = {
+   ValueOf<col_bool>,   ValueOf<col_int8>,   ValueOf<col_uint8>,  ValueOf<col_int16>,
+   ValueOf<col_uint16>, ValueOf<col_int32>,  ValueOf<col_uint32>, ValueOf<col_int64>,
+   ValueOf<col_uint64>, ValueOf<col_float>,  ValueOf<col_double>, nullptr };
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::EnableColumnStatistics(const string & colName, bool writeKeywords)
+{
+   if (!m_update)
+      throw runtime_error("Failed to enable the statistics of the columns of table " +
+                          GetFileName() + ", the table was opened in READONLY mode.");
+
+   bool found = false;
+   for (const ColCopy & colCopy : m_colCopy) {
+      if (!colName.empty() && colCopy.m_colName != colName)
+         continue;
+      found = true;
+
+      const FitsColMetaDataIntern & colMD = m_fitsColMetaData.find(colCopy.m_colName)->second;
+
+      ColStatistics colStatistics;
+      colStatistics.m_colName       = colCopy.m_colName;
+      colStatistics.m_colOffset     = colMD.m_offset;
+      colStatistics.m_dataTypeIndex = colMD.m_dataTypeIndex;
+      colStatistics.m_arraySize     = colMD.m_arraySize;
+      colStatistics.m_valueSize     = COL_DATA_TYPE_SIZE[colMD.m_dataTypeIndex];
+      colStatistics.m_hasNull       = false;
+      colStatistics.m_writeKeywords = writeKeywords;
+      colStatistics.ValueFct        = VALUE_OF[colMD.m_dataTypeIndex];
+      colStatistics.m_firstRow      = 0;
+      colStatistics.m_lastRow       = 0;
+      colStatistics.m_recompute     = false;
+      memset(colStatistics.m_nullBytes, 0, sizeof(colStatistics.m_nullBytes));
+
+      // the TNULL value is compared with the bytes of the cell, as they are
+      // stored in the FITS file
+      if (colMD.m_dataTypeIndex >= col_int8 && colMD.m_dataTypeIndex <= col_uint64) {
+         try {
+            int64_t nullValue = GetAttr<int64_t>("TNULL" + to_string(colMD.m_colNum));
+            for (int byte = 0; byte < colStatistics.m_valueSize; byte++)
+               colStatistics.m_nullBytes[byte] =
+                     (nullValue >> (8 * (colStatistics.m_valueSize - 1 - byte))) & 0xFF;
+            colStatistics.m_hasNull = true;
+         }
+         catch (runtime_error &) {
+            // the column has no NULL value
+         }
+      }
+
+      // the statistics start again if they are enabled again
+      vector<ColStatistics>::iterator i_colStatistics = m_colStatistics.begin();
+      while (i_colStatistics != m_colStatistics.end() &&
+             i_colStatistics->m_colName != colStatistics.m_colName)
+         ++i_colStatistics;
+      if (i_colStatistics != m_colStatistics.end())
+         *i_colStatistics = colStatistics;
+      else
+         m_colStatistics.push_back(colStatistics);
+   }
+
+   if (!found)
+      throw runtime_error("Failed to enable the statistics of column " + colName +
+                          " of table " + GetFileName() + ", the column is not assigned.");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+FitsColStatistics FitsDalTable::GetColumnStatistics(const string & colName) const
+{
+   for (const ColStatistics & colStatistics : m_colStatistics)
+      if (colStatistics.m_colName == colName)
+         return colStatistics.m_recompute ?
+                ComputeStatistics(colStatistics, colStatistics.m_firstRow, colStatistics.m_lastRow) :
+                colStatistics.m_statistics;
+
+   throw runtime_error("No statistics of column " + colName + " of table " +
+                       GetFileName() + ", call EnableColumnStatistics() first.");
+}
+
+/// Adds the values of a column in @b numRows rows to @b statistics. @b cell is
+/// the first cell of the column, the rows are @b rowLength bytes apart.
+static void AddValues(const ColStatistics & colStatistics, FitsColStatistics & statistics,
+                      const unsigned char * cell, uint64_t numRows, size_t rowLength)
+{
+   for (uint64_t row = 0; row < numRows; row++, cell += rowLength) {
+
+      if (colStatistics.m_dataTypeIndex == col_string) {
+         // an empty string is the NULL value of a string
+         if (cell[0] == 0)
+            statistics.m_numNull++;
+         else
+            statistics.m_numValues++;
+         continue;
+      }
+
+      for (int bin = 0; bin < colStatistics.m_arraySize; bin++) {
+         const unsigned char * bytes = cell + bin * colStatistics.m_valueSize;
+         if (colStatistics.m_hasNull &&
+             memcmp(bytes, colStatistics.m_nullBytes, colStatistics.m_valueSize) == 0) {
+            statistics.m_numNull++;
+            continue;
+         }
+
+         double value = colStatistics.ValueFct(bytes);
+         if (std::isnan(value)) {
+            statistics.m_numNaN++;
+            continue;
+         }
+
+         if (statistics.m_numValues == 0) {
+            statistics.m_min   = value;
+            statistics.m_max   = value;
+            statistics.m_first = value;
+         }
+         else if (value < statistics.m_min)
+            statistics.m_min = value;
+         else if (value > statistics.m_max)
+            statistics.m_max = value;
+         statistics.m_last = value;
+         statistics.m_sum += value;
+         statistics.m_numValues++;
+      }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::AccumulateStatistics(const unsigned char * rows, uint64_t firstRow,
+                                        uint64_t numRows, size_t rowLength,
+                                        int firstByte, int numBytes)
+{
+   if (rowLength == 0) {
+      rowLength = m_rowLength;
+      numBytes  = m_rowLength;
+   }
+   uint64_t lastRow = firstRow + numRows - 1;
+
+   for (ColStatistics & colStatistics : m_colStatistics) {
+      // only columns with all their bytes in the range
+      if (colStatistics.m_colOffset < firstByte ||
+          colStatistics.m_colOffset + colStatistics.m_arraySize * colStatistics.m_valueSize >
+          firstByte + numBytes)
+         continue;
+
+      if (colStatistics.m_firstRow == 0)
+         colStatistics.m_firstRow = firstRow;
+      else if (colStatistics.m_recompute || firstRow != colStatistics.m_lastRow + 1) {
+         // rows are written again or not in order: the running statistics
+         // cannot be updated, they are computed from the table when needed
+         colStatistics.m_recompute = true;
+         colStatistics.m_firstRow  = min(colStatistics.m_firstRow, firstRow);
+         colStatistics.m_lastRow   = max(colStatistics.m_lastRow, lastRow);
+         continue;
+      }
+      colStatistics.m_lastRow = lastRow;
+
+      AddValues(colStatistics, colStatistics.m_statistics,
+                rows + colStatistics.m_colOffset - firstByte, numRows, rowLength);
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+FitsColStatistics FitsDalTable::ComputeStatistics(const ColStatistics & colStatistics,
+                                                  uint64_t firstRow, uint64_t lastRow) const
+{
+   FitsColStatistics statistics;
+   if (firstRow == 0 || lastRow < firstRow)
+      return statistics;
+
+   uint64_t blockRows = max<uint64_t>(1, COPY_BLOCK_BYTES / m_rowLength);
+   vector<unsigned char> ioBuffer(min(blockRows, lastRow - firstRow + 1) * m_rowLength);
+
+   int status = 0;
+   uint64_t rows;
+   for (uint64_t row = firstRow; row <= lastRow; row += rows) {
+
+      rows = min(blockRows, lastRow - row + 1);
+
+      fits_read_tblbytes(m_fitsFile, row, 1, rows * m_rowLength, ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to read rows " + to_string(row) +
+                             " to " + to_string(row + rows - 1) +
+                             " in table " + GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      AddValues(colStatistics, statistics, ioBuffer.data() + colStatistics.m_colOffset,
+                rows, m_rowLength);
+   }
+
+   return statistics;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <ColDataType TYPE, class T>
+void FitsDalTable::ComputeLimits(const ColStatistics & colStatistics,
+                                 uint64_t firstRow, uint64_t lastRow, T & minValue, T & maxValue) const
+{
+   uint64_t blockRows = max<uint64_t>(1, COPY_BLOCK_BYTES / m_rowLength);
+   vector<unsigned char> ioBuffer(min<uint64_t>(blockRows, lastRow - firstRow + 1) * m_rowLength);
+
+   bool found = false;
+   int status = 0;
+   uint64_t rows;
+   for (uint64_t row = firstRow; row <= lastRow; row += rows) {
+
+      rows = min(blockRows, lastRow - row + 1);
+
+      fits_read_tblbytes(m_fitsFile, row, 1, rows * m_rowLength, ioBuffer.data(), &status);
+      if (status != 0)
+         throw runtime_error("Failed to read rows " + to_string(row) +
+                             " to " + to_string(row + rows - 1) +
+                             " in table " + GetFileName() +
+                             ". cfitsio error: " + to_string(status) );
+
+      const unsigned char * cell = ioBuffer.data() + colStatistics.m_colOffset;
+      for (uint64_t blockRow = 0; blockRow < rows; blockRow++, cell += m_rowLength)
+         for (int bin = 0; bin < colStatistics.m_arraySize; bin++) {
+            const unsigned char * bytes = cell + bin * colStatistics.m_valueSize;
+            if (colStatistics.m_hasNull &&
+                memcmp(bytes, colStatistics.m_nullBytes, colStatistics.m_valueSize) == 0)
+               continue;
+
+            T value;
+            FitsColCodec<TYPE>::Read(&value, bytes, 1);
+            if (!found || value < minValue)
+               minValue = value;
+            if (!found || value > maxValue)
+               maxValue = value;
+            found = true;
+         }
+   }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void FitsDalTable::WriteStatisticsKeywords()
+{
+   for (const ColStatistics & colStatistics : m_colStatistics) {
+      if (!colStatistics.m_writeKeywords || colStatistics.m_firstRow == 0 ||
+          colStatistics.m_dataTypeIndex == col_string)
+         continue;
+
+      // TDMIN and TDMAX are the limits of all rows of the table, they are
+      // read again if the statistics do not include all rows
+      FitsColStatistics statistics;
+      if (!colStatistics.m_recompute && colStatistics.m_firstRow == 1 &&
+          colStatistics.m_lastRow == (uint64_t)m_numWrittenRows)
+         statistics = colStatistics.m_statistics;
+      else
+         statistics = ComputeStatistics(colStatistics, 1, m_numWrittenRows);
+
+      if (statistics.m_numValues == 0)
+         continue;
+
+      const string & colName = colStatistics.m_colName;
+      string colNum = to_string(m_fitsColMetaData.find(colName)->second.m_colNum);
+      string minComment = "minimum of " + colName;
+      string maxComment = "maximum of " + colName;
+
+      // integers with up to 53 significant bits are exact as double
+      const double exactLimit = 9007199254740992.;   // 2^53
+      bool exact = fabs(statistics.m_min) < exactLimit && fabs(statistics.m_max) < exactLimit;
+
+      switch (colStatistics.m_dataTypeIndex) {
+         case col_float:
+         case col_double:
+            SetAttr("TDMIN" + colNum, statistics.m_min, minComment);
+            SetAttr("TDMAX" + colNum, statistics.m_max, maxComment);
+            break;
+
+         case col_uint64: {
+            uint64_t min, max;
+            if (exact) {
+               min = uint64_t(statistics.m_min);
+               max = uint64_t(statistics.m_max);
+            }
+            else
+               ComputeLimits<col_uint64>(colStatistics, 1, m_numWrittenRows, min, max);
+            SetAttr("TDMIN" + colNum, min, minComment);
+            SetAttr("TDMAX" + colNum, max, maxComment);
+            break;
+         }
+
+         default: {
+            // only int64 columns can exceed the exact range of a double
+            int64_t min, max;
+            if (exact) {
+               min = int64_t(statistics.m_min);
+               max = int64_t(statistics.m_max);
+            }
+            else
+               ComputeLimits<col_int64>(colStatistics, 1, m_numWrittenRows, min, max);
+            SetAttr("TDMIN" + colNum, min, minComment);
+            SetAttr("TDMAX" + colNum, max, maxComment);
+            break;
+         }
+      }
+   }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// @brief Returns true if column with column number @b col is an unsigned
 ///        column.
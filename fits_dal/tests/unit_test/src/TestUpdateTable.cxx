@@ -6,6 +6,10 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-031 new test cases WriteReadRows and
+ *                                CopyRows, ConcatenateRows (user-037),
+ *                                ColumnStatistics (user-038) and
+ *                                UpdateColumnsInPlace (user-039)
  *  @version 6.3   2016-10-27 RRO first released version
  *
  */
@@ -15,9 +19,14 @@
 #include "boost/test/unit_test.hpp"
 
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <cmath>
+#include <vector>
 
 #include "ProgramParams.hxx"
 #include "FitsDalTable.hxx"
+#include "FitsDalConcat.hxx"
 
 using namespace boost::unit_test;
 
@@ -99,5 +108,415 @@ BOOST_AUTO_TEST_CASE( UpdateColumns )
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Write and update many rows at once and read them back
+BOOST_AUTO_TEST_CASE( WriteReadRows )
+{
+   unlink("results/testWriteReadRows.fits");
+
+   struct Row {
+      int32_t  m_int;
+      double   m_vec[3];
+      char     m_str[8];
+   };
+
+   std::vector<FitsColBuffer> columns;
+   columns.push_back(FitsColBuffer("COL_INT", col_int32,  1, offsetof(Row, m_int)));
+   columns.push_back(FitsColBuffer("COL_VEC", col_double, 3, offsetof(Row, m_vec)));
+   columns.push_back(FitsColBuffer("COL_STR", col_string, 8, offsetof(Row, m_str)));
+
+   const uint64_t numRows = 10000;
+   std::vector<Row> rows(numRows);
+   for (uint64_t i = 0; i < numRows; i++) {
+      rows[i].m_int = i;
+      for (int bin = 0; bin < 3; bin++)
+         rows[i].m_vec[bin] = i + bin * 0.5;
+      memset(rows[i].m_str, 0, sizeof(rows[i].m_str));
+      snprintf(rows[i].m_str, sizeof(rows[i].m_str), "r%u", (unsigned)(i % 1000));
+   }
+
+   FitsDalTable * table = new FitsDalTable(
+           "results/testWriteReadRows.fits", "CREATE");
+
+   int32_t     colInt;
+   double      colVec[3];
+   std::string colStr;
+   table->Assign("COL_INT", &colInt);
+   table->Assign("COL_VEC", colVec, 3);
+   table->Assign("COL_STR", &colStr, 8);
+
+   table->WriteRows(numRows, columns, rows.data(), sizeof(Row));
+   BOOST_CHECK_EQUAL(table->GetNumRows(), numRows);
+
+   // update COL_INT of rows 11 to 15, the other columns are not modified
+   std::vector<FitsColBuffer> intColumn(1, columns[0]);
+   std::vector<Row> updateRows(5);
+   for (int i = 0; i < 5; i++)
+      updateRows[i].m_int = -1;
+   table->PrepareWriteRow(11);
+   table->WriteRows(5, intColumn, updateRows.data(), sizeof(Row));
+   for (int i = 0; i < 5; i++)
+      rows[10 + i].m_int = -1;
+
+   BOOST_CHECK_EQUAL(table->GetNumRows(), numRows);
+   delete table;
+
+   // read the table again, once with ReadRows() and once row by row
+   table = new FitsDalTable("results/testWriteReadRows.fits");
+   BOOST_CHECK_EQUAL(table->GetNumRows(), numRows);
+
+   std::vector<Row> readRows(numRows + 10);
+   BOOST_CHECK_EQUAL(table->ReadRows(1, numRows + 10, columns, readRows.data(), sizeof(Row)),
+                     numRows);
+
+   table->Assign("COL_INT", &colInt);
+   table->Assign("COL_VEC", colVec, 3);
+   table->Assign("COL_STR", &colStr, 8);
+
+   for (uint64_t i = 0; i < numRows; i++) {
+      BOOST_REQUIRE(table->ReadRow());
+      BOOST_CHECK_EQUAL(readRows[i].m_int, rows[i].m_int);
+      BOOST_CHECK_EQUAL(colInt, rows[i].m_int);
+      for (int bin = 0; bin < 3; bin++) {
+         BOOST_CHECK_EQUAL(readRows[i].m_vec[bin], rows[i].m_vec[bin]);
+         BOOST_CHECK_EQUAL(colVec[bin], rows[i].m_vec[bin]);
+      }
+      BOOST_CHECK_EQUAL(std::string(readRows[i].m_str), std::string(rows[i].m_str));
+      BOOST_CHECK_EQUAL(colStr, std::string(rows[i].m_str));
+   }
+
+   // a part of the table, into a buffer with a not existing column
+   struct SmallRow {
+      int16_t  m_int;
+      float    m_missing;
+   };
+   std::vector<FitsColBuffer> smallColumns;
+   smallColumns.push_back(FitsColBuffer("COL_INT", col_int16, 1, offsetof(SmallRow, m_int)));
+   smallColumns.push_back(FitsColBuffer("MISSING", col_float, 1, offsetof(SmallRow, m_missing)));
+   std::vector<SmallRow> smallRows(3);
+   BOOST_CHECK_EQUAL(table->ReadRows(10, 3, smallColumns, smallRows.data(), sizeof(SmallRow)), 3);
+   BOOST_CHECK_EQUAL(smallRows[0].m_int, 9);
+   BOOST_CHECK_EQUAL(smallRows[1].m_int, -1);
+   BOOST_CHECK_EQUAL(smallRows[2].m_missing, 0.f);
+
+   // a READONLY table cannot be written
+   BOOST_CHECK_THROW(table->WriteRows(1, columns, rows.data(), sizeof(Row)),
+                     std::runtime_error);
+
+   delete table;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Copy the table written by WriteReadRows, once with the same columns and
+// once with other data types and a longer vector column
+BOOST_AUTO_TEST_CASE( CopyRows )
+{
+   unlink("results/testCopyRowsSame.fits");
+   unlink("results/testCopyRowsConvert.fits");
+
+   FitsDalTable * source = new FitsDalTable("results/testWriteReadRows.fits");
+   uint64_t numRows = source->GetNumRows();
+
+   // same columns: the rows are copied as they are
+   int32_t     colInt;
+   double      colVec[4];
+   std::string colStr;
+   FitsDalTable * table = new FitsDalTable("results/testCopyRowsSame.fits", "CREATE");
+   table->Assign("COL_INT", &colInt);
+   table->Assign("COL_VEC", colVec, 3);
+   table->Assign("COL_STR", &colStr, 8);
+   BOOST_CHECK_EQUAL(table->CopyRows(*source), numRows);
+   BOOST_CHECK_EQUAL(table->GetNumRows(), numRows);
+   delete table;
+
+   // other data types, a longer vector column and a column not in the source
+   int64_t     colInt64;
+   float       colMissing;
+   colVec[3] = -99;
+   table = new FitsDalTable("results/testCopyRowsConvert.fits", "CREATE");
+   table->Assign("COL_INT", &colInt64);
+   table->Assign("COL_VEC", colVec, 4);
+   table->Assign("COL_STR", &colStr, 8);
+   table->Assign("MISSING", &colMissing);
+   BOOST_CHECK_EQUAL(table->CopyRows(*source), numRows);
+   delete table;
+
+   // compare both copies with the source, row by row
+   source->Assign("COL_INT", &colInt);
+   source->Assign("COL_VEC", colVec, 3);
+   source->Assign("COL_STR", &colStr, 8);
+
+   int32_t     sameInt;
+   double      sameVec[3];
+   std::string sameStr;
+   FitsDalTable * same = new FitsDalTable("results/testCopyRowsSame.fits");
+   same->Assign("COL_INT", &sameInt);
+   same->Assign("COL_VEC", sameVec, 3);
+   same->Assign("COL_STR", &sameStr, 8);
+
+   double      convertVec[4];
+   std::string convertStr;
+   FitsDalTable * convert = new FitsDalTable("results/testCopyRowsConvert.fits");
+   convert->Assign("COL_INT", &colInt64);
+   convert->Assign("COL_VEC", convertVec, 4);
+   convert->Assign("COL_STR", &convertStr, 8);
+   convert->Assign("MISSING", &colMissing);
+
+   for (uint64_t i = 0; i < numRows; i++) {
+      BOOST_REQUIRE(source->ReadRow());
+      BOOST_REQUIRE(same->ReadRow());
+      BOOST_REQUIRE(convert->ReadRow());
+      BOOST_CHECK_EQUAL(sameInt, colInt);
+      BOOST_CHECK_EQUAL(colInt64, colInt);
+      for (int bin = 0; bin < 3; bin++) {
+         BOOST_CHECK_EQUAL(sameVec[bin], colVec[bin]);
+         BOOST_CHECK_EQUAL(convertVec[bin], colVec[bin]);
+      }
+      BOOST_CHECK_EQUAL(convertVec[3], -99);
+      BOOST_CHECK_EQUAL(sameStr, colStr);
+      BOOST_CHECK_EQUAL(convertStr, colStr);
+      BOOST_CHECK_EQUAL(colMissing, 0.f);
+   }
+
+   delete convert;
+   delete same;
+   delete source;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Writes a table with an OBT_TIME and a VALUE column, used by ConcatenateRows
+static void WriteObtTable(const std::string & fileName, int64_t firstObt, int64_t lastObt)
+{
+   unlink(fileName.c_str());
+   FitsDalTable table(fileName, "CREATE");
+   int64_t obt;
+   double  value;
+   table.Assign("OBT_TIME", &obt);
+   table.Assign("VALUE",    &value);
+   for (obt = firstObt; obt <= lastObt; obt++) {
+      value = obt * 0.5;
+      table.WriteRow();
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Concatenate tables, once without and once with overlapping OBT_TIME
+BOOST_AUTO_TEST_CASE( ConcatenateRows )
+{
+   WriteObtTable("results/testConcatPass1.fits", 1000, 1999);
+   WriteObtTable("results/testConcatPass2.fits", 2000, 2999);
+   WriteObtTable("results/testConcatPass3.fits", 2500, 3499);
+   unlink("results/testConcatSeparate.fits");
+   unlink("results/testConcatOverlap.fits");
+
+   int64_t obt;
+   double  value;
+
+   // the tables do not overlap, the second table is copied first
+   std::vector<std::string> inputFiles;
+   inputFiles.push_back("results/testConcatPass2.fits");
+   inputFiles.push_back("results/testConcatPass1.fits");
+   FitsDalTable * table = new FitsDalTable("results/testConcatSeparate.fits", "CREATE");
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("VALUE",    &value);
+   BOOST_CHECK_EQUAL(ConcatenateTables(*table, inputFiles), 2000);
+   delete table;
+
+   // the rows of the second and third table are merged, the rows from
+   // OBT 2500 to 2999 are in both tables and are copied only once
+   inputFiles.push_back("results/testConcatPass3.fits");
+   table = new FitsDalTable("results/testConcatOverlap.fits", "CREATE");
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("VALUE",    &value);
+   BOOST_CHECK_EQUAL(ConcatenateTables(*table, inputFiles), 2500);
+   BOOST_CHECK_EQUAL(table->GetNumRows(), 2500);
+   delete table;
+
+   table = new FitsDalTable("results/testConcatSeparate.fits");
+   BOOST_CHECK_EQUAL(table->GetNumRows(), 2000);
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("VALUE",    &value);
+   for (int64_t expected = 1000; expected < 3000; expected++) {
+      BOOST_REQUIRE(table->ReadRow());
+      BOOST_CHECK_EQUAL(obt, expected);
+      BOOST_CHECK_EQUAL(value, expected * 0.5);
+   }
+   delete table;
+
+   table = new FitsDalTable("results/testConcatOverlap.fits");
+   BOOST_CHECK_EQUAL(table->GetNumRows(), 2500);
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("VALUE",    &value);
+   for (int64_t expected = 1000; expected < 3500; expected++) {
+      BOOST_REQUIRE(table->ReadRow());
+      BOOST_CHECK_EQUAL(obt, expected);
+      BOOST_CHECK_EQUAL(value, expected * 0.5);
+   }
+   delete table;
+
+   // a table with other columns cannot be concatenated
+   int32_t otherObt;
+   table = new FitsDalTable("results/testConcatOverlap.fits");
+   unlink("results/testConcatOther.fits");
+   FitsDalTable other("results/testConcatOther.fits", "CREATE");
+   other.Assign("OBT_TIME", &otherObt);
+   std::vector<FitsDalTable *> sourceTables(1, table);
+   BOOST_CHECK_THROW(other.ConcatenateRows(sourceTables), std::runtime_error);
+   delete table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Statistics of the columns, computed while the rows are written
+BOOST_AUTO_TEST_CASE( ColumnStatistics )
+{
+   unlink("results/testColumnStatistics.fits");
+
+   FitsDalTable * table = new FitsDalTable("results/testColumnStatistics.fits", "CREATE");
+
+   int32_t     colInt;
+   int32_t     nullInt = -1;
+   double      colVec[2];
+   std::string colStr;
+   table->Assign("COL_INT", &colInt, 1, "", "", &nullInt);
+   table->Assign("COL_VEC", colVec, 2);
+   table->Assign("COL_STR", &colStr, 8);
+   table->EnableColumnStatistics("", true);
+   BOOST_CHECK_THROW(table->EnableColumnStatistics("MISSING"), std::runtime_error);
+
+   for (int row = 0; row < 100; row++) {
+      colInt    = row % 10 == 0 ? -1 : row;
+      colVec[0] = row % 20 == 0 ? NAN : row * 0.5;
+      colVec[1] = -row;
+      colStr    = row % 2 == 0 ? "even" : "";
+      table->WriteRow();
+   }
+
+   FitsColStatistics statistics = table->GetColumnStatistics("COL_INT");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 90);
+   BOOST_CHECK_EQUAL(statistics.m_numNull, 10);
+   BOOST_CHECK_EQUAL(statistics.m_min, 1);
+   BOOST_CHECK_EQUAL(statistics.m_max, 99);
+   BOOST_CHECK_EQUAL(statistics.m_first, 1);
+   BOOST_CHECK_EQUAL(statistics.m_last, 99);
+   BOOST_CHECK_CLOSE(statistics.GetMean(), (4950. - 450.) / 90, 1e-9);
+
+   statistics = table->GetColumnStatistics("COL_VEC");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 195);
+   BOOST_CHECK_EQUAL(statistics.m_numNaN, 5);
+   BOOST_CHECK_EQUAL(statistics.m_min, -99);
+   BOOST_CHECK_EQUAL(statistics.m_max, 49.5);
+   BOOST_CHECK_EQUAL(statistics.m_first, 0);
+   BOOST_CHECK_EQUAL(statistics.m_last, -99);
+
+   statistics = table->GetColumnStatistics("COL_STR");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 50);
+   BOOST_CHECK_EQUAL(statistics.m_numNull, 50);
+
+   // a row written again is included only once, with its new value
+   table->PrepareWriteRow(1);
+   colInt = 500;
+   table->WriteRow();
+   statistics = table->GetColumnStatistics("COL_INT");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 91);
+   BOOST_CHECK_EQUAL(statistics.m_numNull, 9);
+   BOOST_CHECK_EQUAL(statistics.m_max, 500);
+   BOOST_CHECK_EQUAL(statistics.m_first, 500);
+   BOOST_CHECK_EQUAL(statistics.m_last, 99);
+   statistics = table->GetColumnStatistics("COL_VEC");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 195);
+   BOOST_CHECK_EQUAL(statistics.m_numNaN, 5);
+   delete table;
+
+   // the minimum and maximum are written into the header
+   table = new FitsDalTable("results/testColumnStatistics.fits");
+   BOOST_CHECK_THROW(table->GetColumnStatistics("COL_INT"), std::runtime_error);
+   BOOST_CHECK_EQUAL(table->GetAttr<int64_t>("TDMIN1"), 1);
+   BOOST_CHECK_EQUAL(table->GetAttr<int64_t>("TDMAX1"), 500);
+   BOOST_CHECK_EQUAL(table->GetAttr<double>("TDMIN2"), -99);
+   BOOST_CHECK_EQUAL(table->GetAttr<double>("TDMAX2"), 49.5);
+   BOOST_CHECK_THROW(table->GetAttr<double>("TDMIN3"), std::runtime_error);
+   delete table;
+
+   // the keywords include the rows written before the statistics were enabled
+   unlink("results/testColumnStatistics.fits");
+   table = new FitsDalTable("results/testColumnStatistics.fits", "CREATE");
+   table->Assign("COL_INT", &colInt, 1, "", "", &nullInt);
+   for (colInt = 1; colInt <= 10; colInt++)
+      table->WriteRow();
+   table->EnableColumnStatistics("COL_INT", true);
+   for (colInt = 11; colInt <= 20; colInt++)
+      table->WriteRow();
+   statistics = table->GetColumnStatistics("COL_INT");
+   BOOST_CHECK_EQUAL(statistics.m_numValues, 10);
+   BOOST_CHECK_EQUAL(statistics.m_min, 11);
+   delete table;
+
+   table = new FitsDalTable("results/testColumnStatistics.fits");
+   BOOST_CHECK_EQUAL(table->GetAttr<int64_t>("TDMIN1"), 1);
+   BOOST_CHECK_EQUAL(table->GetAttr<int64_t>("TDMAX1"), 20);
+   delete table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Update two columns of existing rows, without changing the other columns
+BOOST_AUTO_TEST_CASE( UpdateColumnsInPlace )
+{
+   unlink("results/testUpdateColumnsInPlace.fits");
+
+   FitsDalTable * table = new FitsDalTable("results/testUpdateColumnsInPlace.fits", "CREATE");
+
+   int32_t  counter;
+   double   time;
+   int16_t  flags[2];
+   table->Assign("COUNTER", &counter);
+   table->Assign("TIME",    &time);
+   table->Assign("FLAGS",   flags, 2);
+
+   for (counter = 0; counter < 10; counter++) {
+      time     = -1;
+      flags[0] = 1;
+      flags[1] = 2;
+      table->WriteRow();
+   }
+
+   // update TIME and the first bin of FLAGS of the rows 3 to 7
+   struct Update {
+      double   m_time;
+      int16_t  m_flag;
+   };
+   std::vector<Update> updates(5);
+   for (size_t i = 0; i < updates.size(); i++) {
+      updates[i].m_time = 1000 + i;
+      updates[i].m_flag = 10 + i;
+   }
+   std::vector<FitsColBuffer> columns;
+   columns.push_back(FitsColBuffer("TIME",  col_double, 1, offsetof(Update, m_time)));
+   columns.push_back(FitsColBuffer("FLAGS", col_int16,  1, offsetof(Update, m_flag)));
+
+   table->UpdateColumns(3, updates.size(), columns, updates.data(), sizeof(Update));
+   BOOST_CHECK_THROW(table->UpdateColumns(8, 5, columns, updates.data(), sizeof(Update)),
+                     std::runtime_error);
+
+   // rows are still appended at the end of the table
+   counter = 10;
+   table->WriteRow();
+   BOOST_CHECK_EQUAL(table->GetNumRows(), 11);
+   delete table;
+
+   table = new FitsDalTable("results/testUpdateColumnsInPlace.fits");
+   table->Assign("COUNTER", &counter);
+   table->Assign("TIME",    &time);
+   table->Assign("FLAGS",   flags, 2);
+   for (int32_t row = 1; row <= 11; row++) {
+      BOOST_REQUIRE(table->ReadRow());
+      BOOST_CHECK_EQUAL(counter, row - 1);
+      bool updated = row >= 3 && row <= 7;
+      BOOST_CHECK_EQUAL(time,     updated ? 1000 + row - 3 : -1);
+      BOOST_CHECK_EQUAL(flags[0], updated ? 10 + row - 3 : 1);
+      BOOST_CHECK_EQUAL(flags[1], 2);
+   }
+   delete table;
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,92 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   Non-owning view of the cell of a vector column, used by the
+ *           generated fits_data_model table classes.
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-034 first released version
+ *
+ */
+
+#ifndef CELL_VIEW_HXX_
+#define CELL_VIEW_HXX_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   Pointer and length of the cell of a vector column.
+ *
+ *  The view refers to the cell buffer of the table object, nothing is
+ *  allocated or copied. It therefore shows the values of the row read last
+ *  and must not be used after the table object is deleted.
+ *
+ *  @code
+ *  for (double limit : refAppLimits->getCellViewUpperLimit())
+ *     sum += limit;
+ *  @endcode
+ *
+ *  @tparam T  the data type of the column, const T for a read-only view.
+ */
+template <typename T>
+class CellView {
+
+ public:
+  typedef T           value_type;
+  typedef T *         iterator;
+  typedef T *         const_iterator;
+  typedef std::size_t size_type;
+
+  CellView() : m_data(nullptr), m_size(0) {}
+  CellView(T * data, std::size_t size) : m_data(data), m_size(size) {}
+
+  /// A view of type T can be used as read-only view of type const T.
+  template <typename U>
+  CellView(const CellView<U> & view) : m_data(view.data()), m_size(view.size()) {}
+
+  T *         data()  const { return m_data; }
+  std::size_t size()  const { return m_size; }
+  bool        empty() const { return m_size == 0; }
+
+  T * begin() const { return m_data; }
+  T * end()   const { return m_data + m_size; }
+
+  T & operator[](std::size_t index) const { return m_data[index]; }
+  T & front() const { return m_data[0]; }
+  T & back()  const { return m_data[m_size - 1]; }
+
+ private:
+  T *         m_data;   ///< first element of the cell
+  std::size_t m_size;   ///< number of elements of the cell
+};
+
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   Copies the values of a container into the cell of a vector column.
+ *
+ *  Only the first @b size values are copied if the container is longer, the
+ *  last values of the cell are not changed if it is shorter.
+ *
+ *  @param [in]  values  any container or array usable with std::begin() and
+ *                       std::end(), for example std::array, std::vector or
+ *                       CellView.
+ *  @param [out] cell    the cell buffer of the column
+ *  @param [in]  size    the number of elements of the cell
+ */
+template <typename Range, typename T>
+void CopyToCell(const Range & values, T * cell, std::size_t size) {
+  auto first = std::begin(values);
+  auto last  = std::end(values);
+  if (static_cast<std::size_t>(std::distance(first, last)) > size)
+    last = std::next(first, size);
+  std::copy(first, last, cell);
+}
+
+#endif /* CELL_VIEW_HXX_ */
@@ -4,6 +4,10 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-034 new name type VIEW_CELL, row
+ *                             layouts of tables: HasRowLayout(),
+ *                             HeaderFile::RowLayout(), SourceFile::RowLayout()
+ *                             (user-035)
  *  @version 10.0.0 2018-08-03 RRO #16271: New methods to create the "copy" -
  *                                         constructor of tables.
  *  @version 6.1   2016-07-14 ABE #11166: New method for writing using
@@ -67,7 +71,8 @@ protected:
   	      CELL,       ///< name is used to define a cell of a table
   	      NULL_V,     ///< name is used to define a NULL variable
   	      SIZE,       ///< name is used to define the bin size of variable
-  	      VECTOR_CELL ///< name is used to define a vector cell of a table
+  	      VECTOR_CELL, ///< name is used to define a vector cell of a table
+  	      VIEW_CELL   ///< name is used to define a view of a vector cell
   	      };
 
 public:
@@ -106,6 +111,18 @@ public:
     *  @brief Returns the function name of a keyword.
     */
 	std::string   FunctionName(const std::string & keyname, NameType nameType);
+
+   /** *************************************************************************
+    *  @brief Returns true if the HDU is a table of which the row layout can
+    *         be defined at compile time.
+    */
+	bool          HasRowLayout();
+
+   /** *************************************************************************
+    *  @brief Returns the array size of a column in the FITS table, i.e. the
+    *         length of a string column or the bin size of a vector column.
+    */
+	int32_t       ColumnArraySize(table_type::column_iterator i_col);
 };
 
 
@@ -189,6 +206,12 @@ public:
     */
 	void ClassBottom();
 
+   /** *************************************************************************
+    *  @brief Writes the row layout of the table and the declaration of the
+    *         functions using it.
+    */
+	void RowLayout();
+
   /** *************************************************************************
     *  @brief Writes the functions to create associated HDUs
     */
@@ -286,6 +309,12 @@ public:
     *  @brief Writes the destructor.
     */
 	void Destructor();
+
+   /** *************************************************************************
+    *  @brief Writes the definition of the row layout and the functions
+    *         converting the rows with it.
+    */
+	void RowLayout();
 };
 
 /** ****************************************************************************
@@ -322,6 +351,21 @@ extern const char * KEYWORD_NATIVE_DATA_TYPE[10];
  */
 extern const char * COLUMN_DATA_TYPE[31];
 
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief The ColDataType of fits_dal of all possible data types of a column
+ */
+extern const char * COLUMN_COL_DATA_TYPE[31];
+
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief Number of bytes of one value in the FITS table of all possible
+ *         data types of a column
+ */
+extern const int32_t COLUMN_FITS_SIZE[31];
+
 
 
 #endif /* FITS_DATA_MODEL_HXX_ */
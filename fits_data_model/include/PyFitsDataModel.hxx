@@ -8,6 +8,9 @@
  *  Contains declarations for classes used to generate Python bindings for
  *  fits_data_model.
  *
+ *  @version 13.2  2026-10-19 agent user-031 Vector columns as numpy arrays,
+ *                                       export table rows as numpy structured
+ *                                       arrays (user-032)
  *  @version 6.4.4 2016-02-03 ABE #12552 Add additional Doxygen documentation
  *                                       for fits header keywords and table columns
  *  @version 6.3   2016-10-24 ABE       Remove OBS_ID and add REQ_ID to the list
@@ -455,6 +458,35 @@ class PyTableWrapper : public PyFitsWrapper  {
    */
   void tableGettersSetters();
 
+  /** **************************************************************************
+   *  @brief Generates the methods that read and write many rows of the table
+   *         as a numpy structured array.
+   */
+  void structuredArrayMethods();
+
+  /** **************************************************************************
+   *  @brief Generates the function that copies a buffer-protocol object into
+   *         a vector column.
+   */
+  void copyBufferFunction();
+
+  /** **************************************************************************
+   *  @brief Generates the getter and setter methods of a vector column of
+   *         numbers, based on numpy arrays.
+   *
+   *  @param [in] i_col the iterator of the table column
+   */
+  void numpyVectorColumn(table_type::column_iterator i_col);
+
+  /** **************************************************************************
+   *  @brief Writes the definition of the method that exports the fits data
+   *         structure class to python.
+   *
+   *  This overridden method initializes numpy, which is used by the methods
+   *  that read and write many rows as numpy structured arrays.
+   */
+  void exportClassToPythonFunction();
+
  public:
 
   /** **************************************************************************
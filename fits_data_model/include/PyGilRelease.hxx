@@ -0,0 +1,89 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   Release of the Python Global Interpreter Lock (GIL) in the
+ *           generated Python bindings.
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-033 first released version
+ *
+ */
+
+#ifndef PYGILRELEASE_HXX_
+#define PYGILRELEASE_HXX_
+
+#include <Python.h>
+
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   Releases the GIL for the lifetime of the object.
+ *
+ *  Used in the generated Python bindings around calls of the C++ methods that
+ *  read or write FITS files, so that other Python threads can run meanwhile.
+ *  No Python object must be accessed while the GIL is released.
+ *
+ *  @code
+ *  {
+ *    PyGilRelease nogil;
+ *    table.ReadRow();
+ *  }
+ *  @endcode
+ */
+class PyGilRelease {
+
+ public:
+  PyGilRelease() : m_state(PyEval_SaveThread()) {}
+  ~PyGilRelease() { PyEval_RestoreThread(m_state); }
+
+  PyGilRelease(const PyGilRelease &) = delete;
+  PyGilRelease & operator=(const PyGilRelease &) = delete;
+
+ private:
+  PyThreadState * m_state;   ///< thread state saved while the GIL is released
+};
+
+
+/** ****************************************************************************
+ *  @ingroup FitsDataModel
+ *
+ *  @brief   First base class of the generated wrapper classes, to release the
+ *           GIL while the FITS file is opened and closed.
+ *
+ *  The GIL is released when this base class is constructed, that is before
+ *  the constructor of the fits_data_model class opens the FITS file. The
+ *  constructor of the wrapper class has to call AcquireGil(). Its destructor
+ *  has to call ReleaseGil(), the GIL is then acquired again after the
+ *  destructor of the fits_data_model class has closed the FITS file.
+ */
+class PyGilReleaseBase {
+
+ protected:
+  PyGilReleaseBase() : m_state(PyEval_SaveThread()) {}
+  ~PyGilReleaseBase() { AcquireGil(); }
+
+  /// Acquires the GIL, if it is released.
+  void AcquireGil() {
+    if (m_state) {
+      PyEval_RestoreThread(m_state);
+      m_state = nullptr;
+    }
+  }
+
+  /// Releases the GIL, if it is held.
+  void ReleaseGil() {
+    if (!m_state)
+      m_state = PyEval_SaveThread();
+  }
+
+  /// Copies of wrapper objects are created with the GIL held.
+  PyGilReleaseBase(const PyGilReleaseBase &) : m_state(nullptr) {}
+  PyGilReleaseBase & operator=(const PyGilReleaseBase &) { return *this; }
+
+ private:
+  PyThreadState * m_state;   ///< thread state saved while the GIL is released
+};
+
+#endif /* PYGILRELEASE_HXX_ */
@@ -5,6 +5,7 @@
   *  @author Reiner Rohlfs UGE
   *
   *
+  *  @version 13.2  2026-10-19 agent user-035 calling RowLayout()
   *  @version 6.1   2016-07-14 ABE #11166: calling UsingDeclarations()
   *  @version 3.0   2015-01-20 RRO #7156:  calling StaticMethods()
   *  @version 1.0   2014-03-29 RRO         first version.
@@ -52,6 +53,8 @@ int main(int argc, char * argv[] )
       headerFile.HeaderGeterSeter();
       if (hdu.table().present())
          headerFile.TableGeterSeter();
+      if (headerFile.HasRowLayout())
+         headerFile.RowLayout();
 
       headerFile.ClassBottom();
       headerFile.Associated_HDUs(fsd->List_of_Associated_HDUs());
@@ -86,6 +89,8 @@ int main(int argc, char * argv[] )
 
 
       sourceFile.Destructor();
+      if (sourceFile.HasRowLayout())
+         sourceFile.RowLayout();
 
    }
    catch (exception & e)
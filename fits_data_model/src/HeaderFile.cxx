@@ -4,6 +4,10 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-034 views of vector cells with
+ *                              getCellView..() and set functions copying from
+ *                              any container, constexpr row layout of tables:
+ *                              RowLayout() (user-035)
  *  @version 12.0  2019-10-23 RRO #19772  Implement the decoding of TC(196,1)
  *  @version 10.0.0 2018-08-02 RRO #16271: For tables: new constructor to copy
  *                                         header keywords and all columns from
@@ -120,6 +124,31 @@ const char * COLUMN_DATA_TYPE[31] {
      "BJD"
 };
 
+/// ColDataType of fits_dal of all possible data types of a column
+const char * COLUMN_COL_DATA_TYPE[31] {
+     "col_string",  "col_string",
+     "col_bool",    "col_bool",
+     "col_int8",    "col_int8",
+     "col_uint8",   "col_uint8",
+     "col_int16",   "col_int16",
+     "col_uint16",  "col_uint16",
+     "col_int32",   "col_int32",   "col_int32",
+     "col_uint32",  "col_uint32",  "col_uint32",
+     "col_int64",   "col_int64",
+     "col_uint64",  "col_uint64",
+     "col_float",   "col_float",
+     "col_double",  "col_double",
+     "col_int64",   "col_int64",    // CUC, OBT
+     "col_string",                  // UTC
+     "col_double",  "col_double"    // MJD, BJD
+};
+
+/// number of bytes of one value in the FITS table of all possible data types of a column
+const int32_t COLUMN_FITS_SIZE[31] {
+     1, 1,  1, 1,  1, 1,  1, 1,  2, 2,  2, 2,  4, 4, 4,  4, 4, 4,
+     8, 8,  8, 8,  4, 4,  8, 8,  8, 8,  1,  8, 8
+};
+
 
 
 /** ****************************************************************************
@@ -156,6 +185,10 @@ void HeaderFile::Top()
    fprintf(m_file, " *\n");
    fprintf(m_file, " *  This is an automatically created file. Do not modify it!\n");
    fprintf(m_file, " *\n");
+   fprintf(m_file, " *  @version 13.2 2026-10-19 agent user-034 getCellView..() and set functions\n");
+   fprintf(m_file, " *                                      copying from any container for\n");
+   fprintf(m_file, " *                                      vector columns, constexpr\n");
+   fprintf(m_file, " *                                      ROW_LAYOUT of tables (user-035)\n");
    fprintf(m_file, " *  @version 10.0 2018-08-02 RRO #16271: For tables: new constructor to copy\n");
    fprintf(m_file, " *                                       header keywords and all columns from\n");
    fprintf(m_file, " *                                       an other table.\n");
@@ -184,6 +217,7 @@ void HeaderFile::Top()
    fprintf(m_file, "#include <Bjd.hxx>\n");
    fprintf(m_file, "#include <VisitId.hxx>\n");
    fprintf(m_file, "#include <PassId.hxx>\n");
+   fprintf(m_file, "#include <CellView.hxx>\n");
    fprintf(m_file, "\n");
 	fprintf(m_file, "#include \"FitsDal%s.hxx\"\n", m_hdu.image().present() ? "Image" : "Table");
 	fprintf(m_file, "\n");
@@ -717,6 +751,24 @@ void HeaderFile::TableGeterSeter()
                         varName.c_str() + 2, (uint32_t)(i_col->bin_size()), varName.c_str());
 
         fprintf(m_file, "\n");
+
+        // a third set function copies from any container, without allocation.
+        // It looks like
+        // template <typename Range>
+        // void setName(const Range & name) {CopyToCell(name, m_name, size);}
+        fprintf(m_file, "   /// Set value of FITS table column %s from any container or array\n", i_col->name().c_str());
+        fprintf(m_file, "   template <typename Range>\n");
+        fprintf(m_file,"   void set%s ", functionName.c_str());
+        if (functionName.length() < 16)
+           fprintf(m_file, "%*s", (int32_t)(16 - functionName.length()), " ");
+
+        fprintf(m_file,"(const Range & %s) ", varName.c_str() + 2);
+
+        if (varName.length() < 16)
+           fprintf(m_file, "%*s", (int32_t)(16 - varName.length()), " ");
+
+        fprintf(m_file, "{CopyToCell(%s, %s, %u);}\n",
+                        varName.c_str() + 2, varName.c_str(), (uint32_t)(i_col->bin_size()));
       }
 
       // function to set the NULL value
@@ -825,7 +877,7 @@ void HeaderFile::TableGeterSeter()
                                    i_col->data_type() != column_data_type::string) {
         functionName = FunctionName(i_col->name(), VECTOR_CELL);
 
-        fprintf(m_file, "   /// Get value of FITS table column %s\n", i_col->name().c_str());
+        fprintf(m_file, "   /// Get a copy of FITS table column %s, getCellView..() does not allocate\n", i_col->name().c_str());
         fprintf(m_file, "   std::vector<%s> " , COLUMN_DATA_TYPE[ i_col->data_type() ]);
 
         fprintf(m_file, "get%s() const ", functionName.c_str());
@@ -837,6 +889,26 @@ void HeaderFile::TableGeterSeter()
                         varName.c_str(), (uint32_t)(i_col->bin_size()));
 
         fprintf(m_file, "\n");
+
+        // get functions returning a view of the cell, without allocation.
+        // They look like
+        // CellView<const type> getCellViewName() const { return CellView<const type>(m_cellName, size);}
+        // CellView<type>       getCellViewName()       { return CellView<type>(m_cellName, size);}
+        functionName = FunctionName(i_col->name(), VIEW_CELL);
+
+        for (int isConst = 1; isConst >= 0; isConst--) {
+          string viewType = string("CellView<") + (isConst ? "const " : "") +
+                            COLUMN_DATA_TYPE[ i_col->data_type() ] + ">";
+          fprintf(m_file, "   /// Get a %sview of FITS table column %s\n",
+                          isConst ? "read-only " : "", i_col->name().c_str());
+          fprintf(m_file, "   %-22s get%s() %s", viewType.c_str(), functionName.c_str(),
+                          isConst ? "const " : "      ");
+          if (functionName.length() < 16)
+             fprintf(m_file, "%*s", (int32_t)(16 - functionName.length()), " ");
+
+          fprintf(m_file, "{ return %s(%s, %u); }\n", viewType.c_str(), varName.c_str(),
+                          (uint32_t)(i_col->bin_size()));
+        }
       }
 
       // function to test the data against its NULL value
@@ -953,6 +1025,49 @@ void HeaderFile::TableGeterSeter()
 
 }
 
+///////////////////////////////////////////////////////////////////////////////
+void HeaderFile::RowLayout()
+{
+   fprintf(m_file, "   // Layout of the rows in the FITS table, used to convert the rows\n");
+   fprintf(m_file, "   // without the RdCopy and WrCopy functions of fits_dal.\n\n");
+
+   int32_t numColumns = m_hdu.table().get().column().size();
+   fprintf(m_file, "   /// Number of columns of ROW_LAYOUT\n");
+   fprintf(m_file, "   static constexpr int ROW_LAYOUT_COLUMNS = %d;\n\n", numColumns);
+
+   // the row layout looks like
+   // static constexpr FitsRowLayoutColumn ROW_LAYOUT[2] = {
+   //    FitsRowLayoutColumn("NAME", col_double, 1, 0),
+   //    ...
+   // };
+   fprintf(m_file, "   /// Name, data type, array size and offset of the columns in the FITS table\n");
+   fprintf(m_file, "   static constexpr FitsRowLayoutColumn ROW_LAYOUT[%d] = {\n", numColumns);
+
+   int32_t offset = 0;
+   int32_t colIndex = 0;
+   table_type::column_iterator i_col = m_hdu.table().get().column().begin();
+   table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
+   while (i_col != i_colEnd)
+   {
+      int32_t arraySize = ColumnArraySize(i_col);
+      fprintf(m_file, "      FitsRowLayoutColumn(\"%s\", ", i_col->name().c_str());
+      if (i_col->name().length() < 16)
+         fprintf(m_file, "%*s", (int32_t)(16 - i_col->name().length()), " ");
+      fprintf(m_file, "%-10s, %4d, %6d)%s\n", COLUMN_COL_DATA_TYPE[ i_col->data_type() ],
+                      arraySize, offset, (++colIndex < numColumns) ? "," : "");
+
+      offset += arraySize * COLUMN_FITS_SIZE[ i_col->data_type() ];
+      ++i_col;
+   }
+   fprintf(m_file, "   };\n\n");
+
+   fprintf(m_file, "protected:\n\n");
+   fprintf(m_file, "   /// Copies a row of the FITS table into the column variables\n");
+   fprintf(m_file, "   void DecodeRow(const unsigned char * ioBuffer) override;\n\n");
+   fprintf(m_file, "   /// Copies the column variables into a row of the FITS table\n");
+   fprintf(m_file, "   void EncodeRow(unsigned char * ioBuffer) override;\n\n");
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void HeaderFile::ClassBottom()
 {
@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2   2026-10-19 agent user-047 limit the number of warnings of
+ *                                        identical OBTs
  *  @version 12.1.4 2020-04-22 ABE #21297 Provide length of TM packet to
  *                                        HkPrwFitsTable::addTmPacket()
  *  @version 12.0.2 2020-02-21 RRO #20941 Write warning if a Extended or Default
@@ -33,6 +35,7 @@
 #include <string>
 
 #include "Logger.hxx"
+#include "LogLimiter.hxx"
 #include "Obt.hxx"
 
 #include "CreateFitsFile.hxx"
@@ -53,6 +56,9 @@
 
 using namespace std;
 
+/// limits the warnings of discarded TM packets per HK table
+static LogLimiter s_identicalObtLog(WARN_LEVEL, "TM packets with identical OBT discarded");
+
 ////////////////////////////////////////////////////////////////////////////////
 
 HkPrwFitsTable::HkPrwFitsTable(FitsDalTable * fitsDalTable,
@@ -197,9 +203,10 @@ void HkPrwFitsTable::addTmPacket(const OBT & obt, const int8_t * tmPacketData, u
       // this could happen if the data from the SEM are not updated since the
       // last TM packet. We do not add these data to the table
       writeNextRow = false;
-      logger << warn << "  The OBT " << newObt
-                        << " is identical as in previous TM packet for HK Table "
-                        << m_hkStructName << ". Discarding this TM packet." << endl;
+      if (s_identicalObtLog.allow(m_hkStructName))
+         logger << warn << "  The OBT " << newObt
+                           << " is identical as in previous TM packet for HK Table "
+                           << m_hkStructName << ". Discarding this TM packet." << endl;
    }
    // test that the OBT is increasing
    else if (m_currentObt >= newObt) {
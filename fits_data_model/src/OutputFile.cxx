@@ -4,6 +4,7 @@
 
     @author Reiner Rohlfs UGE
 
+ *  @version 13.2  2026-10-19 agent user-034 function names of views of vector cells
  *  @version 6.0   2016-07-08 ABE #11163: Support vector column size, 
  *                                        setter and getter methods
  *  @version 3.0   2014-12-22 RRO #7054:  Support of NULL values in FITS columns
@@ -109,6 +110,41 @@ string  OutputFile::VariableName(const string & keyname, NameType nameType)
    return variableName;
 }
 
+/** *************************************************************************
+  *  The table needs at least one column. The time columns CUC, OBT, UTC, MJD
+  *  and BJD are supported only as scalar columns.
+  */
+bool OutputFile::HasRowLayout()
+{
+   if (!m_hdu.table().present())
+      return false;
+
+   table_type::column_iterator i_col = m_hdu.table().get().column().begin();
+   table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
+   if (i_col == i_colEnd)
+      return false;
+
+   while (i_col != i_colEnd)
+      {
+      if (i_col->bin_size() > 1 && i_col->data_type() >= column_data_type::CUC)
+         return false;
+      ++i_col;
+      }
+
+   return true;
+}
+
+/** *************************************************************************
+  *  @param [in] i_col  the column as defined in the fsd file.
+  */
+int32_t OutputFile::ColumnArraySize(table_type::column_iterator i_col)
+{
+   if (i_col->data_type() == column_data_type::UTC)
+      return 26;   // UTC is actually a string of length 26
+
+   return (int32_t)(i_col->bin_size());
+}
+
 /** *************************************************************************
   *  The @b keyname is modified to create a valid function name, which
   *  follows the coding guide.
@@ -120,6 +156,7 @@ string  OutputFile::VariableName(const string & keyname, NameType nameType)
   *                        NULL_V: the function name will start with Null
   *                        SIZE: the function name will start with Size
   *                        VECTOR: the function name will start with CellVector
+  *                        VIEW_CELL: the function name will start with CellView
   */
 string  OutputFile::FunctionName(const string & keyname, NameType nameType)
 {
@@ -131,6 +168,7 @@ string  OutputFile::FunctionName(const string & keyname, NameType nameType)
    else if (nameType == NULL_V) { functionName = "Null"; }
    else if (nameType == SIZE)   { functionName = "Size"; }
    else if (nameType == VECTOR_CELL) { functionName = "CellVector"; }
+   else if (nameType == VIEW_CELL)   { functionName = "CellView"; }
 
    bool   newWord = true;
 
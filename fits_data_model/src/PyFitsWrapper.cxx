@@ -5,6 +5,8 @@
  *
  *  @brief   Implementation of calss PyFitsWrapper.
  *
+ *  @version 13.2  2026-10-19 agent user-033 Include PyGilRelease.hxx in the
+ *                                       generated files
  *  @version 9.0.1 2018-01-26 ABE #15340 Change method names for getting units
  *                                       and comments to getUnitOf* and getComOf*
  *  @version 9.0   2018-01-10 ABE #15295 Add support for the new C++ methods
@@ -136,6 +138,7 @@ void PyFitsWrapper::includeFile() {
   fprintf(m_incFile, "#define _%s%s_HXX_\n", FILE_NAME_PREFIX.c_str(), BaseFileName().c_str());
   fprintf(m_incFile, "\n");
   fprintf(m_incFile, "#include <boost/python.hpp>\n");
+  fprintf(m_incFile, "#include \"PyGilRelease.hxx\"\n");
   fprintf(m_incFile, "\n");
   // Include the wrapped FITS class from fits_data_model
   fprintf(m_incFile, "#include \"%s.hxx\"\n\n", BaseFileName().c_str());
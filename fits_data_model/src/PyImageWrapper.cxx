@@ -9,6 +9,8 @@
  *  Defines the methods used to generate Python bindings for a single FITS image
  *  C++ class.
  *
+ *  @version 13.2  2026-10-19 agent user-033 Release the GIL while the FITS
+ *                                       file is opened and closed
  *  @version 6.4.3 2017-01-21 ABE #12526 Export image type float using NPY_FLOAT
  *  @version 5.2   2016-06-07 ABE        Export method
  *                                       FitsDalHeader::WriteCurrentStatus()
@@ -78,16 +80,25 @@ void PyImageWrapper::wrapperClassDeclaration() {
   fprintf(m_incFile, "#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION\n");
   fprintf(m_incFile, "#include <numpy/noprefix.h>\n");
 
-  fprintf(m_incFile, "class %s : public %s {\n\n", m_wrapperClassName.c_str(), ClassName().c_str());
+  // PyGilReleaseBase is the first base class: the GIL is released while the
+  // constructor and the destructor of the image class read and write the image.
+  // The Python list of the axis sizes is converted by a delegating
+  // constructor, before the GIL is released.
+  fprintf(m_incFile, "class %s : private PyGilReleaseBase, public %s {\n\n", m_wrapperClassName.c_str(), ClassName().c_str());
+  fprintf(m_incFile, "  %s(const std::string & filename, const char* mode, const std::vector<long> & axisSize) :\n", m_wrapperClassName.c_str());
+  fprintf(m_incFile, "          %s(filename, mode, axisSize) { AcquireGil(); }\n\n", ClassName().c_str());
+  fprintf(m_incFile, "  static std::vector<long> AxisSize(const boost::python::list &axisSize) {\n");
+  fprintf(m_incFile, "    return {boost::python::len(axisSize) > 0 ? static_cast<int>(boost::python::extract<long>(axisSize[0])) : 0L,\n");
+  fprintf(m_incFile, "            boost::python::len(axisSize) > 1 ? static_cast<int>(boost::python::extract<long>(axisSize[1])) : 0L,\n");
+  fprintf(m_incFile, "            boost::python::len(axisSize) > 2 ? static_cast<int>(boost::python::extract<long>(axisSize[2])) : 0L};\n");
+  fprintf(m_incFile, "  }\n\n");
   fprintf(m_incFile, " public:\n\n");
   fprintf(m_incFile, "  PyObject* m_imageData = nullptr;\n\n");
 
   fprintf(m_incFile, "  %s(const std::string & filename, const char* mode = \"READONLY\", const boost::python::list &axisSize = {}) :\n", m_wrapperClassName.c_str());
-  fprintf(m_incFile, "          %s(filename, mode, \n", ClassName().c_str());
-  fprintf(m_incFile, "          {boost::python::len(axisSize) > 0 ? static_cast<int>(boost::python::extract<long>(axisSize[0])) : 0L,\n");
-  fprintf(m_incFile, "           boost::python::len(axisSize) > 1 ? static_cast<int>(boost::python::extract<long>(axisSize[1])) : 0L,\n");
-  fprintf(m_incFile, "           boost::python::len(axisSize) > 2 ? static_cast<int>(boost::python::extract<long>(axisSize[2])) : 0L}\n");
-  fprintf(m_incFile, "          ) { }\n\n");
+  fprintf(m_incFile, "          %s(filename, mode, AxisSize(axisSize)) { }\n\n", m_wrapperClassName.c_str());
+  fprintf(m_incFile, "  ~%s() { ReleaseGil(); }\n\n", m_wrapperClassName.c_str());
+  fprintf(m_incFile, "  void WriteCurrentStatus(const std::string & filename) { PyGilRelease nogil; %s::WriteCurrentStatus(filename); }\n\n", ClassName().c_str());
 
   fprintf(m_incFile, "  %s GetItemDirectIndex(long index) {\n", dataTypeStr);
   fprintf(m_incFile, "    if (index < 0 || index >= m_numData) {\n");
@@ -317,6 +328,13 @@ void PyImageWrapper::constructorDoc() {
   fprintf(m_docFile, "   *                 Parameter is used only if @b mode is either\n");
   fprintf(m_docFile, "   *                 CREATE or APPEND.\n");
   AxisSizeDocumentation(m_docFile, img);
+  fprintf(m_docFile, "   * \n");
+  fprintf(m_docFile, "   * Thread safety: the Python GIL is released while the image is read\n");
+  fprintf(m_docFile, "   * by the constructor and written when the object is deleted, so other\n");
+  fprintf(m_docFile, "   * Python threads can run meanwhile. Different objects can be used in\n");
+  fprintf(m_docFile, "   * different threads at the same time, if they do not access the same\n");
+  fprintf(m_docFile, "   * FITS file. One object must not be used by several threads at the\n");
+  fprintf(m_docFile, "   * same time.\n");
   fprintf(m_docFile, "   */ \n\n");
 }
 
@@ -9,6 +9,16 @@
  *  Defines the methods used to generate Python bindings for a single FITS table
  *  C++ class.
  *
+ *  @version 13.2  2026-10-19 agent user-031 New methods readRows(), readTable(),
+ *                                       writeRows() and getDtype() to
+ *                                       transfer many rows as numpy
+ *                                       structured arrays. Vector columns of
+ *                                       numbers are returned as numpy arrays
+ *                                       that are views of the current row,
+ *                                       their setters copy any buffer-protocol
+ *                                       object at once (user-032). Release the
+ *                                       GIL while the FITS file is opened,
+ *                                       read, written and closed (user-033).
  *  @version 9.3.1 2018-01-26 ABE #16505 Add new C++ method SetReadRow() to
  *                                       Python API
  *  @version 9.0.1 2018-01-26 ABE #15340 Change method names for getting units
@@ -34,6 +44,48 @@
 
 #include "PyFitsDataModel.hxx"
 
+// The following arrays are indexed by the column data type, see COLUMN_DATA_TYPE
+
+/// numpy type of one value of a column in a structured array
+static const char * COLUMN_NUMPY_TYPE[31] = {
+  "S",  "S",  "?",  "?",  "i1", "i1", "u1", "u1", "i2", "i2", "u2",
+  "u2", "i4", "i4", "i4", "u4", "u4", "u4", "i8", "i8", "u8", "u8",
+  "f4", "f4", "f8", "f8", "i8", "i8", "S",  "f8", "f8"};
+
+/// number of bytes of one value of a column in a structured array
+static const int COLUMN_VALUE_SIZE[31] = {
+  1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2,
+  2, 4, 4, 4, 4, 4, 4, 8, 8, 8, 8,
+  4, 4, 8, 8, 8, 8, 1, 8, 8};
+
+/// length of the strings of UTC columns
+static const int UTC_LENGTH = 26;
+
+/// numpy type number of the values of a vector column, nullptr if the values
+/// are not numbers
+static const char * COLUMN_NPY_TYPE[31] = {
+  nullptr,      nullptr,      "NPY_BOOL",   "NPY_BOOL",   "NPY_INT8",
+  "NPY_INT8",   "NPY_UINT8",  "NPY_UINT8",  "NPY_INT16",  "NPY_INT16",
+  "NPY_UINT16", "NPY_UINT16", "NPY_INT32",  "NPY_INT32",  "NPY_INT32",
+  "NPY_UINT32", "NPY_UINT32", "NPY_UINT32", "NPY_INT64",  "NPY_INT64",
+  "NPY_UINT64", "NPY_UINT64", "NPY_FLOAT",  "NPY_FLOAT",  "NPY_DOUBLE",
+  "NPY_DOUBLE", nullptr,      nullptr,      nullptr,      nullptr,
+  nullptr};
+
+/// format characters of the Python buffer protocol that can be copied into a
+/// vector column, if the item size is the size of the column values
+static const char * COLUMN_BUFFER_FORMAT[31] = {
+  "",      "",      "?",     "?",     "bhilq", "bhilq", "BHILQ", "BHILQ",
+  "bhilq", "bhilq", "BHILQ", "BHILQ", "bhilq", "bhilq", "bhilq", "BHILQ",
+  "BHILQ", "BHILQ", "bhilq", "bhilq", "BHILQ", "BHILQ", "fd",    "fd",
+  "fd",    "fd",    "",      "",      "",      "",      ""};
+
+/// Returns true for vector columns of numbers, accessed as numpy arrays
+static bool isNumpyVectorColumn(table_type::column_iterator i_col) {
+
+  return i_col->bin_size() > 1 && COLUMN_NPY_TYPE[ i_col->data_type() ] != nullptr;
+}
+
 
 PyTableWrapper::PyTableWrapper(std::auto_ptr<Fits_schema_type> & fsd, const ParamsPtr progParam,
                   const std::string & schemaFileName,
@@ -44,10 +96,28 @@ PyTableWrapper::PyTableWrapper(std::auto_ptr<Fits_schema_type> & fsd, const Para
 
 void PyTableWrapper::wrapperClassDeclaration() {
 
-  fprintf(m_incFile, "class %s : public %s {\n\n", m_wrapperClassName.c_str(), ClassName().c_str());
+  fprintf(m_incFile, "#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION\n");
+  fprintf(m_incFile, "#include <numpy/noprefix.h>\n");
+
+  // PyGilReleaseBase is the first base class: the GIL is released while the
+  // constructor and the destructor of the table class open and close the file
+  fprintf(m_incFile, "class %s : private PyGilReleaseBase, public %s {\n\n", m_wrapperClassName.c_str(), ClassName().c_str());
   fprintf(m_incFile, " public:\n\n");
   fprintf(m_incFile, "  %s(const std::string & filename, const char* mode = \"READONLY\") :\n", m_wrapperClassName.c_str());
-  fprintf(m_incFile, "          %s(filename, mode) {}\n\n", ClassName().c_str());
+  fprintf(m_incFile, "          %s(filename, mode) { AcquireGil(); }\n\n", ClassName().c_str());
+  fprintf(m_incFile, "  ~%s() { ReleaseGil(); }\n\n", m_wrapperClassName.c_str());
+
+  // the methods that read or write the FITS file release the GIL
+  fprintf(m_incFile, "  bool ReadRow() { PyGilRelease nogil; return %s::ReadRow(); }\n", ClassName().c_str());
+  fprintf(m_incFile, "  bool ReadRow(uint64_t row) { PyGilRelease nogil; return %s::ReadRow(row); }\n", ClassName().c_str());
+  fprintf(m_incFile, "  void WriteRow() { PyGilRelease nogil; %s::WriteRow(); }\n", ClassName().c_str());
+  fprintf(m_incFile, "  void PrepareWriteRow(uint64_t row) { PyGilRelease nogil; %s::PrepareWriteRow(row); }\n", ClassName().c_str());
+  fprintf(m_incFile, "  void WriteCurrentStatus(const std::string & filename) { PyGilRelease nogil; %s::WriteCurrentStatus(filename); }\n\n", ClassName().c_str());
+
+  fprintf(m_incFile, "  boost::python::object getDtype();\n");
+  fprintf(m_incFile, "  boost::python::object readRows(uint64_t firstRow, uint64_t numRows);\n");
+  fprintf(m_incFile, "  boost::python::object readTable();\n");
+  fprintf(m_incFile, "  void writeRows(boost::python::object & rows);\n\n");
 
   table_type::column_iterator i_col = m_hdu.table().get().column().begin();
   table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
@@ -61,8 +131,14 @@ void PyTableWrapper::wrapperClassDeclaration() {
       std::string varName = VariableName(i_col->name(), CELL);
       std::string funcName = FunctionName(i_col->name(), CELL);
 
-      fprintf(m_incFile, "  boost::python::list get%s();\n", funcName.c_str());
-      fprintf(m_incFile, "  void set%s(boost::python::list & %s);\n", funcName.c_str(), varName.c_str() + 2);
+      if (isNumpyVectorColumn(i_col)) {
+        fprintf(m_incFile, "  static PyObject* get%s(boost::python::object & o);\n", funcName.c_str());
+        fprintf(m_incFile, "  void set%s(boost::python::object & %s);\n", funcName.c_str(), varName.c_str() + 2);
+      }
+      else {
+        fprintf(m_incFile, "  boost::python::list get%s();\n", funcName.c_str());
+        fprintf(m_incFile, "  void set%s(boost::python::list & %s);\n", funcName.c_str(), varName.c_str() + 2);
+      }
     }
 
     ++i_col;
@@ -81,9 +157,19 @@ void PyTableWrapper::wrapperClassDefinition() {
   table_type::column_iterator i_col = m_hdu.table().get().column().begin();
   table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
 
+  bool numpyVectorColumns = false;
+  for (i_col = m_hdu.table().get().column().begin(); i_col != i_colEnd; ++i_col)
+    numpyVectorColumns |= isNumpyVectorColumn(i_col);
+  if (numpyVectorColumns)
+    copyBufferFunction();
+
+  i_col = m_hdu.table().get().column().begin();
   while (i_col != i_colEnd) {
-    if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
-        i_col->data_type() != column_data_type::string) {
+    if (isNumpyVectorColumn(i_col)) {
+      numpyVectorColumn(i_col);
+    }
+    else if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
+             i_col->data_type() != column_data_type::string) {
 
       std::string varName = VariableName(i_col->name(), CELL);
       std::string funcName = FunctionName(i_col->name(), CELL);
@@ -109,6 +195,195 @@ void PyTableWrapper::wrapperClassDefinition() {
 
     ++i_col;
   }
+
+  structuredArrayMethods();
+}
+
+
+/** *************************************************************************
+ *  The values of a buffer-protocol object, for example a numpy array, are
+ *  copied with one memcpy if they have the type of the column. Other objects
+ *  are converted value by value, as Python lists.
+ */
+void PyTableWrapper::copyBufferFunction() {
+
+  fprintf(m_srcFile, "namespace {\n\n");
+  fprintf(m_srcFile, "// Copies the values of a buffer-protocol object into a vector cell.\n");
+  fprintf(m_srcFile, "// Returns false if the object is not a contiguous buffer of values of the\n");
+  fprintf(m_srcFile, "// type of the cell.\n");
+  fprintf(m_srcFile, "bool copyBuffer(PyObject * values, void * cell, Py_ssize_t itemSize,\n");
+  fprintf(m_srcFile, "                const char * formats, uint32_t binSize) {\n");
+  fprintf(m_srcFile, "  if (!PyObject_CheckBuffer(values))\n");
+  fprintf(m_srcFile, "    return false;\n");
+  fprintf(m_srcFile, "  Py_buffer view;\n");
+  fprintf(m_srcFile, "  if (PyObject_GetBuffer(values, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0) {\n");
+  fprintf(m_srcFile, "    PyErr_Clear();\n");
+  fprintf(m_srcFile, "    return false;\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "  // only values in the byte order of the machine can be copied\n");
+  fprintf(m_srcFile, "  const uint16_t one = 1;\n");
+  fprintf(m_srcFile, "  const char * format = view.format ? view.format : \"B\";\n");
+  fprintf(m_srcFile, "  if (*format == '@' || *format == '=' ||\n");
+  fprintf(m_srcFile, "      *format == (*(const char *)&one ? '<' : '>'))\n");
+  fprintf(m_srcFile, "    format++;\n");
+  fprintf(m_srcFile, "  if (view.itemsize != itemSize || format[0] == 0 || format[1] != 0 ||\n");
+  fprintf(m_srcFile, "      strchr(formats, format[0]) == nullptr) {\n");
+  fprintf(m_srcFile, "    PyBuffer_Release(&view);\n");
+  fprintf(m_srcFile, "    return false;\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "  if (view.len < itemSize * binSize) {\n");
+  fprintf(m_srcFile, "    PyBuffer_Release(&view);\n");
+  fprintf(m_srcFile, "    PyErr_Format(PyExc_IndexError, \"parameter list is too short (expected %%u elements).\", binSize);\n");
+  fprintf(m_srcFile, "    boost::python::throw_error_already_set();\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "  memcpy(cell, view.buf, itemSize * binSize);\n");
+  fprintf(m_srcFile, "  PyBuffer_Release(&view);\n");
+  fprintf(m_srcFile, "  return true;\n");
+  fprintf(m_srcFile, "}\n\n");
+  fprintf(m_srcFile, "} // namespace\n\n");
+}
+
+
+/** *************************************************************************
+ *  The getter returns a numpy array that is a view of the cell of the
+ *  current row, as PyImageWrapper does for the image data: no value is
+ *  copied and the table object is kept alive as long as the array exists.
+ */
+void PyTableWrapper::numpyVectorColumn(table_type::column_iterator i_col) {
+
+  std::string varName = VariableName(i_col->name(), CELL);
+  std::string funcName = FunctionName(i_col->name(), CELL);
+  uint32_t binSize = (uint32_t)i_col->bin_size();
+  const char * dataType = COLUMN_DATA_TYPE[ i_col->data_type() ];
+
+  fprintf(m_srcFile, "PyObject* %s::get%s(boost::python::object & o) {\n", m_wrapperClassName.c_str(), funcName.c_str());
+  fprintf(m_srcFile, "  %s & self = boost::python::extract<%s&>(o);\n", m_wrapperClassName.c_str(), m_wrapperClassName.c_str());
+  fprintf(m_srcFile, "  npy_intp size = %u;\n", binSize);
+  fprintf(m_srcFile, "  PyArrayObject * values = (PyArrayObject*)PyArray_SimpleNewFromData(1, &size, %s, self.%s);\n",
+          COLUMN_NPY_TYPE[ i_col->data_type() ], varName.c_str());
+  fprintf(m_srcFile, "  Py_INCREF(o.ptr());\n");
+  fprintf(m_srcFile, "  PyArray_SetBaseObject(values, o.ptr());\n");
+  fprintf(m_srcFile, "  return (PyObject*)values;\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "void %s::set%s(boost::python::object & %s) {\n", m_wrapperClassName.c_str(), funcName.c_str(), varName.c_str() + 2);
+  fprintf(m_srcFile, "  if (copyBuffer(%s.ptr(), %s, sizeof(%s), \"%s\", %u))\n",
+          varName.c_str() + 2, varName.c_str(), dataType, COLUMN_BUFFER_FORMAT[ i_col->data_type() ], binSize);
+  fprintf(m_srcFile, "    return;\n");
+  fprintf(m_srcFile, "  if (len(%s) < %u) {\n", varName.c_str() + 2, binSize);
+  fprintf(m_srcFile, "    PyErr_SetString(PyExc_IndexError, \"parameter list is too short (expected %u elements).\");\n", binSize);
+  fprintf(m_srcFile, "    boost::python::throw_error_already_set();\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "  for (int i = 0; i < %u; i++) {\n", binSize);
+  fprintf(m_srcFile, "    %s[i] = boost::python::extract<%s>(%s[i]);\n", varName.c_str(), dataType, varName.c_str() + 2);
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "}\n\n");
+}
+
+
+/** *************************************************************************
+ *  A row of the table is one element of a numpy structured array. The
+ *  layout of the structured array is defined here, at generation time: the
+ *  columns follow each other without padding. The rows are transferred with
+ *  FitsDalTable::ReadRows() and FitsDalTable::WriteRows() directly into and
+ *  from the memory of the numpy array.
+ */
+void PyTableWrapper::structuredArrayMethods() {
+
+  table_type::column_iterator i_col = m_hdu.table().get().column().begin();
+  table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
+
+  fprintf(m_srcFile, "namespace {\n\n");
+
+  fprintf(m_srcFile, "// location of the columns in one element of the structured array\n");
+  fprintf(m_srcFile, "std::vector<FitsColBuffer> bufferColumns() {\n");
+  fprintf(m_srcFile, "  std::vector<FitsColBuffer> columns;\n");
+
+  std::string names, formats, offsets;
+  size_t offset = 0;
+  while (i_col != i_colEnd) {
+
+    int dataType = i_col->data_type();
+    uint32_t binSize = (uint32_t)i_col->bin_size();
+    std::string format;
+    if (dataType == column_data_type::UTC)
+      binSize = UTC_LENGTH;
+    if (COLUMN_NUMPY_TYPE[dataType][0] == 'S')
+      format = "S" + std::to_string(binSize);
+    else if (binSize > 1)
+      format = "(" + std::to_string(binSize) + ",)" + COLUMN_NUMPY_TYPE[dataType];
+    else
+      format = COLUMN_NUMPY_TYPE[dataType];
+
+    fprintf(m_srcFile, "  columns.push_back(FitsColBuffer(\"%s\", %s, %u, %zu));\n",
+            i_col->name().c_str(), COLUMN_COL_DATA_TYPE[dataType], binSize, offset);
+
+    names   += "  names.append(\"" + i_col->name() + "\");\n";
+    formats += "  formats.append(\"" + format + "\");\n";
+    offsets += "  offsets.append(" + std::to_string(offset) + ");\n";
+
+    offset += binSize * COLUMN_VALUE_SIZE[dataType];
+    ++i_col;
+  }
+  fprintf(m_srcFile, "  return columns;\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "// number of bytes of one element of the structured array\n");
+  fprintf(m_srcFile, "const size_t ROW_SIZE = %zu;\n\n", offset);
+
+  fprintf(m_srcFile, "// checks that an array has the layout of the rows of the table\n");
+  fprintf(m_srcFile, "void checkRows(boost::python::object & rows, boost::python::object & dtype) {\n");
+  fprintf(m_srcFile, "  if (!PyArray_Check(rows.ptr()) ||\n");
+  fprintf(m_srcFile, "      !PyArray_EquivTypes(PyArray_DESCR((PyArrayObject*)rows.ptr()), (PyArray_Descr*)dtype.ptr())) {\n");
+  fprintf(m_srcFile, "    PyErr_SetString(PyExc_TypeError, \"a numpy array with the dtype returned by getDtype() is expected.\");\n");
+  fprintf(m_srcFile, "    boost::python::throw_error_already_set();\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "} // namespace\n\n");
+
+  fprintf(m_srcFile, "boost::python::object %s::getDtype() {\n", m_wrapperClassName.c_str());
+  fprintf(m_srcFile, "  boost::python::list names, formats, offsets;\n");
+  fprintf(m_srcFile, "%s%s%s", names.c_str(), formats.c_str(), offsets.c_str());
+  fprintf(m_srcFile, "  boost::python::dict descr;\n");
+  fprintf(m_srcFile, "  descr[\"names\"] = names;\n");
+  fprintf(m_srcFile, "  descr[\"formats\"] = formats;\n");
+  fprintf(m_srcFile, "  descr[\"offsets\"] = offsets;\n");
+  fprintf(m_srcFile, "  descr[\"itemsize\"] = ROW_SIZE;\n");
+  fprintf(m_srcFile, "  return boost::python::import(\"numpy\").attr(\"dtype\")(descr);\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "boost::python::object %s::readRows(uint64_t firstRow, uint64_t numRows) {\n", m_wrapperClassName.c_str());
+  fprintf(m_srcFile, "  if (firstRow == 0)\n");
+  fprintf(m_srcFile, "    firstRow = 1;\n");
+  fprintf(m_srcFile, "  uint64_t tableRows = GetNumRows();\n");
+  fprintf(m_srcFile, "  if (firstRow > tableRows)\n");
+  fprintf(m_srcFile, "    numRows = 0;\n");
+  fprintf(m_srcFile, "  else if (numRows > tableRows - firstRow + 1)\n");
+  fprintf(m_srcFile, "    numRows = tableRows - firstRow + 1;\n");
+  fprintf(m_srcFile, "  boost::python::object rows = boost::python::import(\"numpy\").attr(\"zeros\")(numRows, getDtype());\n");
+  fprintf(m_srcFile, "  if (numRows > 0) {\n");
+  fprintf(m_srcFile, "    void * data = PyArray_DATA((PyArrayObject*)rows.ptr());\n");
+  fprintf(m_srcFile, "    PyGilRelease nogil;\n");
+  fprintf(m_srcFile, "    ReadRows(firstRow, numRows, bufferColumns(), data, ROW_SIZE);\n");
+  fprintf(m_srcFile, "  }\n");
+  fprintf(m_srcFile, "  return rows;\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "boost::python::object %s::readTable() {\n", m_wrapperClassName.c_str());
+  fprintf(m_srcFile, "  return readRows(1, GetNumRows());\n");
+  fprintf(m_srcFile, "}\n\n");
+
+  fprintf(m_srcFile, "void %s::writeRows(boost::python::object & rows) {\n", m_wrapperClassName.c_str());
+  fprintf(m_srcFile, "  boost::python::object dtype = getDtype();\n");
+  fprintf(m_srcFile, "  checkRows(rows, dtype);\n");
+  fprintf(m_srcFile, "  boost::python::object contiguous = boost::python::import(\"numpy\").attr(\"ascontiguousarray\")(rows);\n");
+  fprintf(m_srcFile, "  PyArrayObject * array = (PyArrayObject*)contiguous.ptr();\n");
+  fprintf(m_srcFile, "  uint64_t numRows = PyArray_SIZE(array);\n");
+  fprintf(m_srcFile, "  void * data = PyArray_DATA(array);\n");
+  fprintf(m_srcFile, "  PyGilRelease nogil;\n");
+  fprintf(m_srcFile, "  WriteRows(numRows, bufferColumns(), data, ROW_SIZE);\n");
+  fprintf(m_srcFile, "}\n\n");
 }
 
 
@@ -121,6 +396,13 @@ void PyTableWrapper::constructorDoc() {
   fprintf(m_docFile, "   * \n");
   fprintf(m_docFile, "   * @param filename [string] file to be created / opened \n");
   fprintf(m_docFile, "   * @param mode     [string] can be READONLY, CREATE or APPEND\n");
+  fprintf(m_docFile, "   * \n");
+  fprintf(m_docFile, "   * Thread safety: the Python GIL is released while the table is opened,\n");
+  fprintf(m_docFile, "   * read with readRow() and readRows(), written with writeRow() and\n");
+  fprintf(m_docFile, "   * writeRows() and closed, so other Python threads can run meanwhile.\n");
+  fprintf(m_docFile, "   * Different objects can be used in different threads at the same time,\n");
+  fprintf(m_docFile, "   * if they do not access the same FITS file. One object must not be used\n");
+  fprintf(m_docFile, "   * by several threads at the same time.\n");
   fprintf(m_docFile, "   */ \n\n");
 }
 
@@ -205,10 +487,107 @@ void PyTableWrapper::exportClass() {
   fprintf(m_docFile, "    */\n\n");
   fprintf(m_srcFile, "    .def(\"setReadRow\", (bool (%s::*)(uint64_t))&%s::SetReadRow)\n", m_wrapperClassName.c_str(), m_wrapperClassName.c_str());
 
+  fprintf(m_docFile, "   /** *************************************************************************\n");
+  fprintf(m_docFile, "    *  @fn def getNumRows() \n");
+  fprintf(m_docFile, "    *  @memberof %s \n", ClassName().c_str());
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @brief Returns the number of rows of the table.\n");
+  fprintf(m_docFile, "    */\n\n");
+  fprintf(m_srcFile, "    .def(\"getNumRows\", &%s::GetNumRows)\n", m_wrapperClassName.c_str());
+
+  fprintf(m_docFile, "   /** *************************************************************************\n");
+  fprintf(m_docFile, "    *  @fn def getDtype() \n");
+  fprintf(m_docFile, "    *  @memberof %s \n", ClassName().c_str());
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @brief Returns the numpy dtype of one row of the table.\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  The dtype has one field per column, named as the column. Vector\n");
+  fprintf(m_docFile, "    *  columns are sub-arrays, string columns are byte strings.\n");
+  fprintf(m_docFile, "    *  It is the dtype of the arrays returned by readRows() and expected\n");
+  fprintf(m_docFile, "    *  by writeRows().\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @return [numpy.dtype] the structured data type of one row\n");
+  fprintf(m_docFile, "    */\n\n");
+  fprintf(m_srcFile, "    .def(\"getDtype\", &%s::getDtype)\n", m_wrapperClassName.c_str());
+
+  fprintf(m_docFile, "   /** *************************************************************************\n");
+  fprintf(m_docFile, "    *  @fn def readRows(firstRow, numRows) \n");
+  fprintf(m_docFile, "    *  @memberof %s \n", ClassName().c_str());
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @brief Reads many rows of the table into a numpy structured array.\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  The rows are read in large blocks, much faster than with readRow().\n");
+  fprintf(m_docFile, "    *  The current row, accessible with the getCell...() methods, is not\n");
+  fprintf(m_docFile, "    *  modified.\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @param firstRow [int] first row to read. First row in the table is 1.\n");
+  fprintf(m_docFile, "    *  @param numRows  [int] number of rows to read.\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @return [numpy.ndarray] the rows with the dtype of getDtype(). It has\n");
+  fprintf(m_docFile, "    *          less than @b numRows elements if the end of the table is reached.\n");
+  fprintf(m_docFile, "    */\n\n");
+  fprintf(m_srcFile, "    .def(\"readRows\", &%s::readRows)\n", m_wrapperClassName.c_str());
+
+  fprintf(m_docFile, "   /** *************************************************************************\n");
+  fprintf(m_docFile, "    *  @fn def readTable() \n");
+  fprintf(m_docFile, "    *  @memberof %s \n", ClassName().c_str());
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @brief Reads all rows of the table into a numpy structured array, see\n");
+  fprintf(m_docFile, "    *         readRows().\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @return [numpy.ndarray] the rows with the dtype of getDtype().\n");
+  fprintf(m_docFile, "    */\n\n");
+  fprintf(m_srcFile, "    .def(\"readTable\", &%s::readTable)\n", m_wrapperClassName.c_str());
+
+  fprintf(m_docFile, "   /** *************************************************************************\n");
+  fprintf(m_docFile, "    *  @fn def writeRows(rows) \n");
+  fprintf(m_docFile, "    *  @memberof %s \n", ClassName().c_str());
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @brief Writes the rows of a numpy structured array into the table.\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  The rows are written like calls of writeRow(), but in large blocks:\n");
+  fprintf(m_docFile, "    *  at the end of the table, or from the row defined by prepareWriteRow().\n");
+  fprintf(m_docFile, "    *  \n");
+  fprintf(m_docFile, "    *  @param rows [numpy.ndarray] one dimensional array with the dtype of\n");
+  fprintf(m_docFile, "    *              getDtype().\n");
+  fprintf(m_docFile, "    */\n\n");
+  fprintf(m_srcFile, "    .def(\"writeRows\", &%s::writeRows)\n", m_wrapperClassName.c_str());
+
   fprintf(m_srcFile, "    ;\n\n");
 }
 
 
+void PyTableWrapper::exportClassToPythonFunction() {
+
+  fprintf(m_srcFile, "// Needed to use Numpy routines\n");
+  fprintf(m_srcFile, "// Note -- import_array() is a macro that behaves differently in Python2.x\n");
+  fprintf(m_srcFile, "// vs. Python 3. See the discussion at:\n");
+  fprintf(m_srcFile, "// https://groups.google.com/d/topic/astropy-dev/6_AesAsCauM/discussion\n");
+
+  fprintf(m_srcFile, "#if (PY_VERSION_HEX < 0x03000000)\n");
+  fprintf(m_srcFile, "void %sinit_numpy(void) {\n", ClassName().c_str());
+  fprintf(m_srcFile, "  import_array();\n");
+  fprintf(m_srcFile, "}\n");
+  fprintf(m_srcFile, "#else\n");
+  fprintf(m_srcFile, "int* %sinit_numpy(void) {\n", ClassName().c_str());
+  fprintf(m_srcFile, "  import_array();\n");
+  fprintf(m_srcFile, "  return NULL;\n");
+  fprintf(m_srcFile, "}\n");
+  fprintf(m_srcFile, "#endif\n\n");
+
+  classDoc();
+  constructorDoc();
+
+  fprintf(m_srcFile, "void export%s() {\n\n", ClassName().c_str());
+
+  fprintf(m_srcFile, "%sinit_numpy();\n\n", ClassName().c_str());
+
+  exportClass();
+
+  fprintf(m_srcFile, "}\n");
+}
+
+
 void PyTableWrapper::tableGettersSetters() {
 
   // Getter methods
@@ -266,8 +645,10 @@ void PyTableWrapper::getterMethod(table_type::column_iterator i_col) {
   std::string functionName = FunctionName(i_col->name(), CELL);
 
   std::string dataType = "";
-  if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
-                               i_col->data_type() != column_data_type::string) {
+  if (isNumpyVectorColumn(i_col)) {
+    dataType = "numpy.ndarray of " + i_col->data_type();
+  } else if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
+                                      i_col->data_type() != column_data_type::string) {
     dataType = "list of " + i_col->data_type();
   } else {
     dataType = i_col->data_type();
@@ -283,6 +664,12 @@ void PyTableWrapper::getterMethod(table_type::column_iterator i_col) {
   columnDescription(i_col);
   fprintf(m_docFile, "    *  \n");
 
+  if (isNumpyVectorColumn(i_col)) {
+    fprintf(m_docFile, "    *  The returned numpy array is a view of the current row, not a copy: its\n");
+    fprintf(m_docFile, "    *  values change with the next call of readRow() and modifying them\n");
+    fprintf(m_docFile, "    *  modifies the values written by writeRow().\n");
+    fprintf(m_docFile, "    *  \n");
+  }
   fprintf(m_docFile, "    *  @return [%s] the value of the current row of column %s.\n", dataType.c_str(), i_col->name().c_str());
   fprintf(m_docFile, "    */\n\n");
 
@@ -369,8 +756,10 @@ void PyTableWrapper::setterMethod(table_type::column_iterator i_col) {
   std::string varName = VariableName(i_col->name(), CELL);
 
   std::string dataType = "";
-  if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
-                               i_col->data_type() != column_data_type::string) {
+  if (isNumpyVectorColumn(i_col)) {
+    dataType = "numpy.ndarray or list of " + i_col->data_type();
+  } else if (i_col->bin_size() > 1 && i_col->data_type() != column_data_type::A &&
+                                      i_col->data_type() != column_data_type::string) {
     dataType = "list of " + i_col->data_type();
   } else {
     dataType = i_col->data_type();
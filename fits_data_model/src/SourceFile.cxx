@@ -4,6 +4,11 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2   2026-10-19 agent user-035 convert the rows of tables with
+ *                                         the constexpr row layout:
+ *                                         RowLayout(), the "copy" - constructor
+ *                                         copies the rows with
+ *                                         FitsDalTable::CopyRows() (user-036)
  *  @version 12.0   2019-10-23 RRO #19772  Implement the decoding of TC(196,1)
  *  @version 10.3   2018-10-26 RRO #17343  Do not copy the header keyword EXT_VER
  *                                         while a new table is created from an
@@ -97,6 +102,9 @@ void SourceFile::Top()
    fprintf(m_file, " *\n");
    fprintf(m_file, " *  This is an automatically created file. Do not modify it!\n");
    fprintf(m_file, " *\n");
+   fprintf(m_file, " *  @version 13.2 2026-10-19 agent user-035 DecodeRow() and EncodeRow() of\n");
+   fprintf(m_file, " *                                      tables, copy the rows of tables with\n");
+   fprintf(m_file, " *                                      CopyRows() (user-036)\n");
    fprintf(m_file, " *  @version 10.0 2018-08-02 RRO #16271: For tables: new constructor to copy\n");
    fprintf(m_file, " *                                       header keywords and all columns from\n");
    fprintf(m_file, " *                                       an other table.\n");
@@ -109,6 +117,8 @@ void SourceFile::Top()
 
    fprintf(m_file, "#include <string>\n");
    fprintf(m_file, "#include <string.h>\n");
+   if (HasRowLayout())
+      fprintf(m_file, "#include \"FitsDalRowLayout.hxx\"\n");
 	fprintf(m_file, "#include \"%s.hxx\"\n\n", BaseFileName().c_str()   );
    fprintf(m_file, "using namespace std;\n\n");
 }
@@ -642,6 +652,9 @@ void SourceFile::TableConstructor()
     }
     fprintf(m_file, "\n");
 
+    if (HasRowLayout())
+       fprintf(m_file, "   UseRowLayout(ROW_LAYOUT, ROW_LAYOUT_COLUMNS);\n\n");
+
     //get the units of the columns
     fprintf(m_file, "   // get the units of all columns.\n");
     i_col = m_hdu.table().get().column().begin();
@@ -771,35 +784,13 @@ void SourceFile::TableCopyConstructor()
 
        fprintf(m_file, ");\n");
 
-
-       // sourceTable->Assign(name, &variable, 1);
-       fprintf(m_file, "   sourceTable->Assign(\"%s\", ", i_col->name().c_str());
-          if (i_col->name().length() < 16)
-               fprintf(m_file, "%*s", (int32_t)(16 - i_col->name().length()), " ");
-
-       if (i_col->bin_size() == 1 || i_col->data_type() == column_data_type::A ||
-                                     i_col->data_type() == column_data_type::string)
-          fprintf(m_file, "& ");
-       else
-          fprintf(m_file, "  ");
-
-       varName = VariableName(i_col->name(), CELL);
-       fprintf(m_file, "%s, " , varName.c_str());
-       if (varName.length() < 16)
-            fprintf(m_file, "%*s", (int32_t)(16 - varName.length()), " ");
-
-       if (i_col->data_type() == column_data_type::UTC) {
-          fprintf(m_file, " 26");  /// UTC is actually a string of length 26
-       }
-       else {
-          fprintf(m_file, "%3u", (uint32_t)(i_col->bin_size()));
-       }
-       fprintf(m_file, ");\n");
-
        ++i_col;
     }
     fprintf(m_file, "\n");
 
+    if (HasRowLayout())
+       fprintf(m_file, "   UseRowLayout(ROW_LAYOUT, ROW_LAYOUT_COLUMNS);\n\n");
+
     //get the units of the columns
     fprintf(m_file, "   // get the units of all columns.\n");
     i_col = m_hdu.table().get().column().begin();
@@ -816,10 +807,9 @@ void SourceFile::TableCopyConstructor()
        ++i_col;
     }
 
-    // copy all rows from the sourceTable to this table
+    // copy all rows from the sourceTable to this table, in blocks
     fprintf(m_file, "\n//  copy all rows from the sourceTable to this table.\n");
-    fprintf(m_file, "   while(sourceTable->ReadRow())\n" );
-    fprintf(m_file, "      WriteRow();\n\n");
+    fprintf(m_file, "   CopyRows(*sourceTable);\n\n");
 
 
     // delete  the source table
@@ -930,6 +920,52 @@ void SourceFile::Destructor()
 }
 
 
+void SourceFile::RowLayout()
+{
+   fprintf(m_file, "\n\n");
+   fprintf(m_file, "constexpr FitsRowLayoutColumn %s::ROW_LAYOUT[];\n", ClassName().c_str());
+
+   // the functions look like
+   // void ClassName::DecodeRow(const unsigned char * ioBuffer)
+   // {
+   //    FitsColCodec<col_double>::Read(&m_cellName, ioBuffer + 0, 1);
+   //    ...
+   // }
+   for (int decode = 1; decode >= 0; decode--) {
+      fprintf(m_file, "\n");
+      if (decode)
+         fprintf(m_file, "void %s::DecodeRow(const unsigned char * ioBuffer)\n", ClassName().c_str());
+      else
+         fprintf(m_file, "void %s::EncodeRow(unsigned char * ioBuffer)\n", ClassName().c_str());
+      fprintf(m_file, "{\n");
+
+      int32_t colIndex = 0;
+      table_type::column_iterator i_col = m_hdu.table().get().column().begin();
+      table_type::column_iterator i_colEnd = m_hdu.table().get().column().end();
+      while (i_col != i_colEnd)
+      {
+         string varName = VariableName(i_col->name(), CELL);
+         if (i_col->bin_size() == 1 || i_col->data_type() == column_data_type::A ||
+                                       i_col->data_type() == column_data_type::string)
+            varName = "&" + varName;
+
+         string column = "ROW_LAYOUT[" + to_string(colIndex) + "]";
+         if (decode)
+            fprintf(m_file, "   FitsColCodec<%s>::Read(%s, ioBuffer + %s.m_offset, %s.m_arraySize);\n",
+                            COLUMN_COL_DATA_TYPE[ i_col->data_type() ], varName.c_str(),
+                            column.c_str(), column.c_str());
+         else
+            fprintf(m_file, "   FitsColCodec<%s>::Write(ioBuffer + %s.m_offset, %s, %s.m_arraySize);\n",
+                            COLUMN_COL_DATA_TYPE[ i_col->data_type() ], column.c_str(),
+                            varName.c_str(), column.c_str());
+
+         ++colIndex;
+         ++i_col;
+      }
+      fprintf(m_file, "}\n");
+   }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 SourceFile::~SourceFile()
 {
@@ -288,6 +288,46 @@ class TestDataModel(unittest.TestCase):
         self.assertEqual(table.getCellUtcTime().getUtc(), rows[0][1].getUtc())
         self.assertEqual(table.getCellMjdTime(), rows[0][2].getMjd())
         
+    def testReadWriteRows(self):
+        tmpTable = RESOURCES + "/" + TMP_TABLE
+        numRows = 1000
+
+        # write all rows at once from a numpy structured array
+        table = fits_data_model.SciRawImagemetadata(tmpTable, "CREATE")
+        rows = numpy.zeros(numRows, dtype=table.getDtype())
+        rows['CE_COUNTER'] = numpy.arange(numRows)
+        rows['MJD_TIME'] = numpy.arange(numRows) * 0.5
+        rows['UTC_TIME'] = fits_data_model.UTC(2020, 1, 1, 1, 1, 1).getUtc()
+        rows['HK_SOURCE'] = b'ce'
+        rows['MARGINS_COMPR'] = numpy.arange(7, dtype=numpy.float32)
+        table.writeRows(rows)
+        self.assertEqual(table.getNumRows(), numRows)
+
+        # an array with another dtype is rejected
+        with self.assertRaises(TypeError):
+            table.writeRows(numpy.zeros(2))
+        del table
+
+        table = fits_data_model.SciRawImagemetadata(tmpTable, "READONLY")
+        readRows = table.readTable()
+        self.assertEqual(len(readRows), numRows)
+        for column in ['CE_COUNTER', 'MJD_TIME', 'UTC_TIME', 'HK_SOURCE', 'MARGINS_COMPR']:
+            numpy.testing.assert_array_equal(readRows[column], rows[column])
+
+        # the same values as read row by row
+        table.readRow(11)
+        self.assertEqual(table.getCellCeCounter(), readRows['CE_COUNTER'][10])
+        self.assertEqual(table.getCellMjdTime(), readRows['MJD_TIME'][10])
+        self.assertEqual(table.getCellUtcTime().getUtc(), readRows['UTC_TIME'][10].decode())
+        self.assertEqual(table.getCellHkSource(), readRows['HK_SOURCE'][10].decode())
+        numpy.testing.assert_array_equal(table.getCellMarginsCompr(), readRows['MARGINS_COMPR'][10])
+
+        # a part of the table, limited by the end of the table
+        part = table.readRows(numRows - 4, 10)
+        self.assertEqual(len(part), 5)
+        numpy.testing.assert_array_equal(part['CE_COUNTER'], rows['CE_COUNTER'][-5:])
+        self.assertEqual(len(table.readRows(numRows + 1, 10)), 0)
+
     def testPrepareWriteRow(self):
         tmpTable = RESOURCES + "/" + TMP_TABLE
         obt = fits_data_model.OBT(1)
@@ -361,14 +401,50 @@ class TestDataModel(unittest.TestCase):
         table.readRow()
         deadQe = table.getCellDeadQe()
         self.assertEqual(len(deadQe), arrayLen)
-        self.assertListEqual(deadQe, [float(i) for i in range(arrayLen)])
+        numpy.testing.assert_array_equal(deadQe, [float(i) for i in range(arrayLen)])
         
         # If we insert an array that is too long, the extra elements will not be
         # stored in the table.
         table.readRow()
         deadQe = table.getCellDeadQe()
         self.assertEqual(len(deadQe), arrayLen)
-        self.assertListEqual(deadQe, [float(i) for i in range(arrayLen)])
+        numpy.testing.assert_array_equal(deadQe, [float(i) for i in range(arrayLen)])
+
+    def testArrayCellNdarray(self):
+        table = fits_data_model.SimTruSubarray(RESOURCES + "/" + TMP_TABLE, "CREATE")
+        arrayLen = table.getSizeDeadQe()
+
+        # the getter returns a view of the current row, not a copy
+        deadQe = table.getCellDeadQe()
+        self.assertIsInstance(deadQe, numpy.ndarray)
+        self.assertEqual(deadQe.shape, (arrayLen,))
+        deadQe[:] = 1.5
+        numpy.testing.assert_array_equal(table.getCellDeadQe(), numpy.full(arrayLen, 1.5))
+        table.writeRow()
+
+        # a numpy array of the column type is copied at once, other types
+        # value by value
+        table.setCellDeadQe(numpy.arange(arrayLen, dtype=deadQe.dtype))
+        numpy.testing.assert_array_equal(deadQe, numpy.arange(arrayLen))
+        table.writeRow()
+        table.setCellDeadQe(numpy.arange(arrayLen, dtype=numpy.int16)[::-1])
+        numpy.testing.assert_array_equal(deadQe, numpy.arange(arrayLen)[::-1])
+        table.writeRow()
+        self.assertRaises(IndexError, table.setCellDeadQe, numpy.zeros(arrayLen - 1, dtype=deadQe.dtype))
+
+        # the view keeps the table alive
+        del table
+        deadQe[0] = 2.0
+        del deadQe
+
+        table = fits_data_model.SimTruSubarray(RESOURCES + "/" + TMP_TABLE, "READONLY")
+        deadQe = table.getCellDeadQe()
+        table.readRow()
+        numpy.testing.assert_array_equal(deadQe, numpy.full(arrayLen, 1.5))
+        table.readRow()
+        numpy.testing.assert_array_equal(deadQe, numpy.arange(arrayLen))
+        table.readRow()
+        numpy.testing.assert_array_equal(deadQe, numpy.arange(arrayLen)[::-1])
 
     def testCellNullValue(self):
         table = fits_data_model.SciRawImagemetadata(RESOURCES + "/" + TMP_TABLE, "CREATE")
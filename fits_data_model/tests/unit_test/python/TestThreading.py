@@ -0,0 +1,98 @@
+import os
+import sys
+import threading
+import time
+import unittest
+
+import numpy
+
+import fits_data_model
+
+RESOURCES = "resources"
+
+NUM_FILES = 4
+NUM_ROWS = 50000
+
+class TestThreading(unittest.TestCase):
+    """ Reads several FITS files concurrently. The GIL is released during the
+        FITS I/O, the threads should scale nearly linearly with the number of
+        files, up to the number of CPUs. """
+
+    def setUp(self):
+        self.fileNames = [RESOURCES + "/tmpThreading{}.fits".format(i) for i in range(NUM_FILES)]
+        for i, fileName in enumerate(self.fileNames):
+            self.removeFile(fileName)
+            table = fits_data_model.SciRawImagemetadata(fileName, "CREATE")
+            rows = numpy.zeros(NUM_ROWS, dtype=table.getDtype())
+            rows['CE_COUNTER'] = numpy.arange(NUM_ROWS) + i
+            table.writeRows(rows)
+            del table
+
+    def tearDown(self):
+        for fileName in self.fileNames:
+            self.removeFile(fileName)
+
+    def removeFile(self, path):
+        if os.path.isfile(path):
+            os.remove(path)
+
+    def readFile(self, index, results):
+        # the file is read in one call, most of the time is spent without the GIL
+        table = fits_data_model.SciRawImagemetadata(self.fileNames[index], "READONLY")
+        rows = table.readTable()
+        results[index] = int(numpy.sum(rows['CE_COUNTER'], dtype=numpy.int64))
+
+    def readFiles(self, numThreads):
+        """ Reads all files with numThreads threads, returns the elapsed time """
+        results = [None] * NUM_FILES
+        start = time.time()
+        for first in range(0, NUM_FILES, numThreads):
+            threads = [threading.Thread(target=self.readFile, args=(index, results))
+                       for index in range(first, min(first + numThreads, NUM_FILES))]
+            for thread in threads:
+                thread.start()
+            for thread in threads:
+                thread.join()
+        elapsed = time.time() - start
+
+        for i in range(NUM_FILES):
+            self.assertEqual(results[i], int(numpy.sum(numpy.arange(NUM_ROWS) + i)))
+        return elapsed
+
+    def testConcurrentRead(self):
+        serial = self.readFiles(1)
+        parallel = self.readFiles(NUM_FILES)
+        print('\nreading {} files of {} rows: 1 thread {:.2f} s, {} threads {:.2f} s, speedup {:.2f}'
+              .format(NUM_FILES, NUM_ROWS, serial, NUM_FILES, parallel, serial / parallel))
+
+    def testOtherThreadRunsDuringRead(self):
+        # A Python thread counts while the main thread reads a whole table in
+        # one call. The switch interval is set so high that the interpreter
+        # does not force a switch of the threads during the test: the counter
+        # can only advance during readTable() if the call releases the GIL.
+        # The counting thread releases the GIL itself with sleep(0), so that
+        # the main thread gets it back as soon as readTable() returns.
+        stop = threading.Event()
+        counter = [0]
+        def count():
+            while not stop.is_set():
+                counter[0] += 1
+                time.sleep(0)
+        table = fits_data_model.SciRawImagemetadata(self.fileNames[0], "READONLY")
+        switchInterval = sys.getswitchinterval()
+        sys.setswitchinterval(100)
+        thread = threading.Thread(target=count)
+        try:
+            thread.start()
+            before = counter[0]
+            rows = table.readTable()
+            after = counter[0]
+        finally:
+            stop.set()
+            thread.join()
+            sys.setswitchinterval(switchInterval)
+        self.assertEqual(len(rows), NUM_ROWS)
+        self.assertGreater(after, before)
+
+if __name__ == "__main__":
+    unittest.main()
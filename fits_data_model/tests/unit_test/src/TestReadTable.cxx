@@ -2,10 +2,12 @@
 #include "boost/test/unit_test.hpp"
 
 #include <string>
+#include <unistd.h>
 
 #include "ProgramParams.hxx"
 
 #include "REF_APP_HkEnumConversion.hxx"
+#include "REF_APP_Limits.hxx"
 
 using namespace boost;
 using namespace boost::unit_test;
@@ -42,6 +44,48 @@ BOOST_AUTO_TEST_CASE( testTableRead )
    delete table;
 }
 
+BOOST_AUTO_TEST_CASE( testRowLayout )
+{
+   std::string fileName = "result/test_row_layout_REF_APP_Limits.fits";
+   unlink(fileName.c_str());
+
+   // write with the row layout
+   RefAppLimits * limits = new RefAppLimits(fileName, "CREATE");
+   BOOST_CHECK(limits->IsRowLayoutUsed());
+   for (int row = 0; row < 3; row++) {
+      double upperLimit[2] = { row + 0.5, row + 1.5 };
+      limits->setCellParamName("PARAM_" + std::to_string(row));
+      limits->setCellStructName(row == 1 ? "" : "STRUCT");
+      limits->setCellActive(row % 2 == 0);
+      limits->setCellUpperLimit(upperLimit);
+      limits->WriteRow();
+   }
+   delete limits;
+
+   // read with the row layout
+   limits = new RefAppLimits(fileName, "READONLY");
+   BOOST_CHECK(limits->IsRowLayoutUsed());
+   for (int row = 0; row < 3; row++) {
+      BOOST_REQUIRE(limits->ReadRow());
+      BOOST_CHECK_EQUAL(limits->getCellParamName(), "PARAM_" + std::to_string(row));
+      BOOST_CHECK_EQUAL(limits->getCellStructName(), row == 1 ? "" : "STRUCT");
+      BOOST_CHECK_EQUAL(limits->getCellActive(), row % 2 == 0);
+      BOOST_CHECK_EQUAL(limits->getCellUpperLimit()[0], row + 0.5);
+      BOOST_CHECK_EQUAL(limits->getCellUpperLimit()[1], row + 1.5);
+   }
+   BOOST_CHECK(!limits->ReadRow());
+
+   // a re-assigned column is copied by the RdCopy functions
+   bool active;
+   limits->ReAssign("ACTIVE", &active);
+   BOOST_CHECK(!limits->IsRowLayoutUsed());
+   limits->ReadRow(2);
+   BOOST_CHECK_EQUAL(active, false);
+   BOOST_CHECK_EQUAL(limits->getCellParamName(), "PARAM_1");
+   BOOST_CHECK_EQUAL(limits->getCellUpperLimit()[1], 2.5);
+   delete limits;
+}
+
 
 
 
@@ -2,6 +2,8 @@
 #include "boost/test/unit_test.hpp"
 
 
+#include <algorithm>
+#include <array>
 #include <string>
 
 #include "ProgramParams.hxx"
@@ -73,5 +75,55 @@ BOOST_AUTO_TEST_CASE( testVectorColumn )
 
 }
 
+BOOST_AUTO_TEST_CASE( testVectorColumnView )
+{
+
+   std::string fileName = "result/test_vector_column_view_REF_APP_Limits.fits";
+   unlink(fileName.c_str());
+
+   RefAppLimits * refAppLimits = new RefAppLimits(fileName, "CREATE");
+   const RefAppLimits * constLimits = refAppLimits;
+
+   // The view refers to the cell, it has the size of the column
+   CellView<const double> upperLimitView = constLimits->getCellViewUpperLimit();
+   BOOST_CHECK_EQUAL( upperLimitView.size(), refAppLimits->getSizeUpperLimit() );
+   BOOST_CHECK_EQUAL( upperLimitView.data(), refAppLimits->getCellUpperLimit() );
+
+   // Set from a std::array of an other type
+   std::array<float, 2> upperLimitArray = {{ 5, 6 }};
+   refAppLimits->setCellVectorUpperLimit(upperLimitArray);
+   BOOST_CHECK_EQUAL( upperLimitView[0], 5 );
+   BOOST_CHECK_EQUAL( upperLimitView[1], 6 );
+
+   // Modify the cell in place
+   for (double & upperLimit : refAppLimits->getCellViewUpperLimit())
+      upperLimit = 7;
+   for (double upperLimit : upperLimitView)
+      BOOST_CHECK_EQUAL( upperLimit, 7 );
+   refAppLimits->WriteRow();
+
+   // Set from a C array that is too long
+   double upperLimitLong[32];
+   std::fill(upperLimitLong, upperLimitLong + 32, 8);
+   refAppLimits->setCellVectorUpperLimit(upperLimitLong);
+   BOOST_CHECK_EQUAL( upperLimitView.back(), 8 );
+   refAppLimits->WriteRow();
+
+   delete refAppLimits;
+
+   // Read the rows back through the view
+   refAppLimits = new RefAppLimits(fileName, "READONLY");
+   upperLimitView = refAppLimits->getCellViewUpperLimit();
+   double expected[2] = { 7, 8 };
+   for (int row = 0; row < 2; row++) {
+      refAppLimits->ReadRow();
+      for (double upperLimit : upperLimitView)
+         BOOST_CHECK_EQUAL( upperLimit, expected[row] );
+   }
+
+   delete refAppLimits;
+
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,110 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup Logger
+ *  @brief Declaration of class AlertDispatcher.
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-048 first version
+ */
+
+#ifndef ALERT_DISPATCHER_HXX_
+#define ALERT_DISPATCHER_HXX_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "EmailAlert.hxx"
+
+/** ****************************************************************************
+ *  @brief Sends the alert emails in a background thread.
+ *  @ingroup Logger
+ *
+ *  post() only appends the alert to a bounded queue, the emails are
+ *  rendered and delivered by a background thread, which is started by the
+ *  first alert. The first alert is sent at once. The alerts posted within
+ *  @b digestPeriod seconds after an email are sent together in one digest
+ *  email at the end of this period.\n
+ *  If the queue is full, alerts are dropped. The digest email reports the
+ *  number of dropped alerts, all alerts are still written to the log.\n
+ *  The destructor sends the queued alerts.
+ */
+class AlertDispatcher {
+
+ private:
+
+  /** An alert waiting in the queue. */
+  struct Alert {
+    std::string m_id;       ///< the alert id
+    std::string m_message;  ///< the alert message
+    std::string m_time;     ///< the time of the alert
+  };
+
+  EmailAlert m_emailAlert;   ///< renders and delivers the emails
+  std::chrono::steady_clock::duration m_digestPeriod; ///< minimum time between two emails
+  size_t m_maxQueueSize;     ///< maximum number of alerts in m_queue
+
+  std::deque<Alert> m_queue;     ///< alerts not yet sent
+  uint64_t m_numDropped = 0;     ///< alerts dropped since the last email
+  uint64_t m_numSent = 0;        ///< number of sent emails
+  bool m_stop = false;           ///< true if the thread shall stop
+  bool m_flush = false;          ///< true if the queue shall be sent at once
+  bool m_sending = false;        ///< true while the thread delivers an email
+  std::mutex m_mutex;            ///< protects the members above
+  std::condition_variable m_cond;  ///< signals a change of the members above
+  std::thread m_thread;          ///< the background thread, started by post()
+
+  /// The background thread
+  void run();
+
+  /// Sends the alerts of @b alerts in one email
+  void send(const std::deque<Alert> & alerts, uint64_t numDropped);
+
+ public:
+
+  /** **************************************************************************
+   *  @param [in] emailAlert    renders and delivers the emails
+   *  @param [in] digestPeriod  minimum time between two emails in seconds
+   *  @param [in] maxQueueSize  maximum number of alerts waiting to be sent
+   */
+  explicit AlertDispatcher(const EmailAlert & emailAlert,
+                           double digestPeriod = 60.,
+                           size_t maxQueueSize = 1000);
+
+  /** **************************************************************************
+   *  @brief Sends the queued alerts and stops the background thread.
+   */
+  ~AlertDispatcher();
+
+  AlertDispatcher(const AlertDispatcher &) = delete;
+  AlertDispatcher & operator = (const AlertDispatcher &) = delete;
+
+  /** **************************************************************************
+   *  @brief Queues an alert, the email is sent by the background thread.
+   *
+   *  Nothing is done if the "to" email of the EmailAlert is empty.
+   *
+   *  @param [in] alertId      the alert id
+   *  @param [in] alertMessage the alert message
+   *  @return false if the alert was dropped because the queue is full
+   */
+  bool post(const std::string & alertId, const std::string & alertMessage);
+
+  /** **************************************************************************
+   *  @brief Sends the queued alerts at once and waits until they are sent.
+   */
+  void flush();
+
+  /** **************************************************************************
+   *  @brief Returns the number of emails sent so far.
+   */
+  uint64_t getNumSent();
+
+};
+
+#endif /* ALERT_DISPATCHER_HXX_ */
@@ -5,6 +5,11 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2   2026-10-19 agent user-045 asynchronous log modes with a
+ *                                        bounded queue and a background
+ *                                        writer, isEnabled() checks the log
+ *                                        level before a log entry is formatted
+ *                                        (user-046)
  *  @version 12.1.2 2020-03-23 ABE #20653 take log level into account when 
  *                                        writing to file.
  *  @version  9.0   2018-01-10 ABE #15286 add OBSID to log file name
@@ -22,6 +27,10 @@
 #ifndef BOOST_LOG_HXX_
 #define BOOST_LOG_HXX_
 
+#include <atomic>
+#include <cstdint>
+
+#include <boost/log/sinks/basic_sink_frontend.hpp>
 #include <boost/log/sinks/text_ostream_backend.hpp>
 #include <boost/log/sources/severity_logger.hpp>
 #include <boost/log/utility/setup/console.hpp>
@@ -43,6 +52,20 @@ enum SeverityLevel {
     ERROR_LEVEL     ///< An error occurred, the processor was not able to continue.
 };
 
+/** ****************************************************************************
+ *  @brief Defines how log entries are written to cout, cerr and the log file.
+ *  @ingroup Logger
+ */
+enum LogMode {
+    SYNCHRONOUS_LOG, ///< The log entries are formatted and written by the
+                     ///< thread that creates them.
+    ASYNC_BLOCK_LOG, ///< The log entries are passed through a bounded queue
+                     ///< to a background thread, which formats and writes
+                     ///< them. The creating thread waits if the queue is full.
+    ASYNC_DROP_LOG   ///< As ASYNC_BLOCK_LOG, but the log entry is dropped and
+                     ///< counted if the queue is full.
+};
+
 
 /** ****************************************************************************
  *  @brief This class handles the creation of log entries using the Boost
@@ -54,14 +77,51 @@ class BoostLog {
 
  private:
 
+  /** Base class of the synchronous and of the asynchronous sinks. */
+  typedef sinks::basic_formatting_sink_frontend< char > SinkFrontend;
+
   /** Standard error sink. */
-  static boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > m_cerrSink;
+  static boost::shared_ptr< SinkFrontend > m_cerrSink;
 
   /** Standard output sink. */
-  static boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > m_coutSink;
+  static boost::shared_ptr< SinkFrontend > m_coutSink;
 
   /** File sink. */
-  static boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > m_fileSink;
+  static boost::shared_ptr< SinkFrontend > m_fileSink;
+
+  /** The streams of the sinks, kept to recreate the sinks in setLogMode(). */
+  static boost::shared_ptr< sinks::text_ostream_backend > m_cerrBackend;
+  static boost::shared_ptr< sinks::text_ostream_backend > m_coutBackend;
+  static boost::shared_ptr< sinks::text_ostream_backend > m_fileBackend;
+
+  /** The lowest log levels of the sinks, see setLogLevel() and initFileLogging(). */
+  static SeverityLevel m_stdoutLevel;
+  static SeverityLevel m_stderrLevel;
+  static SeverityLevel m_fileLevel;
+
+  /** The mode of new sinks, see setLogMode(). */
+  static LogMode m_logMode;
+
+  /** Bit n is set if log entries of SeverityLevel n are written by a sink. */
+  static std::atomic<unsigned> m_enabledLevels;
+
+  /** **************************************************************************
+   *  @brief Sets m_enabledLevels from the log levels of the sinks.
+   */
+  static void updateEnabledLevels();
+
+  /** **************************************************************************
+   *  @brief Creates a sink of the current log mode for @b backend and adds
+   *         it to the logging core.
+   */
+  static boost::shared_ptr< SinkFrontend > createSink(
+      const boost::shared_ptr< sinks::text_ostream_backend > & backend);
+
+  /** **************************************************************************
+   *  @brief Removes @b sink from the logging core, after all its log entries
+   *         are written.
+   */
+  static void removeSink(const boost::shared_ptr< SinkFrontend > & sink);
 
   /** **************************************************************************
    *  @brief The Boost logger object used for creating log entries.
@@ -134,6 +194,62 @@ class BoostLog {
                           SeverityLevel stderrLevel);
 
 
+  /** **************************************************************************
+   *  @brief Returns true if log entries of level @b level are written to
+   *         cout, cerr or a log file.
+   *
+   *  The result depends on the levels passed to setLogLevel() and
+   *  initFileLogging(). It is true for all levels before the logging is
+   *  configured and always true for ALERT, alerts send an email.
+   *
+   *  @param [in] level the log level
+   */
+  static bool isEnabled(SeverityLevel level) {
+    return (m_enabledLevels.load(std::memory_order_relaxed) >> level) & 1u;
+  }
+
+  /** **************************************************************************
+   *  @brief Sets whether log entries are written synchronously or by
+   *         background threads.
+   *
+   *  In the asynchronous modes the thread that creates a log entry only
+   *  passes it to a bounded queue per sink. A background thread per sink
+   *  formats the log entries and writes them. The order of the entries
+   *  of one sink is kept, but entries written to cout and to cerr can
+   *  appear in a different order than they were created.\n
+   *  All queued log entries are written at the end of the program, when
+   *  std::terminate() is called and after every log entry of level ERROR.
+   *  flush() writes them at any other time.\n
+   *  The sinks that exist already are replaced by sinks of the new mode.
+   *  This method must not be called while other threads create log entries.
+   *
+   *  The asynchronous modes reduce the time spent by the creating thread
+   *  only if a CPU core is free for the background threads. On a host with
+   *  one core they are slower than SYNCHRONOUS_LOG, test_log_mode of
+   *  TestLogFile measured there about 1.5 times the time per log entry
+   *  written to a file.
+   *  The first asynchronous sink also installs an atexit() and a
+   *  std::terminate() handler. Measure with the real load before choosing
+   *  an asynchronous mode.
+   *
+   *  @param [in] mode  the log mode, SYNCHRONOUS_LOG by default
+   */
+  static void setLogMode(LogMode mode);
+
+  /** **************************************************************************
+   *  @brief Waits until all queued log entries are written.
+   */
+  static void flush();
+
+  /** **************************************************************************
+   *  @brief Returns the number of log entries dropped since the start of the
+   *         program because the queue of a sink was full in mode
+   *         ASYNC_DROP_LOG.
+   *
+   *  A log entry dropped by several sinks is counted once.
+   */
+  static uint64_t getNumDroppedMessages();
+
 	/** **************************************************************************
 	 *  @brief Creates a log entry.
 	 *
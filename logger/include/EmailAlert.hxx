@@ -5,6 +5,7 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2 2026-10-19 agent user-048 Pluggable transport of the emails.
  *  @version 13.0 2020-09-17 ABE #21949 Show target name in alert emails.
  *  @version 11.3 2019-04-09 ABE #18117 Improved contents of alert emails.
  *  @version  3.3 2015-05-08 ABE        First version.
@@ -14,6 +15,8 @@
 #define ALERTEMAIL_HXX_
 
 #include <stdio.h>
+#include <functional>
+#include <map>
 #include <string>
 #include <string.h>
 
@@ -24,6 +27,17 @@
  */
 class EmailAlert {
 
+ public:
+
+  /** **************************************************************************
+   *  @brief Delivers a rendered email, including its headers. Returns false
+   *         if the email could not be delivered.
+   *
+   *  The arguments are the "from" email and the rendered email.
+   */
+  typedef std::function<bool(const std::string & fromEmail,
+                             const std::string & email)> Transport;
+
  private:
 
   std::string m_toEmail;         ///< The recipient of the alert email.
@@ -57,6 +71,8 @@ class EmailAlert {
   std::string m_postfix = "}}";  ///< The special character sequence that marks
                                  ///< the end of a placeholder in the template.
 
+  Transport m_transport = sendmail; ///< Delivers the rendered emails.
+
  public:
 
 
@@ -250,6 +266,64 @@ class EmailAlert {
       const std::string & alertId,
       const std::string & alertMessage);
 
+  /** **************************************************************************
+   *  @brief Sends an email with the transport of this instance, sendmail by
+   *         default.
+   *
+   *  @param [in] alertId      the alert id
+   *  @param [in] alertMessage the alert message
+   *  @param [in] alertTime    the time of the alert, see currentTime()
+   *  @return true if the email was delivered, false otherwise or if the
+   *          "to" email is empty.
+   */
+  bool send(
+      const std::string & alertId,
+      const std::string & alertMessage,
+      const std::string & alertTime);
+
+  /** **************************************************************************
+   *  @brief Returns the current UTC as used for the alert time.
+   */
+  static std::string currentTime();
+
+  /** **************************************************************************
+   *  @brief The default transport, delivers the email with the sendmail
+   *         program.
+   *
+   *  @param [in] fromEmail the "from" email
+   *  @param [in] email     the email, including its headers
+   *  @return true if the sendmail program could be opened, false otherwise.
+   */
+  static bool sendmail(
+      const std::string & fromEmail,
+      const std::string & email);
+
+  /** **************************************************************************
+   *  @brief Returns a transport that appends the emails to a file instead of
+   *         sending them, for tests.
+   *
+   *  @param [in] fileName the file the emails are appended to
+   */
+  static Transport fileTransport(const std::string & fileName);
+
+  /** **************************************************************************
+   *  @brief Sets the transport that delivers the emails.
+   *
+   *  @param [in] transport the transport, e.g. sendmail() or fileTransport()
+   */
+  void setTransport(const Transport & transport) {
+    m_transport = transport;
+  }
+
+  /** **************************************************************************
+   *  @brief Returns the "to" email, alerts are not sent if it is empty.
+   *
+   *  @return the "to" email.
+   */
+  const std::string& getToEmail() const {
+    return m_toEmail;
+  }
+
   /** **************************************************************************
    *  @brief Sends an email using the sendmail program.
    *
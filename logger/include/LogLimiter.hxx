@@ -0,0 +1,122 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup Logger
+ *  @brief Declaration of class LogLimiter.
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-047 first version
+ */
+
+#ifndef LOG_LIMITER_HXX_
+#define LOG_LIMITER_HXX_
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+#include "BoostLog.hxx"
+
+/** ****************************************************************************
+ *  @brief Limits the number of log entries of one message, for example of
+ *         an anomaly that can be found in every frame of a telemetry pass.
+ *  @ingroup Logger
+ *
+ *  For every key, the first @b first log entries are written, afterwards
+ *  only every @b every-th. The keys distinguish the sources of the message,
+ *  for example the virtual channel or the name of a HK table.\n
+ *  A summary with the number of suppressed log entries per key is written
+ *  at most every @b summaryPeriod seconds, at the next call of allow().
+ *  The total numbers are written by report() and by the destructor.
+ *
+ *  @code
+ *  static LogLimiter s_duplicateObt(WARN_LEVEL, "Identical OBT in HK table");
+ *
+ *  if (s_duplicateObt.allow(tableName)) {
+ *    logger << warn << "The OBT " << obt << " is identical ..." << std::endl;
+ *  }
+ *  @endcode
+ *
+ *  The methods can be called by several threads at the same time.
+ */
+class LogLimiter {
+
+ private:
+
+  /** The counters of one key. */
+  struct Counter {
+    uint64_t m_total = 0;       ///< number of calls of allow()
+    uint64_t m_suppressed = 0;  ///< number of calls of allow() returning false
+    uint64_t m_sinceSummary = 0; ///< suppressed since the last summary
+  };
+
+  SeverityLevel m_level;          ///< the log level of the summaries
+  std::string m_name;             ///< the name of the message in the summaries
+  uint64_t m_first;               ///< number of log entries always written
+  uint64_t m_every;               ///< afterwards every m_every-th is written
+  std::chrono::steady_clock::duration m_summaryPeriod; ///< time between summaries
+  std::chrono::steady_clock::time_point m_lastSummary; ///< time of the last summary
+
+  std::map<std::string, Counter> m_counters;  ///< the counters per key
+  std::mutex m_mutex;                         ///< protects the counters
+
+  /** **************************************************************************
+   *  @brief Writes a summary of the suppressed log entries, the caller has
+   *         locked m_mutex.
+   *
+   *  @param [in] total  true to write the totals, false to write the
+   *                     suppressed log entries since the last summary.
+   */
+  void writeSummary(bool total);
+
+ public:
+
+  /** **************************************************************************
+   *  @param [in] level          the log level of the summaries, normally
+   *                             the level of the limited log entries
+   *  @param [in] name           a short description of the limited message,
+   *                             it is the start of the summaries
+   *  @param [in] first          number of log entries per key that are
+   *                             always written
+   *  @param [in] every          afterwards every @b every-th log entry is
+   *                             written, 0 to write none
+   *  @param [in] summaryPeriod  minimum time between two summaries in
+   *                             seconds
+   */
+  LogLimiter(SeverityLevel level, const std::string & name,
+             uint64_t first = 10, uint64_t every = 1000,
+             double summaryPeriod = 60.);
+
+  /** **************************************************************************
+   *  @brief Calls report().
+   */
+  ~LogLimiter();
+
+  LogLimiter(const LogLimiter &) = delete;
+  LogLimiter & operator = (const LogLimiter &) = delete;
+
+  /** **************************************************************************
+   *  @brief Counts a log entry of @b key and returns true if it shall be
+   *         written.
+   *
+   *  @param [in] key  the source of the log entry, can be empty
+   */
+  bool allow(const std::string & key = "");
+
+  /** **************************************************************************
+   *  @brief Writes the total number of suppressed log entries per key, if
+   *         there are any, and resets the counters.
+   */
+  void report();
+
+  /** **************************************************************************
+   *  @brief Returns the number of suppressed log entries of @b key since
+   *         the last report().
+   */
+  uint64_t getNumSuppressed(const std::string & key = "");
+
+};
+
+#endif /* LOG_LIMITER_HXX_ */
@@ -5,6 +5,10 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2 2026-10-19 agent user-046 Skip the formatting of log entries
+ *                                      of disabled levels, LOG_DEBUG macro.
+ *                                      Alert emails are sent by a background
+ *                                      thread (user-048).
  *  @version 13.0 2020-09-17 ABE #21949 Show target name in alert emails.
  *  @version 11.3 2019-04-09 ABE #18117 Improved contents of alert emails.
  *  @version  9.0 2018-01-10 ABE #15286 Add OBSID to log file name.
@@ -26,10 +30,12 @@
 
 #include <string>
 #include <iostream>
+#include <memory>
 #include <stdint.h>
 
 #include "BoostLog.hxx"
 #include "EmailAlert.hxx"
+#include "AlertDispatcher.hxx"
 
 /** ****************************************************************************
  *  @brief Typedef used for overloading << std::endl.
@@ -90,6 +96,7 @@ class LogMessage {
 
   SeverityLevel m_level;  ///< The log entry's severity level.
   std::string m_message;  ///< The text message of the entry.
+  bool m_enabled;         ///< false if the log entry is not written by any sink
 
   /** **************************************************************************
    *  @brief Constructor for creating an instance with a log level but no
@@ -99,6 +106,7 @@ class LogMessage {
    */
   LogMessage(SeverityLevel level) {
     m_level = level;
+    m_enabled = BoostLog::isEnabled(level);
   }
 
   /**
@@ -110,7 +118,10 @@ class LogMessage {
    */
   LogMessage(SeverityLevel level, const std::string & message) {
     m_level = level;
-    m_message = message;
+    m_enabled = BoostLog::isEnabled(level);
+    if (m_enabled) {
+      m_message = message;
+    }
   }
 
  public:
@@ -148,9 +159,9 @@ class Endline : public LogMessage {
  private:
 
   /**
-   * Object used for sending email alerts.
+   * Object used for sending email alerts in a background thread.
    */
-  static EmailAlert m_emailAlert;
+  static std::unique_ptr<AlertDispatcher> m_alertDispatcher;
 
  public:
 
@@ -181,6 +192,10 @@ class Endline : public LogMessage {
    */
   void processLogMessage() {
 
+    if (!m_enabled) {
+      return;
+    }
+
     if (m_level == ALERT_LEVEL) {
       // Find the index of the space character that separates the alert id and
       // the alert message
@@ -188,20 +203,42 @@ class Endline : public LogMessage {
       if (separatorIndex != std::string::npos) {
         std::string alertId = m_message.substr(0, separatorIndex);
         std::string alertMessage = m_message.substr(separatorIndex+1);
-        m_emailAlert.send(alertId, alertMessage);
+        if (m_alertDispatcher) {
+          m_alertDispatcher->post(alertId, alertMessage);
+        }
       }
     }
 
     BoostLog::log(m_level, m_message);
+
+    // the processor usually stops after an error, no alert shall be lost
+    if (m_level == ERROR_LEVEL) {
+      flushEmailAlerts();
+    }
   }
 
   /** **************************************************************************
    * @brief Sets the object used to send email alerts.
    *
-   * @param [in] emailAlert object used to send email alerts.
+   * The emails are sent by an AlertDispatcher, alerts posted within
+   * @b digestPeriod seconds after an email are sent together in one email.
+   * The alerts queued for the previous EmailAlert are sent before.
+   * The queued alerts are also sent after an ERROR log entry and before
+   * the program is aborted by std::terminate().
+   *
+   * @param [in] emailAlert   object used to send email alerts.
+   * @param [in] digestPeriod minimum time between two alert emails in seconds
+   */
+  static void setEmailAlert(const EmailAlert & emailAlert,
+                            double digestPeriod = 60.);
+
+  /** **************************************************************************
+   * @brief Sends the queued alert emails and waits until they are sent.
    */
-  static void setEmailAlert(const EmailAlert & emailAlert) {
-    m_emailAlert = emailAlert;
+  static void flushEmailAlerts() {
+    if (m_alertDispatcher) {
+      m_alertDispatcher->flush();
+    }
   }
 };
 
@@ -216,6 +253,9 @@ class Endline : public LogMessage {
  *
  *  The class concatenates each input to << to a string until an end of line is
  *  encountered, which triggers the creation of a log record.
+ *  Nothing is concatenated if no sink writes log entries of the level, see
+ *  BoostLog::isEnabled(). The operands are still evaluated, LOG_DEBUG avoids
+ *  this as well.
  */
 class TextMessage : public Endline {
 
@@ -250,7 +290,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const char * msg) {
-    m_message.append(msg);
+    if (m_enabled) {
+      m_message.append(msg);
+    }
     return *this;
   }
 
@@ -262,7 +304,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const std::string & msg) {
-    m_message.append(msg);
+    if (m_enabled) {
+      m_message.append(msg);
+    }
     return *this;
   }
 
@@ -274,7 +318,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const int16_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -286,7 +332,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const int32_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -298,7 +346,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const int64_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -310,7 +360,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const uint16_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -322,7 +374,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const uint32_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -334,7 +388,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const uint64_t number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 
@@ -346,7 +402,9 @@ class TextMessage : public Endline {
    *  @return this instance
    */
   TextMessage & operator << (const double number) {
-    m_message.append(std::to_string(number));
+    if (m_enabled) {
+      m_message.append(std::to_string(number));
+    }
     return *this;
   }
 };
@@ -725,6 +783,30 @@ class Logger {
   */
 extern Logger logger;
 
+/** ****************************************************************************
+ *  @ingroup Logger
+ *  @brief Creates a debug log entry, the operands are only evaluated if
+ *         debug log entries are written.
+ *
+ *  The statement is removed by the compiler if the program is compiled with
+ *  -DNO_DEBUG_LOG.
+ *  @code
+ *  LOG_DEBUG << "packet " << packetNumber << ": " << Dump(packet) << std::endl;
+ *  @endcode
+ */
+#ifdef NO_DEBUG_LOG
+#define LOG_DEBUG if (true) {} else logger << debug
+#else
+#define LOG_DEBUG if (!BoostLog::isEnabled(DEBUG_LEVEL)) {} else logger << debug
+#endif
+
+/** ****************************************************************************
+ *  @ingroup Logger
+ *  @brief Creates an info log entry, the operands are only evaluated if
+ *         info log entries are written.
+ */
+#define LOG_INFO if (!BoostLog::isEnabled(INFO_LEVEL)) {} else logger << info
+
 
 #endif /* LOG_HXX_ */
 
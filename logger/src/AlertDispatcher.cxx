@@ -0,0 +1,140 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup Logger
+ *  @brief Implementation of class AlertDispatcher.
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-048 first version
+ */
+
+#include <iostream>
+
+#include "AlertDispatcher.hxx"
+
+AlertDispatcher::AlertDispatcher(const EmailAlert & emailAlert,
+                                 double digestPeriod,
+                                 size_t maxQueueSize)
+  : m_emailAlert(emailAlert),
+    m_digestPeriod(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                     std::chrono::duration<double>(digestPeriod))),
+    m_maxQueueSize(maxQueueSize) {}
+
+AlertDispatcher::~AlertDispatcher() {
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_cond.notify_all();
+
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+bool AlertDispatcher::post(const std::string & alertId,
+                           const std::string & alertMessage) {
+
+  if (m_emailAlert.getToEmail().empty()) {
+    return true;
+  }
+
+  Alert alert = {alertId, alertMessage, EmailAlert::currentTime()};
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_queue.size() >= m_maxQueueSize) {
+    m_numDropped++;
+    return false;
+  }
+  m_queue.push_back(std::move(alert));
+
+  if (!m_thread.joinable()) {
+    m_thread = std::thread(&AlertDispatcher::run, this);
+  }
+  m_cond.notify_all();
+  return true;
+}
+
+void AlertDispatcher::flush() {
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // the background thread cannot wait for itself, e.g. in std::terminate()
+  if (!m_thread.joinable() || m_thread.get_id() == std::this_thread::get_id()) {
+    return;
+  }
+
+  m_flush = true;
+  m_cond.notify_all();
+  m_cond.wait(lock, [this]() { return m_queue.empty() && !m_sending; });
+  m_flush = false;
+}
+
+uint64_t AlertDispatcher::getNumSent() {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_numSent;
+}
+
+void AlertDispatcher::run() {
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+
+  // the first alert is sent at once
+  std::chrono::steady_clock::time_point lastEmail =
+      std::chrono::steady_clock::now() - m_digestPeriod;
+
+  while (true) {
+    m_cond.wait(lock, [this]() { return m_stop || !m_queue.empty(); });
+    if (m_queue.empty()) {
+      break;
+    }
+
+    // collect the alerts until the end of the digest period
+    m_cond.wait_until(lock, lastEmail + m_digestPeriod,
+                      [this]() { return m_stop || m_flush; });
+
+    std::deque<Alert> alerts;
+    alerts.swap(m_queue);
+    uint64_t numDropped = m_numDropped;
+    m_numDropped = 0;
+    m_sending = true;
+
+    lock.unlock();
+    send(alerts, numDropped);
+    lock.lock();
+
+    m_sending = false;
+    m_numSent++;
+    lastEmail = std::chrono::steady_clock::now();
+    m_cond.notify_all();
+  }
+}
+
+void AlertDispatcher::send(const std::deque<Alert> & alerts,
+                           uint64_t numDropped) {
+
+  std::string alertId = alerts.front().m_id;
+  std::string alertMessage = alerts.front().m_message;
+
+  if (alerts.size() > 1 || numDropped > 0) {
+    // The digest of all alerts. The email template is HTML.
+    uint64_t numAlerts = alerts.size() + numDropped;
+    alertId += " and " + std::to_string(numAlerts - 1) + " more";
+    alertMessage = std::to_string(numAlerts) + " alerts:<br>\n";
+    for (const Alert & alert : alerts) {
+      alertMessage += alert.m_time + " alert " + alert.m_id + ": " +
+                      alert.m_message + "<br>\n";
+    }
+    if (numDropped > 0) {
+      alertMessage += std::to_string(numDropped) +
+                      " further alerts are only written to the log file.";
+    }
+  }
+
+  try {
+    m_emailAlert.send(alertId, alertMessage, alerts.front().m_time);
+  } catch (std::exception & e) {
+    std::cerr << "Failed to send alert email: " << e.what() << std::endl;
+  }
+}
@@ -5,6 +5,12 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2   2026-10-19 agent user-045 asynchronous log modes with a
+ *                                        bounded queue and a background
+ *                                        writer, isEnabled() checks the log
+ *                                        level before a log entry is formatted
+ *                                        (user-046), synchronous log entries
+ *                                        after the exit handler (user-047)
  *  @version 12.1.2 2020-03-23 ABE #20653 take log level into account when
  *                                        writing to file.
  *  @version  9.1   2018-01-15 ABE #15279 use boost::null_deleter to create streams
@@ -22,8 +28,13 @@
  *  @version  1.0   2014-02-25 ABE first version
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <exception>
 #include <ostream>
 #include <fstream>
+#include <vector>
 #include <stdio.h>      /* puts, printf */
 #include <time.h>       /* time_t, struct tm, time, gmtime */
 
@@ -33,6 +44,10 @@
 #include <boost/algorithm/string/predicate.hpp>
 #include <boost/log/support/date_time.hpp>
 #include <boost/log/utility/setup/common_attributes.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/block_on_overflow.hpp>
 // Deprecated since boost 1.55.0 and removed in boost 1.57.0
 //#include <boost/utility/empty_deleter.hpp>	
 #include "BoostLog.hxx"
@@ -50,10 +65,23 @@ BOOST_LOG_ATTRIBUTE_KEYWORD(proc_name, "ProcName", std::string)
 BOOST_LOG_ATTRIBUTE_KEYWORD(proc_version, "ProcVersion", std::string)
 BOOST_LOG_ATTRIBUTE_KEYWORD(process_id, "ProcessID", attrs::current_process_id::value_type)
 BOOST_LOG_ATTRIBUTE_KEYWORD(severity, "Severity", SeverityLevel)
+BOOST_LOG_ATTRIBUTE_KEYWORD(line_id, "LineID", unsigned int)
 
-boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > BoostLog::m_cerrSink;
-boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > BoostLog::m_coutSink;
-boost::shared_ptr< sinks::synchronous_sink< sinks::text_ostream_backend > > BoostLog::m_fileSink;
+boost::shared_ptr< BoostLog::SinkFrontend > BoostLog::m_cerrSink;
+boost::shared_ptr< BoostLog::SinkFrontend > BoostLog::m_coutSink;
+boost::shared_ptr< BoostLog::SinkFrontend > BoostLog::m_fileSink;
+
+boost::shared_ptr< sinks::text_ostream_backend > BoostLog::m_cerrBackend;
+boost::shared_ptr< sinks::text_ostream_backend > BoostLog::m_coutBackend;
+boost::shared_ptr< sinks::text_ostream_backend > BoostLog::m_fileBackend;
+
+SeverityLevel BoostLog::m_stdoutLevel = INFO_LEVEL;
+SeverityLevel BoostLog::m_stderrLevel = PROGRESS_LEVEL;
+SeverityLevel BoostLog::m_fileLevel = DEBUG_LEVEL;
+
+LogMode BoostLog::m_logMode = SYNCHRONOUS_LOG;
+
+std::atomic<unsigned> BoostLog::m_enabledLevels(~0u);
 
 src::severity_logger<SeverityLevel> BoostLog::slg;
 
@@ -79,6 +107,132 @@ inline std::basic_ostream< CharT, TraitsT >& operator<< (
   return strm;
 }
 
+/** ****************************************************************************
+ *  @brief Returns the format of the log entries.
+ */
+static logging::formatter createFormatter() {
+
+  return expr::stream
+      << expr::format_date_time< boost::posix_time::ptime >("TimeStamp", "%Y-%m-%dT%H:%M:%S.%f")
+      << " " << node_name
+      << " " << proc_name
+      << " " << proc_version
+      << " [" << process_id << "]:"
+      << " [" << severity << "] "
+      << expr::message;
+}
+
+/** ****************************************************************************
+ *  @brief Returns the filter of the log file.
+ */
+static logging::filter createFileFilter(SeverityLevel logLevel) {
+
+  return (severity == DEBUG_LEVEL ||
+          severity == INFO_LEVEL ||
+          severity == ALERT_LEVEL ||
+          severity == PROGRESS_LEVEL ||
+          severity == WARN_LEVEL ||
+          severity == ERROR_LEVEL) &&
+         (severity >= logLevel);
+}
+
+/// Maximum number of log entries in the queue of an asynchronous sink
+const std::size_t LOG_QUEUE_SIZE = 8192;
+
+/// true in log mode ASYNC_DROP_LOG
+static std::atomic<bool> s_dropOnOverflow(false);
+
+/// number of log entries dropped in log mode ASYNC_DROP_LOG
+static std::atomic<uint64_t> s_numDropped(0);
+
+/// true if the current thread has dropped a log entry
+static thread_local bool t_hasDropped = false;
+
+/// LineID of the last log entry dropped by the current thread
+static thread_local unsigned int t_lastDroppedLine = 0;
+
+/** ****************************************************************************
+ *  @brief The overflow strategy of the asynchronous sinks. The thread that
+ *         creates a log entry waits until the queue has space in log mode
+ *         ASYNC_BLOCK_LOG, the log entry is dropped and counted in log mode
+ *         ASYNC_DROP_LOG.
+ */
+class CountingOverflow : public sinks::block_on_overflow {
+
+ public:
+
+  template< typename LockT >
+  bool on_overflow(const logging::record_view & rec, LockT & lock) {
+
+    if (s_dropOnOverflow) {
+      // the sinks are called one after the other by the thread creating the
+      // log entry: an entry dropped by several sinks is counted only once
+      logging::value_ref< unsigned int, tag::line_id > lineId = rec[line_id];
+      if (!lineId || !t_hasDropped || lineId.get() != t_lastDroppedLine) {
+        ++s_numDropped;
+      }
+      if (lineId) {
+        t_hasDropped = true;
+        t_lastDroppedLine = lineId.get();
+      }
+      return false;
+    }
+    return sinks::block_on_overflow::on_overflow(rec, lock);
+  }
+};
+
+typedef sinks::synchronous_sink< sinks::text_ostream_backend > SyncSink;
+
+typedef sinks::asynchronous_sink< sinks::text_ostream_backend,
+          sinks::bounded_fifo_queue< LOG_QUEUE_SIZE, CountingOverflow > > AsyncSink;
+
+/// the asynchronous sinks whose background thread is running
+static std::vector< boost::shared_ptr< AsyncSink > > s_asyncSinks;
+
+/// the terminate handler installed before the first asynchronous sink
+static std::terminate_handler s_previousTerminate = nullptr;
+
+/** ****************************************************************************
+ *  @brief Writes all queued log entries, stops the background threads and
+ *         continues synchronously, registered with std::atexit().
+ */
+static void stopAsyncSinks() {
+
+  uint64_t numDropped = s_numDropped;
+  if (numDropped > 0) {
+    s_dropOnOverflow = false;
+    BoostLog::log(WARN_LEVEL, std::to_string(numDropped) +
+                  " log entries have been dropped because the log queue was full");
+  }
+
+  // log entries created later, for example by destructors of static
+  // objects, are written synchronously
+  BoostLog::setLogMode(SYNCHRONOUS_LOG);
+
+  // the order recommended by the boost log documentation
+  for (auto & sink : s_asyncSinks) {
+    logging::core::get()->remove_sink(sink);
+    sink->stop();
+    sink->flush();
+  }
+  s_asyncSinks.clear();
+}
+
+/** ****************************************************************************
+ *  @brief Writes all queued log entries before the program is aborted.
+ */
+static void flushAtTerminate() {
+
+  try {
+    BoostLog::flush();
+  } catch (...) {}
+
+  if (s_previousTerminate != nullptr) {
+    s_previousTerminate();
+  }
+  std::abort();
+}
+
 /** ****************************************************************************
  * @brief Returns the full path to a log file.
  * @brief Constructs the name of a log file from a directory and the program
@@ -211,35 +365,22 @@ void BoostLog::initConsoleLogging(const std::string& procName,
   logging::core::get()->add_global_attribute("ProcName", attrs::constant< std::string >(procName));
   logging::core::get()->add_global_attribute("ProcVersion", attrs::constant< std::string >(procVersion));
 
-  // Define the format of the log entries
-  logging::formatter fmt = expr::stream
-      << expr::format_date_time< boost::posix_time::ptime >("TimeStamp", "%Y-%m-%dT%H:%M:%S.%f")
-      << " " << node_name
-      << " " << proc_name
-      << " " << proc_version
-      << " [" << process_id << "]:"
-      << " [" << severity << "] "
-      << expr::message;
-
-  typedef sinks::synchronous_sink< sinks::text_ostream_backend > text_sink;
-
   // Construct sinks for cout and cerr
-  m_cerrSink = boost::make_shared< text_sink >();
-  m_coutSink = boost::make_shared< text_sink >();
+  m_cerrBackend = boost::make_shared< sinks::text_ostream_backend >();
+  m_coutBackend = boost::make_shared< sinks::text_ostream_backend >();
 
   // We have to provide an empty deleter to avoid destroying the global stream object
   // nb: empty_deleter is deprecated in boost 1.57 and removed in boost 1.59,
   // null_deleter should be used instead.
   // m_cerrSink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::cerr, boost::empty_deleter()));
   // m_coutSink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::cout, boost::empty_deleter()));
-  m_cerrSink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::cerr, boost::null_deleter()));
-  m_coutSink->locked_backend()->add_stream(boost::shared_ptr<std::ostream>(&std::cout, boost::null_deleter()));
+  m_cerrBackend->add_stream(boost::shared_ptr<std::ostream>(&std::cerr, boost::null_deleter()));
+  m_coutBackend->add_stream(boost::shared_ptr<std::ostream>(&std::cout, boost::null_deleter()));
 
-  BoostLog::setLogLevel(INFO_LEVEL, PROGRESS_LEVEL);
+  m_cerrSink = createSink(m_cerrBackend);
+  m_coutSink = createSink(m_coutBackend);
 
-  // Set the log format for cout and cerr
-  m_cerrSink->set_formatter(fmt);
-  m_coutSink->set_formatter(fmt);
+  BoostLog::setLogLevel(INFO_LEVEL, PROGRESS_LEVEL);
 
   logging::core::get()->add_sink(m_cerrSink);
   logging::core::get()->add_sink(m_coutSink);
@@ -271,31 +412,17 @@ std::string BoostLog::initFileLogging(const std::string & procName,
                                            passId,
                                            obsid,
                                            processingChain);
-  typedef sinks::synchronous_sink< sinks::text_ostream_backend > text_sink;
-
-  boost::shared_ptr< text_sink > m_fileSink = boost::make_shared< text_sink >();
-
-  m_fileSink->locked_backend()->add_stream(boost::make_shared< std::ofstream >(
+  m_fileBackend = boost::make_shared< sinks::text_ostream_backend >();
+  m_fileBackend->add_stream(boost::make_shared< std::ofstream >(
       logFileName,
       std::ios_base::app));
 
-  m_fileSink->set_filter( (severity == DEBUG_LEVEL ||
-                           severity == INFO_LEVEL ||
-                           severity == ALERT_LEVEL ||
-                           severity == PROGRESS_LEVEL ||
-                           severity == WARN_LEVEL ||
-                           severity == ERROR_LEVEL) &&
-                          (severity >= logLevel) );
-
-  logging::formatter fmt = expr::stream
-        << expr::format_date_time< boost::posix_time::ptime >("TimeStamp", "%Y-%m-%dT%H:%M:%S.%f")
-        << " " << node_name
-        << " " << proc_name
-        << " " << proc_version
-        << " [" << process_id << "]:"
-        << " [" << severity << "] "
-        << expr::message;
-  m_fileSink->set_formatter(fmt);
+  // A sink of a former call stays in the logging core
+  m_fileSink = createSink(m_fileBackend);
+  m_fileLevel = logLevel;
+  m_fileSink->set_filter(createFileFilter(logLevel));
+
+  updateEnabledLevels();
 
   logging::core::get()->add_sink(m_fileSink);
 
@@ -305,6 +432,10 @@ std::string BoostLog::initFileLogging(const std::string & procName,
 void BoostLog::setLogLevel(SeverityLevel stdoutLevel,
                            SeverityLevel stderrLevel) {
 
+  m_stdoutLevel = stdoutLevel;
+  m_stderrLevel = stderrLevel;
+  updateEnabledLevels();
+
   // Define the log levels that are output to cout
   m_coutSink->set_filter( (severity == DEBUG_LEVEL ||
                            severity == INFO_LEVEL ||
@@ -318,7 +449,106 @@ void BoostLog::setLogLevel(SeverityLevel stdoutLevel,
                           (severity >= stderrLevel) );
 }
 
+void BoostLog::updateEnabledLevels() {
+
+  // the same levels as the filters of the sinks. The sink of the last
+  // call of initFileLogging() is taken for the log file.
+  unsigned enabledLevels = 1u << ALERT_LEVEL;
+  for (unsigned level = DEBUG_LEVEL; level <= ERROR_LEVEL; level++) {
+    bool toStdout = level <= ALERT_LEVEL && level >= m_stdoutLevel;
+    bool toStderr = level >= PROGRESS_LEVEL && level >= m_stderrLevel;
+    bool toFile = m_fileSink && level >= m_fileLevel;
+    if (toStdout || toStderr || toFile) {
+      enabledLevels |= 1u << level;
+    }
+  }
+  m_enabledLevels = enabledLevels;
+}
+
+boost::shared_ptr< BoostLog::SinkFrontend > BoostLog::createSink(
+    const boost::shared_ptr< sinks::text_ostream_backend > & backend) {
+
+  boost::shared_ptr< SinkFrontend > sink;
+  if (m_logMode == SYNCHRONOUS_LOG) {
+    sink = boost::make_shared< SyncSink >(backend);
+  }
+  else {
+    boost::shared_ptr< AsyncSink > asyncSink = boost::make_shared< AsyncSink >(backend);
+    static bool atExitRegistered = false;
+    if (!atExitRegistered) {
+      std::atexit(stopAsyncSinks);
+      s_previousTerminate = std::set_terminate(flushAtTerminate);
+      atExitRegistered = true;
+    }
+    s_asyncSinks.push_back(asyncSink);
+    sink = asyncSink;
+  }
+
+  sink->set_formatter(createFormatter());
+  return sink;
+}
+
+void BoostLog::removeSink(const boost::shared_ptr< SinkFrontend > & sink) {
+
+  if (!sink) {
+    return;
+  }
+
+  logging::core::get()->remove_sink(sink);
+
+  auto asyncSink = std::find(s_asyncSinks.begin(), s_asyncSinks.end(), sink);
+  if (asyncSink != s_asyncSinks.end()) {
+    (*asyncSink)->stop();
+    (*asyncSink)->flush();
+    s_asyncSinks.erase(asyncSink);
+  }
+  else {
+    sink->flush();
+  }
+}
+
+void BoostLog::setLogMode(LogMode mode) {
+
+  s_dropOnOverflow = mode == ASYNC_DROP_LOG;
+  if (mode == m_logMode) {
+    return;
+  }
+  m_logMode = mode;
+
+  if (m_cerrSink) {
+    removeSink(m_cerrSink);
+    removeSink(m_coutSink);
+    m_cerrSink = createSink(m_cerrBackend);
+    m_coutSink = createSink(m_coutBackend);
+    setLogLevel(m_stdoutLevel, m_stderrLevel);
+    logging::core::get()->add_sink(m_cerrSink);
+    logging::core::get()->add_sink(m_coutSink);
+  }
+
+  if (m_fileSink) {
+    removeSink(m_fileSink);
+    m_fileSink = createSink(m_fileBackend);
+    m_fileSink->set_filter(createFileFilter(m_fileLevel));
+    logging::core::get()->add_sink(m_fileSink);
+  }
+}
+
+void BoostLog::flush() {
+
+  logging::core::get()->flush();
+}
+
+uint64_t BoostLog::getNumDroppedMessages() {
+
+  return s_numDropped;
+}
+
 void BoostLog::log(SeverityLevel level, const std::string& message) {
 
 	BOOST_LOG_SEV(slg, level) << message;
+
+	// the processor usually stops after an error, nothing shall be lost
+	if (level == ERROR_LEVEL && m_logMode != SYNCHRONOUS_LOG) {
+	  flush();
+	}
 }
@@ -5,6 +5,7 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2 2026-10-19 agent user-048 Pluggable transport of the emails.
  *  @version 13.0 2020-09-17 ABE #21949 Show target name in alert emails.
  *  @version 11.3 2019-04-09 ABE #18117 Improved contents of alert emails.
  *  @version  9.0 2018-01-11 ABE #15085 Add the -f option to sendmail to force
@@ -186,38 +187,64 @@ bool EmailAlert::send(
     const std::string & alertId,
     const std::string & alertMessage) {
 
+  return send(alertId, alertMessage, currentTime());
+}
+
+bool EmailAlert::send(
+    const std::string & alertId,
+    const std::string & alertMessage,
+    const std::string & alertTime) {
+
+  if (m_toEmail.empty()) {
+    return false;
+  }
+
+  std::map<std::string, std::string> context = getContext(
+      alertId,
+      alertMessage,
+      alertTime);
+  return m_transport(m_fromEmail, render(m_emailTemplate, context));
+}
+
+std::string EmailAlert::currentTime() {
+
+  time_t now = time(0);
+  struct tm tstruct;
+  char buf[80];
+  gmtime_r(&now, &tstruct);
+  strftime(buf, sizeof(buf), "%Y-%m-%dT%X", &tstruct);
+  return std::string(buf);
+}
+
+bool EmailAlert::sendmail(
+    const std::string & fromEmail,
+    const std::string & email) {
+
   bool retval = false;
+  std::string sendmail = "/usr/sbin/sendmail -f " + fromEmail + " -t";
+  FILE *mailpipe = popen(sendmail.c_str(), "w");
 
-  if (!m_toEmail.empty()) {
-    // Get the current time
-    time_t now = time(0);
-    struct tm tstruct;
-    char buf[80];
-    tstruct = *gmtime(&now);
-    strftime(buf, sizeof(buf), "%Y-%m-%dT%X", &tstruct);
-    std::string alertTime = std::string(buf);
-
-    std::map<std::string, std::string> context = getContext(
-        alertId,
-        alertMessage,
-        alertTime);
-    std::string message = render(m_emailTemplate, context);
-    std::string sendmail = "/usr/sbin/sendmail -f " + m_fromEmail + " -t";
-    FILE *mailpipe = popen(sendmail.c_str(), "w");
-
-    if (mailpipe != NULL) {
-      fwrite(message.c_str(), 1, strlen(message.c_str()), mailpipe);
-      fwrite("\n", 1, 1, mailpipe);
-      pclose(mailpipe);
-      retval = true;
-    }
-    else {
-      perror("Failed to invoke sendmail");
-    }
+  if (mailpipe != NULL) {
+    fwrite(email.c_str(), 1, strlen(email.c_str()), mailpipe);
+    fwrite("\n", 1, 1, mailpipe);
+    pclose(mailpipe);
+    retval = true;
+  }
+  else {
+    perror("Failed to invoke sendmail");
   }
   return retval;
 }
 
+EmailAlert::Transport EmailAlert::fileTransport(const std::string & fileName) {
+
+  return [fileName](const std::string &, const std::string & email) {
+    std::ofstream file(fileName, std::ios_base::app);
+    file << email << "\n";
+    return file.good();
+  };
+}
+
 bool EmailAlert::send(
     const std::string & to,
     const std::string & from,
@@ -0,0 +1,120 @@
+/** ****************************************************************************
+ *  @file
+ *  @ingroup Logger
+ *  @brief Implementation of class LogLimiter.
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-047 first version
+ */
+
+#include "LogLimiter.hxx"
+
+/// maximum number of keys listed in one summary
+static const size_t MAX_SUMMARY_KEYS = 10;
+
+LogLimiter::LogLimiter(SeverityLevel level, const std::string & name,
+                       uint64_t first, uint64_t every, double summaryPeriod)
+  : m_level(level), m_name(name), m_first(first), m_every(every),
+    m_summaryPeriod(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                      std::chrono::duration<double>(summaryPeriod))),
+    m_lastSummary(std::chrono::steady_clock::now()) {}
+
+LogLimiter::~LogLimiter() {
+
+  try {
+    report();
+  } catch (...) {}
+}
+
+bool LogLimiter::allow(const std::string & key) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  Counter & counter = m_counters[key];
+  uint64_t index = counter.m_total++;
+
+  bool write = index < m_first ||
+               (m_every != 0 && (index - m_first + 1) % m_every == 0);
+
+  if (!write) {
+    if (counter.m_suppressed == 0) {
+      std::string message = m_name + (key.empty() ? "" : " (" + key + ")") +
+          ": more than " + std::to_string(m_first) + " log entries, ";
+      message += m_every == 0 ? "the following ones are suppressed" :
+          "only every " + std::to_string(m_every) + "th is written";
+      BoostLog::log(m_level, message);
+    }
+    counter.m_suppressed++;
+    counter.m_sinceSummary++;
+  }
+
+  auto now = std::chrono::steady_clock::now();
+  if (now - m_lastSummary >= m_summaryPeriod) {
+    writeSummary(false);
+    m_lastSummary = now;
+  }
+
+  return write;
+}
+
+void LogLimiter::report() {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  writeSummary(true);
+  m_counters.clear();
+  m_lastSummary = std::chrono::steady_clock::now();
+}
+
+uint64_t LogLimiter::getNumSuppressed(const std::string & key) {
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+
+  auto counter = m_counters.find(key);
+  return counter == m_counters.end() ? 0 : counter->second.m_suppressed;
+}
+
+void LogLimiter::writeSummary(bool total) {
+
+  uint64_t numSuppressed = 0;
+  uint64_t numTotal = 0;
+  std::string keys;
+  size_t numKeys = 0;
+
+  for (auto & counter : m_counters) {
+    uint64_t suppressed = total ? counter.second.m_suppressed :
+                                  counter.second.m_sinceSummary;
+    counter.second.m_sinceSummary = 0;
+    if (suppressed == 0) {
+      continue;
+    }
+
+    numSuppressed += suppressed;
+    numTotal += counter.second.m_total;
+    if (!counter.first.empty() && numKeys++ < MAX_SUMMARY_KEYS) {
+      keys += (keys.empty() ? " (" : ", ") + counter.first + ": " +
+              std::to_string(suppressed);
+    }
+  }
+
+  if (numSuppressed == 0) {
+    return;
+  }
+  if (numKeys > MAX_SUMMARY_KEYS) {
+    keys += ", ...";
+  }
+  if (!keys.empty()) {
+    keys += ")";
+  }
+
+  if (total) {
+    BoostLog::log(m_level, m_name + ": " + std::to_string(numSuppressed) +
+                  " of " + std::to_string(numTotal) +
+                  " log entries have been suppressed" + keys);
+  }
+  else {
+    BoostLog::log(m_level, m_name + ": " + std::to_string(numSuppressed) +
+                  " log entries have been suppressed since the last summary" + keys);
+  }
+}
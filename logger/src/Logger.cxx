@@ -5,6 +5,10 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2   2026-10-19 agent user-048 Alert emails are sent by a
+ *                                        background thread, queued alerts are
+ *                                        sent after an ERROR and at
+ *                                        std::terminate().
  *  @version 13.0   2020-09-17 ABE #21949 Show target name in alert emails.
  *  @version 12.1.2 2020-03-23 ABE #20653 take log level into account when
  *                                        writing to file.
@@ -25,6 +29,9 @@
  *  @version  1.0   2014-02-26 ABE        First version.
  */
 
+#include <cstdlib>
+#include <exception>
+
 #include <boost/filesystem.hpp>
 
 #include "Logger.hxx"
@@ -33,7 +40,36 @@ std::string Logger::m_procName;
 
 std::string Logger::m_procVersion;
 
-EmailAlert Endline::m_emailAlert;
+std::unique_ptr<AlertDispatcher> Endline::m_alertDispatcher;
+
+/// the terminate handler installed before the first AlertDispatcher
+static std::terminate_handler s_previousTerminate = nullptr;
+
+/** ****************************************************************************
+ *  @brief Sends the queued alert emails before the program is aborted.
+ */
+static void flushAlertsAtTerminate() {
+
+  try {
+    Endline::flushEmailAlerts();
+  } catch (...) {}
+
+  if (s_previousTerminate != nullptr) {
+    s_previousTerminate();
+  }
+  std::abort();
+}
+
+void Endline::setEmailAlert(const EmailAlert & emailAlert,
+                            double digestPeriod) {
+
+  static bool terminateRegistered = false;
+  if (!terminateRegistered) {
+    s_previousTerminate = std::set_terminate(flushAlertsAtTerminate);
+    terminateRegistered = true;
+  }
+  m_alertDispatcher.reset(new AlertDispatcher(emailAlert, digestPeriod));
+}
 
 /** ****************************************************************************
  *  @brief Converts a string to a log level.
@@ -6,14 +6,25 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2 2026-10-19 agent user-048 test of the AlertDispatcher
  *  @version 6.2 2016-09-02 ABE first version.
  */
 
 #define BOOST_TEST_MAIN
 
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
 #include "Logger.hxx"
+#include "AlertDispatcher.hxx"
 
 using namespace boost::unit_test;
 
@@ -207,4 +218,99 @@ BOOST_AUTO_TEST_CASE( testSend ) {
   m_emailAlert.send(m_alertId, m_alertMessage);
 }
 
+BOOST_AUTO_TEST_CASE( testFileTransport ) {
+
+  std::string fileName = m_outDir + "/TestEmailAlert.eml";
+  unlink(fileName.c_str());
+
+  EmailAlert emailAlert = m_emailAlert;
+  emailAlert.setTransport(EmailAlert::fileTransport(fileName));
+
+  // no email without "to" email
+  BOOST_CHECK( !emailAlert.send(m_alertId, m_alertMessage) );
+  BOOST_CHECK( !boost::filesystem::exists(fileName) );
+
+  emailAlert = EmailAlert(m_emailTemplateFile, "test.to.email", m_fromEmail,
+                          m_programName, m_programVersion, m_hostName,
+                          m_logFile, m_visitId, m_obsid, m_passId,
+                          m_processingChain, m_targetName, m_revisionNumber,
+                          m_processingNumber);
+  emailAlert.setTransport(EmailAlert::fileTransport(fileName));
+  BOOST_CHECK( emailAlert.send(m_alertId, m_alertMessage) );
+
+  std::ifstream file(fileName);
+  std::stringstream email;
+  email << file.rdbuf();
+  BOOST_CHECK( email.str().find("To: test.to.email") != std::string::npos );
+  BOOST_CHECK( email.str().find(m_alertMessage) != std::string::npos );
+
+  unlink(fileName.c_str());
+}
+
+BOOST_AUTO_TEST_CASE( testAlertDispatcher ) {
+
+  // a transport that keeps the emails, the first email is held back until
+  // all alerts are posted
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool released = false;
+  std::vector<std::string> emails;
+  EmailAlert emailAlert(m_emailTemplateFile, "test.to.email", m_fromEmail,
+                        m_programName, m_programVersion, m_hostName,
+                        m_logFile, m_visitId, m_obsid, m_passId,
+                        m_processingChain, m_targetName, m_revisionNumber,
+                        m_processingNumber);
+  emailAlert.setTransport([&](const std::string &, const std::string & email) {
+    std::unique_lock<std::mutex> lock(mutex);
+    emails.push_back(email);
+    cond.notify_all();
+    cond.wait(lock, [&]() { return released; });
+    return true;
+  });
+
+  const int numAlerts = 200;
+  {
+    AlertDispatcher dispatcher(emailAlert, 0.5, 150);
+
+    // the first alert is sent at once
+    int numPosted = dispatcher.post("0", "burst alert 0");
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      cond.wait(lock, [&]() { return !emails.empty(); });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 1; i < numAlerts; i++) {
+      numPosted += dispatcher.post(std::to_string(i), "burst alert " + std::to_string(i));
+    }
+    auto stop = std::chrono::steady_clock::now();
+
+    std::cout << "AlertDispatcher::post(): "
+              << std::chrono::duration<double, std::micro>(stop - start).count() / (numAlerts - 1)
+              << " us per alert" << std::endl;
+
+    // 150 alerts fit into the queue
+    BOOST_CHECK_EQUAL( numPosted, 151 );
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      released = true;
+    }
+    cond.notify_all();
+
+    // the other alerts are sent in one digest
+    dispatcher.flush();
+    BOOST_CHECK_EQUAL( dispatcher.getNumSent(), 2 );
+
+    // the destructor sends the queued alert
+    dispatcher.post("300", "last alert");
+  }
+
+  BOOST_REQUIRE_EQUAL( emails.size(), 3 );
+  BOOST_CHECK( emails[0].find("burst alert 0") != std::string::npos );
+  BOOST_CHECK( emails[1].find("Subject: CHEOPS alert 1 and 198 more") != std::string::npos );
+  BOOST_CHECK( emails[1].find("burst alert 149") != std::string::npos );
+  BOOST_CHECK( emails[1].find("further alerts are only written to the log file") != std::string::npos );
+  BOOST_CHECK( emails[2].find("last alert") != std::string::npos );
+}
+
 BOOST_AUTO_TEST_SUITE_END()
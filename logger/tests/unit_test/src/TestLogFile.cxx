@@ -6,6 +6,7 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2 2026-10-19 agent user-045 test of the asynchronous log modes
  *  @version 7.4 2017-06-09 ABE checking the file name using regex has been
  *                              commented out to avoid the extra dependency on
  *                              boost regex.
@@ -14,6 +15,9 @@
 
 #define BOOST_TEST_MAIN
 
+#include <chrono>
+#include <fstream>
+
 #include <boost/filesystem.hpp>
 //#include <boost/regex.hpp>
 #include <boost/test/unit_test.hpp>
@@ -103,4 +107,55 @@ BOOST_AUTO_TEST_CASE( test_directory_name_logger ) {
   //unlink(logFile.c_str());
 }
 
+BOOST_AUTO_TEST_CASE( test_log_mode ) {
+
+  const uint64_t numMessages = 100000;
+  const LogMode modes[] = {SYNCHRONOUS_LOG, ASYNC_BLOCK_LOG, ASYNC_DROP_LOG};
+  const char * modeNames[] = {"synchronous", "async block", "async drop"};
+
+  Logger::SetProgramVersion("TestCxxLogMode", "13.2");
+
+  for (size_t m = 0; m < 3; m++) {
+
+    // setLogMode() adds the console sinks again
+    BoostLog::setLogMode(modes[m]);
+    boost::log::core::get()->remove_all_sinks();
+
+    unlink(m_logFile.c_str());
+    BoostLog::initFileLogging("TestCxxLogMode", "13.2", m_directory, "TestCxxLogFile.log");
+    uint64_t numDropped = BoostLog::getNumDroppedMessages();
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < numMessages; i++) {
+      logger << debug << "message number " << i << std::endl;
+    }
+    auto stop = std::chrono::steady_clock::now();
+    BoostLog::flush();
+
+    std::cout << modeNames[m] << ": "
+              << std::chrono::duration<double, std::micro>(stop - start).count() / numMessages
+              << " us per log entry on the logging thread" << std::endl;
+
+    std::ifstream file(m_logFile);
+    std::string line;
+    uint64_t numLines = 0;
+    while (std::getline(file, line)) {
+      numLines++;
+    }
+    numDropped = BoostLog::getNumDroppedMessages() - numDropped;
+
+    if (modes[m] == ASYNC_DROP_LOG) {
+      BOOST_CHECK_EQUAL( numLines + numDropped, numMessages );
+    }
+    else {
+      BOOST_CHECK_EQUAL( numLines, numMessages );
+      BOOST_CHECK_EQUAL( numDropped, 0 );
+    }
+  }
+
+  BoostLog::setLogMode(SYNCHRONOUS_LOG);
+  boost::log::core::get()->remove_all_sinks();
+  unlink(m_logFile.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,125 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup Logger
+ *  @brief Unit test of class LogLimiter.
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-047 first version.
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <sstream>
+
+#include <boost/log/core.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sinks/sync_frontend.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Logger.hxx"
+#include "LogLimiter.hxx"
+
+using namespace boost::unit_test;
+
+
+struct LogLimiterFixture {
+
+  typedef sinks::synchronous_sink< sinks::text_ostream_backend > TextSink;
+
+  LogLimiterFixture() {
+
+    // Only write into m_stream
+    boost::log::core::get()->remove_all_sinks();
+
+    m_stream = boost::make_shared< std::ostringstream >();
+    m_sink = boost::make_shared< TextSink >();
+    m_sink->locked_backend()->add_stream(m_stream);
+    m_sink->set_formatter(boost::log::expressions::stream << boost::log::expressions::smessage);
+    boost::log::core::get()->add_sink(m_sink);
+  }
+
+  ~LogLimiterFixture() {
+    boost::log::core::get()->remove_sink(m_sink);
+  }
+
+  /// Returns the number of lines written by the LogLimiter
+  size_t numLines() {
+    std::string text = m_stream->str();
+    return std::count(text.begin(), text.end(), '\n');
+  }
+
+  boost::shared_ptr< std::ostringstream > m_stream;
+  boost::shared_ptr< TextSink > m_sink;
+};
+
+BOOST_FIXTURE_TEST_SUITE( test_log_limiter, LogLimiterFixture )
+
+BOOST_AUTO_TEST_CASE( first_and_every ) {
+
+  LogLimiter limiter(WARN_LEVEL, "Missing frame(s)", 5, 100, 3600.);
+
+  uint64_t numAllowedA = 0;
+  uint64_t numAllowedB = 0;
+  for (int i = 0; i < 1000; i++) {
+    numAllowedA += limiter.allow("VC 1");
+    if (i < 3) {
+      numAllowedB += limiter.allow("VC 2");
+    }
+  }
+
+  // the first 5, then the 105th, 205th, ..., 905th
+  BOOST_CHECK_EQUAL( numAllowedA, 5 + 9 );
+  BOOST_CHECK_EQUAL( numAllowedB, 3 );
+  BOOST_CHECK_EQUAL( limiter.getNumSuppressed("VC 1"), 1000 - 5 - 9 );
+  BOOST_CHECK_EQUAL( limiter.getNumSuppressed("VC 2"), 0 );
+
+  // the message at the start of the suppression
+  BOOST_CHECK_EQUAL( numLines(), 1 );
+
+  limiter.report();
+  BOOST_CHECK_EQUAL( numLines(), 2 );
+  BOOST_CHECK( m_stream->str().find("Missing frame(s): 986 of 1000 log entries "
+                                    "have been suppressed (VC 1: 986)")
+               != std::string::npos );
+
+  // report() resets the counters
+  BOOST_CHECK_EQUAL( limiter.getNumSuppressed("VC 1"), 0 );
+  BOOST_CHECK( limiter.allow("VC 1") );
+}
+
+BOOST_AUTO_TEST_CASE( none_after_first ) {
+
+  {
+    LogLimiter limiter(ERROR_LEVEL, "Protocol violation", 2, 0);
+    BOOST_CHECK( limiter.allow() );
+    BOOST_CHECK( limiter.allow() );
+    for (int i = 0; i < 100; i++) {
+      BOOST_CHECK( !limiter.allow() );
+    }
+  }
+
+  // the destructor writes the totals
+  BOOST_CHECK_EQUAL( numLines(), 2 );
+  BOOST_CHECK( m_stream->str().find("Protocol violation: 100 of 102 log entries "
+                                    "have been suppressed\n")
+               != std::string::npos );
+}
+
+BOOST_AUTO_TEST_CASE( summary ) {
+
+  // a summary at every call
+  LogLimiter limiter(INFO_LEVEL, "Idle data", 0, 0, 0.);
+
+  for (int i = 0; i < 10; i++) {
+    BOOST_CHECK( !limiter.allow("VC 3") );
+  }
+  BOOST_CHECK( m_stream->str().find("Idle data: 1 log entries have been "
+                                    "suppressed since the last summary (VC 3: 1)")
+               != std::string::npos );
+  BOOST_CHECK_EQUAL( limiter.getNumSuppressed("VC 3"), 10 );
+}
+
+BOOST_AUTO_TEST_SUITE_END()
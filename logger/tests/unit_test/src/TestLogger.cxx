@@ -10,10 +10,13 @@
  *  @version 1.0   2014-03-11 ABE first version.
  *  @version 3.2   2015-03-27 Updated unit tests for alert codes and different
  *                            types of ints.
+ *  @version 13.2  2026-10-19 agent user-046 test of disabled log levels
  */
 
 #define BOOST_TEST_MAIN
 
+#include <chrono>
+
 #include <boost/test/unit_test.hpp>
 
 #include "Logger.hxx"
@@ -371,4 +374,63 @@ BOOST_AUTO_TEST_CASE( test_error_level ) {
 }
 
 
+BOOST_AUTO_TEST_CASE( test_disabled_level ) {
+
+  unlink(m_logFile.c_str());
+  m_logFile = Logger::Configure("INFO", "WARN", m_alertEmail, m_outDir);
+
+  BOOST_CHECK( !BoostLog::isEnabled(DEBUG_LEVEL) );
+  BOOST_CHECK( BoostLog::isEnabled(INFO_LEVEL) );
+  BOOST_CHECK( BoostLog::isEnabled(ALERT_LEVEL) );
+  // written to the log file, which has the level of stdout
+  BOOST_CHECK( BoostLog::isEnabled(PROGRESS_LEVEL) );
+  BOOST_CHECK( BoostLog::isEnabled(WARN_LEVEL) );
+
+  TextMessage textMessage = logger << debug << m_string << m_int32_t << m_double;
+  BOOST_CHECK_EQUAL( textMessage.GetMessage(), std::string() );
+  textMessage << std::endl;
+
+  textMessage = logger << info << m_string << m_int32_t;
+  BOOST_CHECK_EQUAL( textMessage.GetMessage(), m_string + std::to_string(m_int32_t) );
+
+  // the operands of LOG_DEBUG are not evaluated
+  int numCalls = 0;
+  auto count = [&numCalls]() { return ++numCalls; };
+  LOG_DEBUG << "call " << count() << std::endl;
+  BOOST_CHECK_EQUAL( numCalls, 0 );
+  LOG_INFO << "call " << count() << std::endl;
+  BOOST_CHECK_EQUAL( numCalls, 1 );
+
+  // cost of a disabled log entry compared to no log entry
+  const uint64_t numLoops = 1000000;
+  volatile uint64_t sum = 0;
+
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < numLoops; i++) {
+    sum = sum + i;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double emptyTime = std::chrono::duration<double, std::nano>(stop - start).count() / numLoops;
+
+  start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < numLoops; i++) {
+    sum = sum + i;
+    logger << debug << "loop " << i << " of " << numLoops << std::endl;
+  }
+  stop = std::chrono::steady_clock::now();
+  double streamTime = std::chrono::duration<double, std::nano>(stop - start).count() / numLoops;
+
+  start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < numLoops; i++) {
+    sum = sum + i;
+    LOG_DEBUG << "loop " << i << " of " << numLoops << std::endl;
+  }
+  stop = std::chrono::steady_clock::now();
+  double macroTime = std::chrono::duration<double, std::nano>(stop - start).count() / numLoops;
+
+  std::cout << "disabled debug log entry: no statement " << emptyTime
+            << " ns, logger << debug " << streamTime
+            << " ns, LOG_DEBUG " << macroTime << " ns per loop" << std::endl;
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,7 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2 2026-10-19 agent user-050 typed parameter handles
  *  @version 1.0 first released version
  *
  */
@@ -15,6 +16,7 @@
 
 #include <string>
 
+#include "ParamHandle.hxx"
 
 class ProgramParams;
 
@@ -103,6 +105,14 @@ public:
     std::string GetAsString (const std::string & name) const;
 
 
+    /** *************************************************************************
+     *  @brief Returns a handle holding the value of a parameter, which is
+     *         converted only once.
+     */
+    template <class T>
+    ParamHandle<T> Handle(const std::string & name) const;
+
+
     /** *************************************************************************
      *  @brief to be able to create an instance of this ModuleParams class
      */
@@ -0,0 +1,145 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup ProgParam
+ *  @brief Declaration of the ParamHandle class
+ *
+ *  @author agent
+ *
+ *  @version 13.2 2026-10-19 agent user-050 first version
+ *
+ */
+
+#ifndef _PARAM_HANDLE_HXX_
+#define _PARAM_HANDLE_HXX_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+/** ****************************************************************************
+ *  @ingroup ProgParam
+ *
+ *  @brief The value of one program parameter, converted into its data type
+ *         when the handle is created.
+ *
+ *  A handle is created with ProgramParams::Handle() or ModuleParams::Handle().
+ *  The parameter is looked up and its value converted only once, therefore
+ *  handles should be used to access parameters inside of loops:
+ *  <pre> ParamsPtr prog = CheopsInit(argc, argv);
+ *   ParamHandle<double> threshold = prog->Handle<double>("module1.threshold");
+ *   for (...)
+ *      if (pixel > threshold.Get()) ... </pre>
+ *
+ *  The supported data types are the types of the GetAs...() methods of
+ *  ProgramParams: int32_t, double, bool and std::string.
+ *  Repeatable parameters are accessed with a ParamHandle<std::vector<T>>.
+ */
+template <class T>
+class ParamHandle {
+
+   std::string m_name;   ///< the full name of the parameter
+   T           m_value;  ///< the value of the parameter
+
+public:
+
+   /** ************************************************************************
+    *  @brief Stores the value of parameter @b name.
+    */
+   ParamHandle(const std::string & name, const T & value)
+      : m_name(name), m_value(value) {}
+
+
+   /** ************************************************************************
+    *  @brief Returns the full name of the parameter
+    */
+   const std::string & GetName() const { return m_name; }
+
+
+   /** ************************************************************************
+    *  @brief Returns the value of the parameter
+    */
+   const T & Get() const { return m_value; }
+
+
+   /** ************************************************************************
+    *  @brief Returns the value of the parameter
+    */
+   operator const T & () const { return m_value; }
+};
+
+
+/** ****************************************************************************
+ *  @ingroup ProgParam
+ *
+ *  @brief The values of one repeatable program parameter, converted into
+ *         their data type when the handle is created.
+ *
+ *  The values are stored in a contiguous array, also for data type bool.
+ *  Copies of a handle share this array.
+ */
+template <class T>
+class ParamHandle<std::vector<T>> {
+
+   std::string         m_name;    ///< the full name of the parameter
+   std::shared_ptr<T>  m_values;  ///< the values of the parameter
+   size_t              m_size;    ///< the number of values
+
+public:
+
+   /** ************************************************************************
+    *  @brief Stores the values of parameter @b name.
+    */
+   ParamHandle(const std::string & name, const std::vector<T> & values)
+      : m_name(name), m_values(new T[values.size()], std::default_delete<T[]>()),
+        m_size(values.size())
+      { std::copy(values.begin(), values.end(), m_values.get()); }
+
+
+   /** ************************************************************************
+    *  @brief Returns the full name of the parameter
+    */
+   const std::string & GetName() const { return m_name; }
+
+
+   /** ************************************************************************
+    *  @brief Returns the number of values
+    */
+   size_t size() const { return m_size; }
+
+
+   /** ************************************************************************
+    *  @brief Returns true if the parameter has no value
+    */
+   bool empty() const { return m_size == 0; }
+
+
+   /** ************************************************************************
+    *  @brief Returns a pointer to the array of values
+    */
+   const T * data() const { return m_values.get(); }
+
+
+   /** ************************************************************************
+    *  @brief Returns value @b index, which is not checked
+    */
+   const T & operator [] (size_t index) const { return m_values.get()[index]; }
+
+
+   /** ************************************************************************
+    *  @brief Returns a pointer to the first value
+    */
+   const T * begin() const { return m_values.get(); }
+
+
+   /** ************************************************************************
+    *  @brief Returns a pointer behind the last value
+    */
+   const T * end() const { return m_values.get() + m_size; }
+};
+
+
+#endif /* _PARAM_HANDLE_HXX_ */
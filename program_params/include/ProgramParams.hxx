@@ -6,6 +6,10 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2   2026-10-19 agent user-049 read the parameter file into a list
+ *                                        of ParamAttributes, which can be
+ *                                        cached, typed parameter handles
+ *                                        (user-050)
  *  @version 10.5.1 ABE 2018-12-11 #17373 New optional argument to CheopsInit
  *                                        for turning off verbose logging
  *  @version  9.1.2 ABE 2018-03-23 #15770 log program params and file names
@@ -32,12 +36,16 @@
 #include <list>
 #include <set>
 #include <map>
+#include <vector>
 
 #include <boost/program_options.hpp>
 
+#include "ParamHandle.hxx"
+
 class program_params_type;
 class module_type;
 class param_type;
+struct ParamAttributes;
 class ModuleParams;
 
 
@@ -108,20 +116,42 @@ class ProgramParams  {
     
 
    /** ************************************************************************
-    * @brief Reads the parameters of one module and stores them in desc
+    * @brief Reads the parameters of one module and appends them to params
     */
    void ReadModule(const std::string & path,
                    const module_type & module,
-                   boost::program_options::options_description & desc);
+                   std::vector<ParamAttributes> & params);
 
 
    /** ************************************************************************
-    * @brief Reads one parameter form the parameter file and stores its
-    *        attributes in desc
+    * @brief Reads one parameter form the parameter file and appends its
+    *        attributes to params
     */
    void ReadParam(const std::string & path,
                   const param_type & param,
-                  boost::program_options::options_description & desc);
+                  std::vector<ParamAttributes> & params);
+
+
+   /** ************************************************************************
+    * @brief Gets the value of a parameter by calling the GetAs...() method of
+    *        the data type of @b value.
+    */
+   void GetValue(const std::string & name, int32_t & value) const
+      { value = GetAsInt(name); }
+   void GetValue(const std::string & name, double & value) const
+      { value = GetAsDouble(name); }
+   void GetValue(const std::string & name, bool & value) const
+      { value = GetAsBool(name); }
+   void GetValue(const std::string & name, std::string & value) const
+      { value = GetAsString(name); }
+   void GetValue(const std::string & name, std::vector<int> & value) const
+      { value = GetAsIntVector(name); }
+   void GetValue(const std::string & name, std::vector<double> & value) const
+      { value = GetAsDoubleVector(name); }
+   void GetValue(const std::string & name, std::vector<bool> & value) const
+      { value = GetAsBoolVector(name); }
+   void GetValue(const std::string & name, std::vector<std::string> & value) const
+      { value = GetAsStringVector(name); }
 
 public:
 
@@ -194,6 +224,14 @@ public:
    std::vector<std::string> GetAsStringVector (const std::string & name) const;
 
 
+   /** ************************************************************************
+    *  @brief Returns a handle holding the value of a parameter, which is
+    *         converted only once.
+    */
+   template <class T>
+   ParamHandle<T> Handle(const std::string & name) const;
+
+
    /** ************************************************************************
     *  @brief Returns a list of all available input structure name, found
     *         in the job order file
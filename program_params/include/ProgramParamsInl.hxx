@@ -6,6 +6,7 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2 2026-10-19 agent user-050 typed parameter handles
  *  @version 1.0 first released version
  *
  */
@@ -125,4 +126,49 @@ inline std::string ModuleParams::GetAsString (const std::string & name) const
                            {return m_programParams->GetAsString(m_path + "." + name);}
 
 
+/** ****************************************************************************
+ *  The parameter is looked up and its value is converted into data type
+ *  @b T only once, by calling the GetAs...() method of @b T. The returned
+ *  handle gives access to the value without any further lookup, see
+ *  ParamHandle. The supported data types are int32_t, double, bool,
+ *  std::string and std::vector of int, double, bool and std::string.
+ *  Note: the data type is defined in the XML parameter file.
+ *
+ *  @param [in] name the full name of a parameter. If the parameter is
+ *                   defined in a module or sub-module the module name
+ *                   must be part of the @b name. For example:
+ *                   @c "module.sub-module.parameter"
+ *
+ *  @throw runtime_error if the parameter @b name does not exist
+ *                       or if the value of the parameter cannot be
+ *                       converted into data type @b T.
+ *
+ *  @return    a handle holding the value of the parameter.
+ */
+template <class T>
+inline ParamHandle<T> ProgramParams::Handle(const std::string & name) const
+      { T value; GetValue(name, value); return ParamHandle<T>(name, value); }
+
+
+/** ****************************************************************************
+ *  See ProgramParams::Handle().
+ *
+ *  @param [in] name the partial name of a parameter. If the parameter is
+ *                   defined in a sub-module of this module the sub-module
+ *                   name must be part of the @b name. For example:
+ *                   @c "sub-module.parameter". But the name of this
+ *                   module must be omitted.
+ *
+ *  @throw runtime_error if the full parameter @b name (including the
+ *                       module name of this module) does not exist
+ *                       or if the value of the parameter cannot be
+ *                       converted into data type @b T.
+ *
+ *  @return    a handle holding the value of the parameter.
+ */
+template <class T>
+inline ParamHandle<T> ModuleParams::Handle(const std::string & name) const
+      {return m_programParams->Handle<T>(m_path + "." + name);}
+
+
 #endif /* _PROGRAM_PARAMS_INL_HXX_ */
@@ -7,6 +7,8 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2 2026-10-19 agent user-049 cache the parsed parameter files
+ *                              in the directory CHEOPS_PARAMS_CACHE
  *  @version 5.0 2016-01-11 ABE #9942 allow for repeatable command line args
  *  @version 3.1 2015-02-10 RRO read program_params_schema.xsd always from
  *                              $CHEOPS_SW/resources
@@ -14,11 +16,23 @@
  *
  */
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <sstream>
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <boost/optional.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include "Logger.hxx"
@@ -30,6 +44,26 @@ using namespace boost::program_options;
 using namespace boost::filesystem;
 using namespace std;
 
+/// An optional attribute of a parameter in the parameter file
+typedef boost::optional<string> ParamValue;
+
+/** ****************************************************************************
+ *  @brief The attributes of one parameter as defined in the parameter file.
+ *
+ *  They are read from the xml file, or from the binary cache of the
+ *  parameter file, see ReadParamCache().
+ */
+struct ParamAttributes {
+    string     m_name;        ///< name of the parameter, including the modules
+    ParamValue m_shortName;   ///< the optional short name
+    ParamValue m_value;       ///< the optional default value
+    ParamValue m_min;         ///< the optional min value
+    ParamValue m_max;         ///< the optional max value
+    ParamValue m_help;        ///< the optional help text
+    int        m_type;        ///< index of the value_data_type
+    bool       m_repeatable;  ///< true if the parameter is repeatable
+};
+
 /** ****************************************************************************
  * @brief Casts a string to the type defined by the template type.
  *
@@ -76,15 +110,15 @@ T CastStringValue(const string & paramName,
  */
 template <class T>
 T ValidateParamValue(const string & paramName,
-                       const param_type::value_optional & val,
-                       const param_type::value_optional & min,
-                       const param_type::value_optional & max,
+                       const ParamValue & val,
+                       const ParamValue & min,
+                       const ParamValue & max,
                        int   typeIndex) {
 
   // a default value is defined in the parameter file
   T paramVal = CastStringValue<T>(paramName, val.get(), "value", typeIndex);
 
-  if (min.present())
+  if (min)
   {
       // a min value is defined in the parameter file
       // test the parameter value against it
@@ -97,7 +131,7 @@ T ValidateParamValue(const string & paramName,
                               min.get() + "]." );
   }
 
-  if (max.present())
+  if (max)
   {
       // a max value is defined in the parameter file
       // test the parameter value against it
@@ -130,9 +164,9 @@ T ValidateParamValue(const string & paramName,
  */
 template <>
 bool ValidateParamValue(const string & paramName,
-                        const param_type::value_optional & val,
-                        const param_type::value_optional & min,
-                        const param_type::value_optional & max,
+                        const ParamValue & val,
+                        const ParamValue & min,
+                        const ParamValue & max,
                         int   typeIndex)
 {
     // we don't care for upper and lower case.
@@ -172,14 +206,14 @@ bool ValidateParamValue(const string & paramName,
  */
 template <class T>
 value_semantic * SetSemantic(const string & paramName,
-                             const param_type::value_optional & val,
-                             const param_type::value_optional & min,
-                             const param_type::value_optional & max,
+                             const ParamValue & val,
+                             const ParamValue & min,
+                             const ParamValue & max,
                              bool isRepeatable,
                              int   typeIndex) {
 
     // if the parameter has a default value
-    if (val.present()) {
+    if (val) {
         T paramVal = ValidateParamValue<T>(paramName, val, min, max, typeIndex);
         if (isRepeatable) {
             std::vector<T> defaultValues = { paramVal };
@@ -204,58 +238,88 @@ value_semantic * SetSemantic(const string & paramName,
     }
 }
 
+
 /** ****************************************************************************
- *   Converts the attributes of one parameter form the xml file into a
- *   semantic variable and adds it to @b desc.
+ *   Converts the attributes of one parameter into a semantic variable and
+ *   adds it to @b desc.
  *
- *   @param [in] path  The parent modules of this new parameter. May be
- *                     empty if the parameter does not belong to a module.
- *   @param [in] param Gives access to all attributes of the parameter, as
- *                     defined in the xml parameter file. It is filled by
- *                     while the xml file was parsed with the xsd library.
+ *   @param [in] param The attributes of the parameter, as defined in the
+ *                     parameter file.
  *   @param [out] desc The new parameter is added to this variable.
  */
-void ProgramParams::ReadParam(const string & path,
-                              const param_type & param,
-                              options_description & desc)
+static void AddParam(const ParamAttributes & param,
+                     options_description & desc)
 {
     // prepare name with optional short name of parameter
-    string name = path + param.name();
-    const param_type::short_name_optional & shortName = param.short_name();
-    if (shortName.present())
-        name += "," + shortName.get();
-    
+    string name = param.m_name;
+    if (param.m_shortName)
+        name += "," + param.m_shortName.get();
+
     // define the data type, set the default value and
     // verify it against accepted min and max value
-    value_semantic * semantic;
-    const param_type::value_optional & val = param.value();
-    const param_type::type_optional & type = param.type();
-    const param_type::min_optional & min = param.min();
-    const param_type::max_optional & max = param.max();
-    bool repeatable = param.repeatable().present() ?
-            param.repeatable().get() : param.repeatable_default_value();
-
-    if (!type.present() || type.get() == value_data_type::string) {
-           semantic = SetSemantic<string>(name, val, min, max, repeatable,
-                                          type.present() ? type.get() : value_data_type("string"));
-    }
-    else if (type.get() == value_data_type::int_) {
-        semantic = SetSemantic<int>(name, val, min, max, repeatable, type.get());
-    }
-    else if (type.get() == value_data_type::double_) {
-        semantic = SetSemantic<double>(name, val, min, max, repeatable, type.get());
-    }
-    else if (type.get() == value_data_type::bool_) {
-        semantic = SetSemantic<bool>(name, val, min, max, repeatable, type.get());
+    value_semantic * semantic = NULL;
+    const ParamValue & val = param.m_value;
+    const ParamValue & min = param.m_min;
+    const ParamValue & max = param.m_max;
+
+    switch (param.m_type) {
+    case value_data_type::string:
+        semantic = SetSemantic<string>(name, val, min, max, param.m_repeatable, param.m_type);
+        break;
+    case value_data_type::int_:
+        semantic = SetSemantic<int>(name, val, min, max, param.m_repeatable, param.m_type);
+        break;
+    case value_data_type::double_:
+        semantic = SetSemantic<double>(name, val, min, max, param.m_repeatable, param.m_type);
+        break;
+    case value_data_type::bool_:
+        semantic = SetSemantic<bool>(name, val, min, max, param.m_repeatable, param.m_type);
+        break;
     }
 
     // add parameter to list of parameters (desc) with optional help text
-    const param_type::help_optional & help = param.help();
-    if (help.present())
-        desc.add_options()( name.c_str(), semantic, help.get().c_str() );
+    if (param.m_help)
+        desc.add_options()( name.c_str(), semantic, param.m_help.get().c_str() );
     else
         desc.add_options()( name.c_str(), semantic);
-    
+
+}
+
+/** ****************************************************************************
+ *   Copies the attributes of one parameter form the xml file into
+ *   @b params.
+ *
+ *   @param [in] path  The parent modules of this new parameter. May be
+ *                     empty if the parameter does not belong to a module.
+ *   @param [in] param Gives access to all attributes of the parameter, as
+ *                     defined in the xml parameter file. It is filled by
+ *                     while the xml file was parsed with the xsd library.
+ *   @param [out] params The attributes of the new parameter are appended
+ *                     to this list.
+ */
+void ProgramParams::ReadParam(const string & path,
+                              const param_type & param,
+                              vector<ParamAttributes> & params)
+{
+    ParamAttributes attributes;
+    attributes.m_name = path + param.name();
+    if (param.short_name().present())
+        attributes.m_shortName = string(param.short_name().get());
+    if (param.value().present())
+        attributes.m_value = param.value().get();
+    if (param.min().present())
+        attributes.m_min = param.min().get();
+    if (param.max().present())
+        attributes.m_max = param.max().get();
+    if (param.help().present())
+        attributes.m_help = param.help().get();
+    attributes.m_type = value_data_type::string;
+    if (param.type().present())
+        attributes.m_type = param.type().get();
+    attributes.m_repeatable = param.repeatable().present() ?
+            param.repeatable().get() : param.repeatable_default_value();
+
+    params.push_back(attributes);
 }
 
 /** ****************************************************************************
@@ -268,20 +332,20 @@ void ProgramParams::ReadParam(const string & path,
  *                      this module, as
  *                      defined in the xml parameter file. It is filled by
  *                      while the xml file was parsed with the xsd library.
- *   @param [out] desc  All new parameter of this module and all sub-modules
- *                      are added to this variable.
+ *   @param [out] params The attributes of all parameters of this module and
+ *                      all sub-modules are appended to this list.
  */
 void ProgramParams::ReadModule(const string & path,
                                const module_type & module,
-                               options_description & desc)
+                               vector<ParamAttributes> & params)
 {
 
     // get and read all parameters of this module
-    const module_type::param_sequence & params = module.param();
-    module_type::param_const_iterator i_params = params.begin();
-    while (i_params != params.end())
+    const module_type::param_sequence & moduleParams = module.param();
+    module_type::param_const_iterator i_params = moduleParams.begin();
+    while (i_params != moduleParams.end())
     {
-        ReadParam(path + module.name() + ".", *i_params, desc);
+        ReadParam(path + module.name() + ".", *i_params, params);
         i_params++;
     }
 
@@ -290,12 +354,238 @@ void ProgramParams::ReadModule(const string & path,
     module_type::module_const_iterator i_modules = modules.begin();
     while (i_modules != modules.end())
     {
-        ReadModule(path + module.name() + ".", *i_modules, desc);
+        ReadModule(path + module.name() + ".", *i_modules, params);
         i_modules++;
     }
 
 }
 
+/// Identifies a file of the parameter file cache and its format version
+static const char PARAM_CACHE_MAGIC[8] = {'C', 'H', 'P', 'A', 'R', 'A', 'M', '1'};
+
+/** ****************************************************************************
+ *  @brief Returns the content of a file.
+ *
+ *  @throw runtime_error if the file cannot be read
+ */
+static string ReadFileContent(const string & fileName)
+{
+    std::ifstream file(fileName.c_str(), ios::binary);
+    stringstream content;
+    content << file.rdbuf();
+    if (!file)
+        throw runtime_error("Failed to read the file " + fileName);
+    return content.str();
+}
+
+/** ****************************************************************************
+ *  @brief Returns the 64 bit FNV-1a hash of @b content.
+ */
+static uint64_t HashContent(const string & content, uint64_t hash = 14695981039346656037ULL)
+{
+    for (unsigned char c : content) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/** ****************************************************************************
+ *  @brief Returns the directory of the parameter file cache.
+ *
+ *  The cache is only used if the environment variable CHEOPS_PARAMS_CACHE
+ *  defines its directory. The directory is created with permissions 0700.
+ *  It is not used if it is not owned by the user or if other users can
+ *  write to it, because they could place cache files with wrong parameters.
+ *
+ *  @return the cache directory or an empty path if the cache is not used
+ */
+static path GetParamCacheDir()
+{
+    const char * cacheDir = getenv("CHEOPS_PARAMS_CACHE");
+    if (cacheDir == NULL || cacheDir[0] == '\0')
+        return path();
+
+    struct stat status;
+    if (mkdir(cacheDir, S_IRWXU) != 0 && errno != EEXIST) {
+        logger << debug << "Cannot create the parameter cache directory "
+               << cacheDir << ": " << strerror(errno) << endl;
+        return path();
+    }
+    if (lstat(cacheDir, &status) != 0 || !S_ISDIR(status.st_mode) ||
+        status.st_uid != getuid() || (status.st_mode & (S_IRWXG | S_IRWXO)) != 0) {
+        logger << debug << "The parameter cache directory " << cacheDir
+               << " is not used, it must be a directory with permissions 0700"
+               << " owned by the user" << endl;
+        return path();
+    }
+    return path(cacheDir);
+}
+
+/// Writes a string with its length to a cache file
+static void WriteCacheString(ostream & out, const string & value)
+{
+    uint64_t length = value.size();
+    out.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    out.write(value.data(), value.size());
+}
+
+/// Reads a string written by WriteCacheString(), returns false on failure
+static bool ReadCacheString(istream & in, string & value)
+{
+    uint64_t length = 0;
+    if (!in.read(reinterpret_cast<char *>(&length), sizeof(length)) ||
+        length > (uint64_t(1) << 32))
+        return false;
+    value.resize(length);
+    return length == 0 || in.read(&value[0], length);
+}
+
+/// Writes an optional attribute to a cache file
+static void WriteCacheValue(ostream & out, const ParamValue & value)
+{
+    out.put(value ? 1 : 0);
+    if (value)
+        WriteCacheString(out, value.get());
+}
+
+/// Reads an optional attribute written by WriteCacheValue()
+static bool ReadCacheValue(istream & in, ParamValue & value)
+{
+    char present = 0;
+    if (!in.get(present))
+        return false;
+    if (present) {
+        string content;
+        if (!ReadCacheString(in, content))
+            return false;
+        value = content;
+    }
+    return true;
+}
+
+/** ****************************************************************************
+ *  @brief Reads the parameter attributes from a cache file.
+ *
+ *  The cache file contains a copy of the parameter file and of its
+ *  schema file. The attributes are only used if both are identical to
+ *  @b xmlContent and @b schemaContent, i.e. if the parameter file has
+ *  already been validated against the schema.
+ *
+ *  @return false if the cache file does not exist, is not valid or does not
+ *          belong to the parameter file.
+ */
+static bool ReadParamCache(const path & cacheFile,
+                           const string & xmlContent,
+                           const string & schemaContent,
+                           vector<ParamAttributes> & params)
+{
+    std::ifstream in(cacheFile.string().c_str(), ios::binary);
+    char magic[sizeof(PARAM_CACHE_MAGIC)];
+    if (!in.read(magic, sizeof(magic)) ||
+        !equal(magic, magic + sizeof(magic), PARAM_CACHE_MAGIC))
+        return false;
+
+    string content;
+    if (!ReadCacheString(in, content) || content != xmlContent ||
+        !ReadCacheString(in, content) || content != schemaContent)
+        return false;
+
+    uint64_t numParams = 0;
+    if (!in.read(reinterpret_cast<char *>(&numParams), sizeof(numParams)))
+        return false;
+
+    vector<ParamAttributes> cachedParams;
+    for (uint64_t i = 0; i < numParams; i++) {
+        ParamAttributes param;
+        int32_t type = 0;
+        char repeatable = 0;
+        if (!ReadCacheString(in, param.m_name) ||
+            !ReadCacheValue(in, param.m_shortName) ||
+            !ReadCacheValue(in, param.m_value) ||
+            !ReadCacheValue(in, param.m_min) ||
+            !ReadCacheValue(in, param.m_max) ||
+            !ReadCacheValue(in, param.m_help) ||
+            !in.read(reinterpret_cast<char *>(&type), sizeof(type)) ||
+            !in.get(repeatable) ||
+            type < value_data_type::string || type > value_data_type::bool_)
+            return false;
+        param.m_type = type;
+        param.m_repeatable = repeatable != 0;
+        cachedParams.push_back(param);
+    }
+
+    params.swap(cachedParams);
+    return true;
+}
+
+/** ****************************************************************************
+ *  @brief Writes the parameter attributes to a cache file.
+ *
+ *  The file is written under a temporary name and then renamed, so that
+ *  programs running in parallel never read an incomplete cache file.
+ *  The cache files of older versions of the parameter file of program
+ *  @b programName are removed. Failures are only logged, the cache is not
+ *  required.
+ */
+static void WriteParamCache(const path & cacheFile,
+                            const string & programName,
+                            const string & xmlContent,
+                            const string & schemaContent,
+                            const vector<ParamAttributes> & params)
+{
+    try {
+        path tmpFile = cacheFile.parent_path() / unique_path("%%%%-%%%%-%%%%.tmp");
+        {
+            std::ofstream out(tmpFile.string().c_str(), ios::binary);
+            out.write(PARAM_CACHE_MAGIC, sizeof(PARAM_CACHE_MAGIC));
+            WriteCacheString(out, xmlContent);
+            WriteCacheString(out, schemaContent);
+
+            uint64_t numParams = params.size();
+            out.write(reinterpret_cast<const char *>(&numParams), sizeof(numParams));
+            for (const ParamAttributes & param : params) {
+                int32_t type = param.m_type;
+                WriteCacheString(out, param.m_name);
+                WriteCacheValue(out, param.m_shortName);
+                WriteCacheValue(out, param.m_value);
+                WriteCacheValue(out, param.m_min);
+                WriteCacheValue(out, param.m_max);
+                WriteCacheValue(out, param.m_help);
+                out.write(reinterpret_cast<const char *>(&type), sizeof(type));
+                out.put(param.m_repeatable ? 1 : 0);
+            }
+            out.close();
+            if (!out)
+                throw runtime_error("Failed to write the file " + tmpFile.string());
+        }
+        rename(tmpFile, cacheFile);
+
+        // the cache files of previous versions of the parameter file are
+        // not used anymore. Only names <programName>_<16 hex digits>.bin are
+        // removed, not the cache files of programs whose name starts with
+        // programName_
+        string prefix = programName + "_";
+        const size_t hashLength = 16;
+        for (directory_iterator file(cacheFile.parent_path());
+             file != directory_iterator(); ++file) {
+            string fileName = file->path().filename().string();
+            if (file->path() != cacheFile &&
+                fileName.size() == prefix.size() + hashLength + 4 &&
+                boost::starts_with(fileName, prefix) &&
+                boost::ends_with(fileName, ".bin") &&
+                all_of(fileName.begin() + prefix.size(),
+                       fileName.begin() + prefix.size() + hashLength,
+                       [](char c) { return isxdigit(static_cast<unsigned char>(c)) != 0; }))
+                remove(file->path());
+        }
+    }
+    catch (const exception & e) {
+        logger << debug << "Cannot write the parameter cache file "
+               << cacheFile.string() << ": " << e.what() << endl;
+    }
+}
+
 
 /** ****************************************************************************
  *  First the function tries to open the parameter file in these locations:
@@ -306,6 +596,13 @@ void ProgramParams::ReadModule(const string & path,
  *  Then is uses the XSD library to pars the parameter file and calls
  *  functions to store all parameters in @b desc.
  *
+ *  Parsing and validating the parameter file with the XSD library takes
+ *  most of the startup time of a program. Therefore the parameter
+ *  attributes can be stored in a binary cache file, see GetParamCacheDir().
+ *  Its file name contains a hash of the content of the parameter file and
+ *  of the schema file. Later runs of the program read the attributes from
+ *  the cache file as long as both files are not modified.
+ *
  *  The filename (without path) of the parameter file is programName.xml
  *
  *  @param [in] programName  It is used to define the file name of the
@@ -355,44 +652,77 @@ void ProgramParams::ReadParamFile(const string & programName,
          throw runtime_error("Failed to find schema of program parameter file: " + schemaFileName);
 
 
-    // parsing the xml file
-    logger << debug << "Reading configuration file " << xmlFile << endl;
-    
-    // prepare to use schema file  $CHOEPS_SW/resources/program_params_schema.xsd
-    xml_schema::properties props;
-    props.no_namespace_schema_location (schemaFileName.c_str());
-    props.schema_location ("http://www.w3.org/XML/1998/namespace", "xml.xsd");
-    auto_ptr<program_params_type> xml;
+    // look for the parameters in the cache
+    chrono::steady_clock::time_point start = chrono::steady_clock::now();
+    string xmlContent = ReadFileContent(xmlFile);
+    string schemaContent = ReadFileContent(schemaFileName);
 
-    try {
-      xml = auto_ptr<program_params_type>(program_params (xmlFile, 0, props));
+    path cacheFile;
+    path cacheDir = GetParamCacheDir();
+    if (!cacheDir.empty()) {
+        stringstream cacheName;
+        cacheName << programName << "_" << hex << setw(16) << setfill('0')
+                  << HashContent(schemaContent, HashContent(xmlContent)) << ".bin";
+        cacheFile = cacheDir / cacheName.str();
     }
-    // Error parsing the param file. Need to pass the error object to a stream
-    // in order to get the complete error message that includes information
-    // about the line on which the parse error occurred.
-    catch (const xml_schema::exception& e) {
-      std::stringstream message;
-      message << e;
-      throw runtime_error(message.str());
-    }
-    // get and read all parameters of first level
-    const program_params_type::param_sequence & params = xml->param();
-    program_params_type::param_const_iterator i_params = params.begin();
-    while (i_params != params.end())
+
+    vector<ParamAttributes> params;
+    if (!cacheFile.empty() &&
+        ReadParamCache(cacheFile, xmlContent, schemaContent, params))
     {
-        ReadParam(string(), *i_params, desc);
-        i_params++;
+        logger << debug << "Reading configuration file " << xmlFile
+               << " from the cache " << cacheFile.string() << endl;
     }
-    
-    
-    // get and process all modules of first level
-    const program_params_type::module_sequence & modules = xml->module();
-    program_params_type::module_const_iterator i_modules = modules.begin();
-    while (i_modules != modules.end())
+    else
     {
-        ReadModule(string(), *i_modules, desc);
-        i_modules++;
+      // parsing the xml file
+      logger << debug << "Reading configuration file " << xmlFile << endl;
+
+      // prepare to use schema file  $CHOEPS_SW/resources/program_params_schema.xsd
+      xml_schema::properties props;
+      props.no_namespace_schema_location (schemaFileName.c_str());
+      props.schema_location ("http://www.w3.org/XML/1998/namespace", "xml.xsd");
+      auto_ptr<program_params_type> xml;
+
+      try {
+        xml = auto_ptr<program_params_type>(program_params (xmlFile, 0, props));
+      }
+      // Error parsing the param file. Need to pass the error object to a stream
+      // in order to get the complete error message that includes information
+      // about the line on which the parse error occurred.
+      catch (const xml_schema::exception& e) {
+        std::stringstream message;
+        message << e;
+        throw runtime_error(message.str());
+      }
+      // get and read all parameters of first level
+      const program_params_type::param_sequence & xmlParams = xml->param();
+      program_params_type::param_const_iterator i_params = xmlParams.begin();
+      while (i_params != xmlParams.end())
+      {
+          ReadParam(string(), *i_params, params);
+          i_params++;
+      }
+
+      // get and process all modules of first level
+      const program_params_type::module_sequence & modules = xml->module();
+      program_params_type::module_const_iterator i_modules = modules.begin();
+      while (i_modules != modules.end())
+      {
+          ReadModule(string(), *i_modules, params);
+          i_modules++;
+      }
+
+      if (!cacheFile.empty())
+        WriteParamCache(cacheFile, programName, xmlContent, schemaContent, params);
     }
 
-    
+    // the values are validated against min and max in any case
+    for (const ParamAttributes & param : params)
+        AddParam(param, desc);
+
+    logger << debug << "Read the configuration file in "
+           << chrono::duration<double, milli>(chrono::steady_clock::now() - start).count()
+           << " ms" << endl;
+
 }
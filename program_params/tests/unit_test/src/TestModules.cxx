@@ -66,4 +66,20 @@ BOOST_AUTO_TEST_CASE( VIA_PARAMS )
    BOOST_CHECK_EQUAL(testBool,   true);
 }
 
+
+////////////////////////////////////////////////////////////////////////////////
+// Asking for a parameters of a module with typed handles
+BOOST_AUTO_TEST_CASE( VIA_HANDLE )
+{
+
+   const ModuleParams moduleParams = m_params->Module("TestModule");
+
+   ParamHandle<int32_t> intHandle  = moduleParams.Handle<int32_t>("IntParam");
+   ParamHandle<bool>    boolHandle = moduleParams.Module("Level2").Handle<bool>("BoolParam");
+
+   BOOST_CHECK_EQUAL(intHandle.Get(),     456);
+   BOOST_CHECK_EQUAL(intHandle.GetName(), "TestModule.IntParam");
+   BOOST_CHECK_EQUAL(boolHandle.Get(),    true);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
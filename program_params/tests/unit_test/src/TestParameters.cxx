@@ -7,6 +7,7 @@
 
 #define BOOST_TEST_MAIN
 #include "boost/test/unit_test.hpp"
+#include "boost/filesystem.hpp"
 
 #include "Logger.hxx"
 #include "ProgramParams.hxx"
@@ -110,5 +111,68 @@ BOOST_AUTO_TEST_CASE( TypeConversion )
  BOOST_CHECK(0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Accessing the parameters with typed handles
+BOOST_AUTO_TEST_CASE( Handles )
+{
+   ParamHandle<int32_t>     intHandle    = m_params->Handle<int32_t>    ("IntParam");
+   ParamHandle<double>      doubleHandle = m_params->Handle<double>     ("DoubleParam");
+   ParamHandle<bool>        boolHandle   = m_params->Handle<bool>       ("BoolParam");
+   ParamHandle<std::string> stringHandle = m_params->Handle<std::string>("StringParam");
+
+   BOOST_CHECK_EQUAL(intHandle.Get(),    456);
+   BOOST_CHECK_EQUAL(doubleHandle.Get(), -0.000165);
+   BOOST_CHECK_EQUAL(boolHandle.Get(),   true);
+   BOOST_CHECK_EQUAL(stringHandle.Get(), "test string");
+   BOOST_CHECK_EQUAL(intHandle.GetName(), "IntParam");
+
+   ParamHandle<std::vector<int>>  intVectorHandle  = m_params->Handle<std::vector<int>> ("IntVectorParam");
+   ParamHandle<std::vector<bool>> boolVectorHandle = m_params->Handle<std::vector<bool>>("BoolVectorParam");
+
+   BOOST_REQUIRE_EQUAL(intVectorHandle.size(), 1);
+   BOOST_CHECK_EQUAL(intVectorHandle[0], 456);
+   BOOST_CHECK_EQUAL(intVectorHandle.data()[0], 456);
+   BOOST_REQUIRE_EQUAL(boolVectorHandle.size(), 1);
+   BOOST_CHECK_EQUAL(boolVectorHandle[0], true);
+
+   BOOST_CHECK_THROW(m_params->Handle<int32_t>("NotDefinedParameter"), std::runtime_error);
+   BOOST_CHECK_THROW(m_params->Handle<double>("IntParam"), std::runtime_error);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The parameter file is read from the cache after the first time
+BOOST_AUTO_TEST_CASE( ParamFileCache )
+{
+   boost::filesystem::path cacheDir("results/params_cache");
+   boost::filesystem::remove_all(cacheDir);
+   setenv("CHEOPS_PARAMS_CACHE", cacheDir.c_str(), 1);
+
+   // the first call writes the cache file, the second one reads it
+   for (int i = 0; i < 2; i++) {
+      ParamsPtr params = CheopsInit(framework::master_test_suite().argc,
+                                    framework::master_test_suite().argv);
+      BOOST_CHECK_EQUAL(params->GetAsInt("IntParam"), 456);
+      BOOST_CHECK_EQUAL(params->GetAsString("StringParam"), "test string");
+      BOOST_CHECK_EQUAL(params->GetAsString("CommandLine"), "CommandLineValue");
+   }
+
+   BOOST_CHECK_EQUAL(std::distance(boost::filesystem::directory_iterator(cacheDir),
+                                   boost::filesystem::directory_iterator()), 1);
+   BOOST_CHECK(boost::filesystem::status(cacheDir).permissions() ==
+               boost::filesystem::owner_all);
+
+   // a directory other users can write to is not used
+   boost::filesystem::remove_all(cacheDir);
+   boost::filesystem::create_directory(cacheDir);
+   boost::filesystem::permissions(cacheDir, boost::filesystem::owner_all |
+                                            boost::filesystem::group_all);
+   ParamsPtr params = CheopsInit(framework::master_test_suite().argc,
+                                 framework::master_test_suite().argv);
+   BOOST_CHECK_EQUAL(params->GetAsInt("IntParam"), 456);
+   BOOST_CHECK(boost::filesystem::is_empty(cacheDir));
+
+   unsetenv("CHEOPS_PARAMS_CACHE");
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
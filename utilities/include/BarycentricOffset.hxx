@@ -6,6 +6,7 @@
  *
  *  @author  Reiner Rohlfs, UGE
  *
+ *  @version 13.2  2026-10-19 agent user-040 copies can be used in parallel threads
  *  @version 9.3 2018-06-04 #16346 improved documentation.
  *  @version 3.2 2015-04-17 RRO first released version
  */
@@ -47,6 +48,8 @@ public:
    /** *************************************************************************
     *  @brief Copy constructor of the BarycentricOffset class.
     *
+    *  Offset() modifies the instance, but copies of an instance can be used
+    *  in parallel threads, one copy per thread.
     */
    BarycentricOffset(const BarycentricOffset & barycentricOffset);
 
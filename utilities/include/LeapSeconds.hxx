@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs, UGE
  *
+ *  @version 13.2  2026-10-19 agent user-040 TimeColumnFiller is a friend class
+ *                             to copy the leap seconds
  *  @version 3.3   2015-05-26 RRO first version
  */
 
@@ -28,8 +30,8 @@
  *  data structure and can return the number of leap seconds that have been
  *  introduced until a specific time.
  *
- *  Currently only the UTC class is using this class to retrieve the number
- *  of leap seconds.
+ *  Currently only the UTC and the TimeColumnFiller classes are using this
+ *  class to retrieve the number of leap seconds.
  */
 class LeapSeconds {
 
@@ -54,6 +56,7 @@ private:
    static int16_t  getNumLeapSeconds(const UTC & utc);
 
 friend class UTC;
+friend class TimeColumnFiller;
 
 public:
 
@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs, UGE
  *
+ *  @version 13.2  2026-10-19 agent user-040 TimeColumnFiller is a friend class
+ *                              to copy the correlation records
  *  @version 10.0.1 2018-08-20  RRO #16725 follow the change of the iOBTUTC
  *                                       of the MOC-SOC ICD 3.3
  *                                       new member: CorrelationRecord:: m_obtTimeStamp
@@ -153,6 +155,7 @@ class OBTUTCCorrelation {
 
    friend class UTC;
    friend class OBT;
+   friend class TimeColumnFiller;
 
 
 public:
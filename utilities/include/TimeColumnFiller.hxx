@@ -0,0 +1,169 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup utilities
+ *  @brief Declaration of the TimeColumnFiller class
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-040 first released version
+ */
+
+#ifndef _TIME_COLUMN_FILLER_HXX_
+#define _TIME_COLUMN_FILLER_HXX_
+
+// first include system header files
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "FitsDalTable.hxx"
+
+// last include the header files of this module
+#include "Obt.hxx"
+#include "BarycentricOffset.hxx"
+
+/** ****************************************************************************
+ *  @brief   Computes the UTC_TIME, MJD_TIME and BJD_TIME columns of a table
+ *           from its OBT_TIME column.
+ *  @ingroup utilities
+ *
+ *  The result of every row is the same as of
+ *  @code
+ *  UTC utc = obt.getUtc();
+ *  MJD mjd = utc.getMjd();
+ *  BJD bjd = mjd + barycentricOffset;
+ *  @endcode
+ *  but the rows are converted in blocks, in several threads. The OBT to UTC
+ *  correlation records and the leap seconds are copied once into sorted
+ *  tables by the constructor, which are then only read by all threads.
+ *  The OBT_TIME column is read with FitsDalTable::ReadRows() and the time
+ *  columns are written with FitsDalTable::UpdateColumns(), no other column
+ *  of the table is read or written.
+ *
+ *  The OBT to UTC correlation files and the leap second files have to be
+ *  defined, i.e. CheopsInit() has to be called, before an instance of this
+ *  class is created.
+ *
+ *  @code
+ *  FitsDalTable table(fileName, "APPEND");
+ *  TimeColumnFiller filler(BarycentricOffset(ra, dec));
+ *  filler.Fill(table);
+ *  @endcode
+ */
+class TimeColumnFiller {
+
+public:
+
+   /// @brief The times of one row, the layout of the user buffer of
+   ///        FitsDalTable::ReadRows() and FitsDalTable::UpdateColumns().
+   struct TimeRow {
+      int64_t m_obt;       ///< OBT_TIME
+      char    m_utc[26];   ///< UTC_TIME, not terminated by 0 if 26 characters long
+      double  m_mjd;       ///< MJD_TIME
+      double  m_bjd;       ///< BJD_TIME
+   };
+
+   /** *************************************************************************
+    *  @brief Copies the conversion tables. The BJD_TIME column is not filled.
+    *
+    *  @param [in] numThreads number of threads, 0 to use one thread per CPU
+    *
+    *  @throw runtime_error if no leap second file or no OBT to UTC
+    *         correlation file is defined.
+    */
+   explicit TimeColumnFiller(unsigned numThreads = 0);
+
+   /** *************************************************************************
+    *  @brief Copies the conversion tables. The BJD_TIME column is filled with
+    *         the offset of @b barycentricOffset.
+    *
+    *  @param [in] barycentricOffset defines the RA / DEC of the target
+    *  @param [in] numThreads        number of threads, 0 to use one thread
+    *                                per CPU
+    *
+    *  @throw runtime_error if no leap second file or no OBT to UTC
+    *         correlation file is defined.
+    */
+   explicit TimeColumnFiller(const BarycentricOffset & barycentricOffset,
+                             unsigned numThreads = 0);
+
+   ~TimeColumnFiller();
+
+   /** *************************************************************************
+    *  @brief Computes the time columns of already written rows of a table.
+    *
+    *  The columns UTC_TIME, MJD_TIME and BJD_TIME are updated if they exist
+    *  in @b table, the other columns are not modified.
+    *
+    *  @param [in] table     table with an OBT_TIME column, opened in CREATE
+    *                        or APPEND mode
+    *  @param [in] firstRow  first row to update, first row in the table = 1
+    *  @param [in] numRows   number of rows to update, by default all rows
+    *                        up to the end of the table
+    *
+    *  @return the number of updated rows
+    *
+    *  @throw runtime_error if the table has no OBT_TIME column, if an OBT is
+    *         outside of the range of the UTC class or on a cfitsio error.
+    */
+   uint64_t Fill(FitsDalTable & table, uint64_t firstRow = 1,
+                 uint64_t numRows = UINT64_MAX);
+
+   /** *************************************************************************
+    *  @brief Converts the m_obt member of @b numRows rows to UTC, MJD and,
+    *         if a BarycentricOffset was passed to the constructor, to BJD.
+    *
+    *  @param [in,out] rows     the times to convert
+    *  @param [in]     numRows  number of rows of @b rows
+    *
+    *  @throw runtime_error if an OBT is outside of the range of the UTC
+    *         class
+    */
+   void Convert(TimeRow * rows, uint64_t numRows);
+
+private:
+
+   /// @brief An OBT to UTC correlation record, with the UTC prepared for
+   ///        UTC::getTtSeconds().
+   struct Correlation {
+      int64_t m_obtTimeStamp;  ///< OBT from where this record is valid, with sync bit set
+      OBT     m_obt;           ///< OBT of the record
+      int64_t m_numDays;       ///< UTC::getNumDays() of the UTC of the record
+      double  m_seconds;       ///< UTC::getDaySeconds() of the UTC of the record
+      bool    m_tt;            ///< true if the UTC of the record is in or after 1977
+      double  m_gradient;      ///< the slope of the correlation
+      double  m_offset;        ///< the offset of the correlation
+   };
+
+   /// @brief A leap second record: number of leap seconds since the UTC
+   struct LeapSecond {
+      std::string m_utc;            ///< the UTC of the leap second
+      int16_t     m_numLeapSeconds; ///< number of leap seconds until m_utc
+   };
+
+   /// Copies the OBT to UTC correlation records and the leap seconds.
+   void InitTables();
+
+   /// Returns the number of leap seconds until the UTC of the string @b utc.
+   int16_t GetNumLeapSeconds(const char * utc) const;
+
+   /// Converts rows of @b rows, using @b barycentricOffset for the BJD.
+   void ConvertRows(TimeRow * rows, uint64_t numRows,
+                    BarycentricOffset * barycentricOffset) const;
+
+   std::vector<Correlation>  m_correlations;  ///< sorted by m_obtTimeStamp
+   std::vector<LeapSecond>   m_leapSeconds;   ///< sorted by m_utc
+
+   /// defines the RA / DEC of the BJD, nullptr if BJD_TIME is not filled
+   std::unique_ptr<BarycentricOffset> m_barycentricOffset;
+
+   /// @brief one copy of m_barycentricOffset per thread except the first
+   ///        thread, BarycentricOffset::Offset() modifies the instance.
+   std::vector<BarycentricOffset> m_threadOffsets;
+
+   unsigned m_numThreads;   ///< number of threads used by Convert()
+};
+
+#endif /* _TIME_COLUMN_FILLER_HXX_ */
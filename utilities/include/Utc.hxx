@@ -6,6 +6,9 @@
  *
  *  @author Reiner Rohlfs, UGE
  *
+ *  @version 13.2 2026-10-19 agent user-040 the conversion steps are public
+ *                                      static functions, used also by the
+ *                                      TimeColumnFiller
  *  @version 5.0  2016-01-25 RRO #9933: new >, >= and <= operators
  *  @version 4.3  2015-10-27 RRO #9302: new +, += and -= operators
  *  @version 3.3  2015-05-07 RRO #8158 const in UTC to string casting
@@ -19,6 +22,7 @@
 
 
 #include <cstdint>
+#include <functional>
 #include <iostream>
 #include <time.h>
 
@@ -300,6 +304,64 @@ public:
     */
    OBT getObt() const;
 
+   /** *************************************************************************
+    *  @brief Returns the number of seconds since the start of the day of
+    *         this UTC, including the leap seconds until this UTC.
+    */
+   double getDaySeconds() const;
+
+   /** *************************************************************************
+    *  @brief Returns the number of days since MJD = 0 of a date.
+    */
+   static int64_t getNumDays(int64_t year, int64_t month, int64_t day);
+
+   /** *************************************************************************
+    *  @brief Returns the number of TT seconds since 1970-01-01T00:00:00 of
+    *         a UTC plus @b deltaSeconds, as used by the + and - operators.
+    *
+    *  @param [in] numDays       getNumDays() of the date of the UTC
+    *  @param [in] daySeconds    getDaySeconds() of the UTC
+    *  @param [in] deltaSeconds  the seconds added to the UTC
+    *  @param [in] tt            true if the year of the UTC is 1977 or later
+    */
+   static double getTtSeconds(int64_t numDays, double daySeconds,
+                              double deltaSeconds, bool tt);
+
+   /** *************************************************************************
+    *  @brief Converts a number of TT seconds since 1970-01-01T00:00:00 into
+    *         a UTC string, as the UTC(time_t, double) constructor.
+    *
+    *  This function does not use any static buffer and can be called by
+    *  several threads at the same time, if @b numLeapSeconds can.
+    *
+    *  @param [in]  seconds         number of seconds since 1970-01-01T00:00:00
+    *  @param [in]  secFraction     additional fraction of a second
+    *  @param [out] utc             the UTC as yyyy-mm-ddThh:mm:ss.ffffff,
+    *                               terminated by 0, at least 27 characters
+    *  @param [out] tm              year, month, day, hour, minute and second
+    *                               of @b utc
+    *  @param [in]  numLeapSeconds  returns the number of leap seconds until
+    *                               a UTC string
+    *
+    *  @return the number of leap seconds until @b utc
+    *
+    *  @throw runtime_error if the UTC is outside of the range of this class
+    */
+   static int16_t formatTtSeconds(time_t seconds, double secFraction,
+                                  char * utc, struct tm & tm,
+                                  const std::function<int16_t (const char *)> & numLeapSeconds);
+
+   /** *************************************************************************
+    *  @brief Returns the MJD of a UTC, as getMjd().
+    *
+    *  @param [in] year, month, day, hour, minute  the UTC
+    *  @param [in] seconds      seconds and fraction of seconds of the UTC
+    *  @param [in] leapSeconds  number of leap seconds until the UTC
+    */
+   static double toMjd(int64_t year, int64_t month, int64_t day,
+                       int64_t hour, int64_t minute, double seconds,
+                       int16_t leapSeconds);
+
 
 };
 
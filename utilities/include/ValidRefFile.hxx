@@ -5,6 +5,11 @@
  *
  *  @author Anja Bekkelien UGE
  *
+ *  @version 13.2   2026-10-19 agent user-043 validity periods read from the
+ *                                        ValidityCatalog, getFile() uses
+ *                                        the ValidityIndex, keeps several
+ *                                        files open and can prefetch the next
+ *                                        file (user-044).
  *  @version 10.0.0 2018-08-02 RRO #16836 Update of the documentation of the method
  *                                        ValidRefFile::getFile().
  *  @version 8.1.1 2017-10-30 RRO #14878 comparison of filename to open a next
@@ -23,11 +28,13 @@
 #ifndef VALIDREFFILE_HXX_
 #define VALIDREFFILE_HXX_
 
+#include <cstdint>
+#include <future>
 #include <list>
 #include <map>
 #include <set>
-
-#include <boost/range/adaptor/reversed.hpp>
+#include <string>
+#include <vector>
 
 #include <FitsDalHeader.hxx>
 #include <Utc.hxx>
@@ -205,6 +212,139 @@ class ValidityPeriod {
 };
 
 
+/** **************************************************************************
+ *  @ingroup utilities
+ *  @brief Provides the validity periods of reference files without opening
+ *         the files that were already read before.
+ *
+ *  The validity period, the archive revision, the processing number and the
+ *  EXTNAME of a file are read from its header the first time the file is
+ *  requested. They are stored in a catalogue in memory and, if a catalogue
+ *  file is defined, in this file, which is shared by all processes using it.
+ *  An entry of the catalogue is used as long as the size and the
+ *  modification time of the file are not changed.\n
+ *  The files that are not in the catalogue are read in parallel threads if
+ *  cfitsio was built reentrant (fits_is_reentrant()), otherwise one after
+ *  the other.
+ *
+ *  The catalogue file is defined by setCatalogFileName() or, if this method
+ *  is not called, by the environment variable CHEOPS_VALIDITY_CATALOG. If
+ *  neither is defined the catalogue is only kept in memory.
+ */
+class ValidityCatalog {
+
+ public:
+
+  /**
+   *  @brief Defines the file in which the catalogue is stored.
+   *
+   *  @param fileName the name of the catalogue file, an empty string to keep
+   *                  the catalogue only in memory. The directory of the file
+   *                  has to exist.
+   */
+  static void setCatalogFileName(const std::string & fileName);
+
+  /**
+   *  @brief Returns the name of the catalogue file, an empty string if the
+   *         catalogue is only kept in memory.
+   */
+  static std::string getCatalogFileName();
+
+  /**
+   *  @brief Returns the validity periods of reference files.
+   *
+   *  @param [in]  fileNames        names of reference files, optionally with
+   *                                the extension in square brackets.
+   *  @param [out] validityPeriods  the validity period of each file, in the
+   *                                order of @b fileNames
+   *  @param [out] extNames         the EXTNAME of each file, in the order of
+   *                                @b fileNames
+   *
+   *  @throws runtime_error if a file not yet in the catalogue cannot be read.
+   */
+  static void getValidityPeriods(const std::list<std::string> & fileNames,
+                                 std::vector<ValidityPeriod> & validityPeriods,
+                                 std::vector<std::string> & extNames);
+};
+
+
+/** **************************************************************************
+ *  @ingroup utilities
+ *  @brief Index of validity periods by time.
+ *
+ *  The start and stop times of all validity periods split the time axis into
+ *  intervals. For every start or stop time and for every interval between
+ *  two of these times the validity period with the highest archive revision
+ *  and processing number is determined once. find() is then a binary search.
+ */
+class ValidityIndex {
+
+ private:
+
+  std::vector<ValidityPeriod> m_validityPeriods; ///< ordered by archive revision and processing number
+  std::vector<UTC>  m_times;          ///< sorted start and stop times of all validity periods
+  std::vector<int>  m_atTime;         ///< index of the period valid at m_times[i], -1 if none
+  std::vector<int>  m_afterTime;      ///< index of the period valid after m_times[i], -1 if none
+
+ public:
+
+  /**
+   *  @brief Builds the index.
+   *
+   *  @param validityPeriods all validity periods.
+   */
+  void build(const std::set<ValidityPeriod> & validityPeriods);
+
+  /**
+   *  @brief Returns the validity period with the highest archive revision and
+   *         processing number that contains @b utc.
+   *
+   *  @param utc a UTC time.
+   *  @return the validity period, nullptr if no validity period contains @b utc.
+   */
+  const ValidityPeriod * find(const UTC & utc) const;
+
+  /**
+   *  @brief Returns the validity period that follows the validity period of
+   *         @b utc, i.e. the first other validity period returned by find()
+   *         for a time after @b utc.
+   *
+   *  @param utc a UTC time.
+   *  @return the validity period, nullptr if there is no other validity
+   *          period after @b utc.
+   */
+  const ValidityPeriod * findNext(const UTC & utc) const;
+};
+
+
+/**
+ *  @brief Returns the memory of the pixels of an image HDU, i.e. of a class
+ *         with a value_type and a GetSize() method returning the length of
+ *         each axis.
+ *  @ingroup utilities
+ */
+template <class HDU>
+auto GetHduMemory(const HDU * hdu, int)
+    -> decltype(hdu->GetSize().size(), sizeof(typename HDU::value_type), uint64_t()) {
+
+  uint64_t numPixels = 1;
+  for (long size : hdu->GetSize()) {
+    numPixels *= size;
+  }
+  return numPixels * sizeof(typename HDU::value_type);
+}
+
+/**
+ *  @brief The memory of a table HDU is not counted, only its rows of the
+ *         current read position are in memory.
+ *  @ingroup utilities
+ */
+template <class HDU>
+uint64_t GetHduMemory(const HDU *, long) {
+  return 0;
+}
+
+
 /** **************************************************************************
  *  @ingroup utilities
  *  @brief This class is used to get the reference file that is applicable for a
@@ -216,6 +356,17 @@ class ValidityPeriod {
  *  @b getFile will return, among those files, the one that is applicable for a
  *  specific UTC time.
  *
+ *  The validity periods of the files are taken from the ValidityCatalog,
+ *  the files are therefore only opened if they are not yet in the catalogue.
+ *
+ *  By default only the file returned last is kept open, as in previous
+ *  versions. With setMaxOpenFiles() several reference files can be kept
+ *  open, for example 4 images and 512 MB. A file that is requested again is
+ *  then not read again. Note that a table returned again keeps its read
+ *  position.\n
+ *  With setPrefetch() the file of the next validity period is opened in a
+ *  background thread while the data times given to getFile() increase, if
+ *  cfitsio was built reentrant.
  */
 template <class HDU>
 class ValidRefFile {
@@ -229,20 +380,80 @@ class ValidRefFile {
    */
   std::set<ValidityPeriod> m_validityPeriods;
 
+  /// @brief The validity periods of m_validityPeriods indexed by time.
+  ValidityIndex m_validityIndex;
+
+  /// @brief An open reference file
+  struct OpenFile {
+    const ValidityPeriod * m_validityPeriod;  ///< the validity period of the file
+    HDU *                  m_hdu;             ///< the opened file
+    uint64_t               m_memory;          ///< memory of the image pixels
+  };
+
   /**
-   *  @brief The currently open reference file.
+   *  @brief The open reference files, the most recently returned one first.
    *
    *  When a reference file for a specific data time is requested, this class
-   *  opens the file and stores a pointer to it in @b m_hdu.
+   *  opens the file and stores a pointer to it at the front of the list.
    *
    *  The file is kept open as long as subsequent requests are within its
-   *  validity period.
+   *  validity period, or as long as it is one of the last m_maxOpenFiles
+   *  returned files.
    *
-   *  If a reference file for a data time that is not within its validity period
-   *  is requested, the file pointed to by @b m_hdu is closed, the new file is
-   *  opened and is assigned to @b m_hdu.
+   *  If more files or more memory than m_maxOpenFiles and m_maxMemory are
+   *  used, the least recently returned files are closed.
    */
-  HDU * m_hdu = nullptr;
+  std::list<OpenFile> m_openFiles;
+
+  /// maximum number of open files
+  size_t   m_maxOpenFiles = 1;
+
+  /// maximum memory of the pixels of the open image files, 0: no limit
+  uint64_t m_maxMemory = 0;
+
+  /// true to open the file of the next validity period in advance
+  bool m_prefetch = false;
+
+  UTC  m_lastDataTime;             ///< the data time of the last getFile()
+  bool m_monotonic = false;        ///< true if the last data times increased
+
+  const ValidityPeriod * m_prefetchPeriod = nullptr;  ///< validity period of m_prefetchHdu
+  std::future<HDU *>     m_prefetchHdu;               ///< the file opened in advance
+
+  /// @brief Closes the least recently returned files, but not the first one,
+  ///        if more than the allowed files or memory are used.
+  void closeOldFiles() {
+
+    uint64_t memory = 0;
+    for (auto & openFile : m_openFiles) {
+      memory += openFile.m_memory;
+    }
+    while (m_openFiles.size() > 1 &&
+           (m_openFiles.size() > m_maxOpenFiles ||
+            (m_maxMemory > 0 && memory > m_maxMemory))) {
+      memory -= m_openFiles.back().m_memory;
+      delete m_openFiles.back().m_hdu;
+      m_openFiles.pop_back();
+    }
+  }
+
+  /// @brief Returns the file opened in advance, nullptr if there is none.
+  ///        A failed prefetch is ignored here, the file is opened again when
+  ///        it is requested.
+  HDU * takePrefetchedFile() {
+
+    HDU * hdu = nullptr;
+    if (m_prefetchHdu.valid()) {
+      try {
+        hdu = m_prefetchHdu.get();
+      }
+      catch (std::exception &) {
+        hdu = nullptr;
+      }
+    }
+    m_prefetchPeriod = nullptr;
+    return hdu;
+  }
 
  public:
 
@@ -254,36 +465,25 @@ class ValidRefFile {
    */
   ValidRefFile(const std::list<std::string> & fileNames) {
 
+    std::vector<ValidityPeriod> validityPeriods;
+    std::vector<std::string> extNames;
+    ValidityCatalog::getValidityPeriods(fileNames, validityPeriods, extNames);
+
     std::string structName;
-    FitsDalHeader * header = nullptr;
     std::pair<std::set<ValidityPeriod>::iterator, bool> returnValue;
 
-    for (auto & fileName : fileNames) {
-      // First iteration, do not check extname
-      if (header == nullptr) {
-        header = new FitsDalHeader(fileName);
-      }
-      // Subsequent iterations, check that the current reference file's extname
-      // is the same as those of the previous reference files
-      else {
-        header = new FitsDalHeader(fileName);
-
-        if (structName != header->GetAttr<std::string>("EXTNAME")) {
-          throw std::runtime_error("Found reference files of different types: ["
-                                   + structName + "], ["
-                                   + header->GetAttr<std::string>("EXTNAME") + "]");
-        }
+    for (size_t i = 0; i < validityPeriods.size(); i++) {
+      // Check that the current reference file's extname is the same as those
+      // of the previous reference files
+      if (i > 0 && structName != extNames[i]) {
+        throw std::runtime_error("Found reference files of different types: ["
+                                 + structName + "], ["
+                                 + extNames[i] + "]");
       }
 
-      structName = header->GetAttr<std::string>("EXTNAME");
-
-      ValidityPeriod vp(header->GetAttr<std::string>("V_STRT_U"),
-                        header->GetAttr<std::string>("V_STOP_U"),
-                        header->GetAttr<int32_t>("ARCH_REV"),
-                        header->GetAttr<int32_t>("PROC_NUM"),
-                        fileName,
-                        header->GetFileName());
+      structName = extNames[i];
 
+      const ValidityPeriod & vp = validityPeriods[i];
       returnValue = m_validityPeriods.insert(vp);
       // The second evaluates to false if the insertion replaced an existing
       // item, meaning a validity time with identical archive revision number
@@ -293,13 +493,12 @@ class ValidRefFile {
         errorMsg.append(std::to_string(vp.getArchRev()));
         errorMsg.append(" and PROC_NUM=");
         errorMsg.append(std::to_string(vp.getProcNum()));
-        errorMsg.append(" (" + returnValue.first->getFileName() + ", " + fileName + ")");
+        errorMsg.append(" (" + returnValue.first->getFileName() + ", " + vp.getFileName() + ")");
         throw std::runtime_error(errorMsg);
       }
-
-      delete header;
     }
 
+    m_validityIndex.build(m_validityPeriods);
   }
 
   /**
@@ -307,8 +506,48 @@ class ValidRefFile {
    */
   ~ValidRefFile() {
 
-    if (m_hdu != nullptr) {
-      delete m_hdu;
+    delete takePrefetchedFile();
+    for (auto & openFile : m_openFiles) {
+      delete openFile.m_hdu;
+    }
+  }
+
+  /**
+   *  @brief Defines how many reference files are kept open.
+   *
+   *  @param maxOpenFiles maximum number of open files, at least the file
+   *                      returned last is kept open.
+   *  @param maxMemory    maximum memory in bytes of the pixels of the open
+   *                      image files, 0 for no limit. The memory of tables
+   *                      is not counted.
+   */
+  void setMaxOpenFiles(size_t maxOpenFiles, uint64_t maxMemory = 0) {
+
+    m_maxOpenFiles = maxOpenFiles;
+    m_maxMemory = maxMemory;
+    closeOldFiles();
+  }
+
+  /**
+   *  @brief Enables the opening of the file of the next validity period in
+   *         advance, in a background thread.
+   *
+   *  The next file is opened when getFile() returns another file than in
+   *  the previous call and the data time is later than the one of the
+   *  previous call. The file opened in
+   *  advance is added to the open files, see setMaxOpenFiles(), when it is
+   *  returned by getFile().\n
+   *  The prefetch is not enabled if cfitsio was not built reentrant
+   *  (fits_is_reentrant()), as the background thread opens the file while
+   *  the calling thread may use cfitsio.
+   *
+   *  @param prefetch true to open the next file in advance.
+   */
+  void setPrefetch(bool prefetch) {
+
+    m_prefetch = prefetch && fits_is_reentrant();
+    if (!prefetch) {
+      delete takePrefetchedFile();
     }
   }
 
@@ -337,27 +576,62 @@ class ValidRefFile {
    */
   HDU * getFile(const UTC & dataTime) {
 
-    // Iterate over the reference files' validity periods, starting with the
-    // most recently created file, to find the file containing the specific data time.
-    for (auto validityPeriod : boost::adaptors::reverse(m_validityPeriods)) {
+    m_monotonic = m_lastDataTime < dataTime;
+    m_lastDataTime = dataTime;
 
-      if (!validityPeriod.contains(dataTime)) {
-        continue;
-      }
+    // The validity period of the file with the highest archive revision and
+    // processing number containing the specific data time.
+    const ValidityPeriod * validityPeriod = m_validityIndex.find(dataTime);
+
+    if (validityPeriod != nullptr) {
       // Found the right validity period
 
-      // First time opening an HDU after this object was created
-      if (m_hdu == nullptr) {
-        m_hdu = new HDU(validityPeriod.getFileName());
+      // Still the same HDU as in the previous call
+      if (!m_openFiles.empty() &&
+          (m_openFiles.front().m_validityPeriod == validityPeriod ||
+           m_openFiles.front().m_hdu->GetFileName() == validityPeriod->getBaseFileName())) {
+        return m_openFiles.front().m_hdu;
+      }
+
+      // An HDU returned before, which is still open ?
+      auto i_openFile = m_openFiles.begin();
+      while (i_openFile != m_openFiles.end() &&
+             i_openFile->m_hdu->GetFileName() != validityPeriod->getBaseFileName()) {
+        ++i_openFile;
+      }
+      if (i_openFile != m_openFiles.end()) {
+        m_openFiles.splice(m_openFiles.begin(), m_openFiles, i_openFile);
       }
-      // Need to switch to another HDU ?
-      else if (m_hdu->GetFileName() != validityPeriod.getBaseFileName()) {
-        HDU * old_hdu = m_hdu;
-        m_hdu = new HDU(validityPeriod.getFileName());
-        delete old_hdu;
+      else {
+        // The HDU opened in advance, or a new HDU
+        HDU * hdu = nullptr;
+        if (m_prefetchPeriod == validityPeriod) {
+          hdu = takePrefetchedFile();
+        }
+        if (hdu == nullptr) {
+          hdu = new HDU(validityPeriod->getFileName());
+        }
+        m_openFiles.push_front({validityPeriod, hdu, GetHduMemory(hdu, 0)});
+        closeOldFiles();
+      }
+
+      // Open the file of the next validity period in advance
+      if (m_prefetch && m_monotonic) {
+        const ValidityPeriod * nextPeriod = m_validityIndex.findNext(dataTime);
+        bool isOpen = false;
+        for (auto & openFile : m_openFiles) {
+          isOpen = isOpen || openFile.m_validityPeriod == nextPeriod;
+        }
+        if (nextPeriod != nullptr && !isOpen && nextPeriod != m_prefetchPeriod) {
+          delete takePrefetchedFile();
+          m_prefetchPeriod = nextPeriod;
+          std::string fileName = nextPeriod->getFileName();
+          m_prefetchHdu = std::async(std::launch::async,
+                                     [fileName]() { return new HDU(fileName); });
+        }
       }
 
-      return m_hdu;
+      return m_openFiles.front().m_hdu;
     }
 
     // No reference file found
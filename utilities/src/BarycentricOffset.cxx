@@ -6,6 +6,11 @@
  *
  *  @author David Futyan, UGE
  *
+ *  @version 13.2  2026-10-19 agent user-040 copies of an instance can be used
+ *                             in parallel threads: the ephemeris file is read
+ *                             under a mutex, no static variables in the
+ *                             calculation and the copy constructor keeps
+ *                             m_initialized
  *  @version 9.1  2018-02-09 RRO #15456 BJD is related to JD and not to
  *                               modified JD, i.e. an offset of 2400000.5 is
  *                               applied.
@@ -17,6 +22,7 @@
 #include <time.h>
 #include <iomanip>
 #include <cmath>
+#include <mutex>
 
 // third include the data model header files
 #include "FitsDalTable.hxx"
@@ -31,6 +37,10 @@ using namespace std;
 
 string BarycentricOffset::m_ephemerisFilename;
 
+/// serializes the reading of the ephemeris file by instances used in
+/// different threads
+static mutex s_ephemerisFileMutex;
+
 #define SCALAR_PRODUCT(A, B)        (A[0]*B[0] + A[1]*B[1] + A[2]*B[2])
 
 /*****************************************************************************/
@@ -90,7 +100,8 @@ BarycentricOffset::BarycentricOffset(const BarycentricOffset & barycentricOffset
     m_baryAUfac     = barycentricOffset.m_baryAUfac;
     m_baryVELfac    = barycentricOffset.m_baryVELfac;
 
-	m_initialized = true;
+	// the ephemeris constants are only copied if they were already read
+	m_initialized = barycentricOffset.m_initialized;
     m_oldrow=-1;
 }
 
@@ -161,6 +172,8 @@ void BarycentricOffset::initBarycent() {
 
 	double clight,timex;
 
+	lock_guard<mutex> lock(s_ephemerisFileMutex);
+
 	// Open the DE200 ephemeris file and read the physical constant from DE1
 	FitsDalTable * de200_de1 = new FitsDalTable(m_ephemerisFilename,"READONLY");
 	de200_de1->Assign("Cname", &Cname_temp, 6);
@@ -298,7 +311,7 @@ void BarycentricOffset::getDE200(BODY body,
 			   double   vel[3]) {
 
 	long newrow;
-	static double time_1=0.0;
+	double time_1;
 	double time_2,temp_time,dtime1,tc,twot,vfac,pc[18],vc[18];
 	int intnum,i,j,np;
 	vector<double>::iterator bufptr;
@@ -316,6 +329,8 @@ void BarycentricOffset::getDE200(BODY body,
 
 	if (newrow!=m_oldrow) {
 
+		lock_guard<mutex> lock(s_ephemerisFileMutex);
+
 	    // Open the DE200 ephemeris file
 		FitsDalTable * de200 = new FitsDalTable(m_ephemerisFilename,"READONLY");
 		FitsDalTable * de200_de3 = new FitsDalTable(de200->GetFileName() + "[EXT_APP_DE3]");
@@ -500,10 +515,10 @@ double BarycentricOffset::TimeConvert_BaryCenter_Correction(
 
 double BarycentricOffset::TimeConvert_Difference_TTtoTDB(double tt_mjd) const {
 
-  static long oldday=0;
+  static thread_local long oldday=0;
   long day;
-  static double tdbtdt;
-  static double tdbtdtdot;
+  static thread_local double tdbtdt;
+  static thread_local double tdbtdtdot;
 
   day=TIMECONVERT_INT_MJD_TO_JD + (int) tt_mjd;
 
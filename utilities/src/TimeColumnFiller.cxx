@@ -0,0 +1,269 @@
+/** ****************************************************************************
+ *  @file
+ *
+ *  @ingroup utilities
+ *  @brief Implementation of the TimeColumnFiller class
+ *
+ *  @author agent
+ *
+ *  @version 13.2  2026-10-19 agent user-040 first released version
+ */
+
+// first include system header files
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <time.h>
+
+// third include the data model header files
+#include "FitsDalTable.hxx"
+
+// last include the header files of this module
+#include "TimeColumnFiller.hxx"
+#include "Utc.hxx"
+#include "DeltaTime.hxx"
+#include "LeapSeconds.hxx"
+#include "ObtUtcCorrelation.hxx"
+
+using namespace std;
+
+/// number of rows read, converted and written at once by Fill()
+static const uint64_t FILL_BLOCK_ROWS = 65536;
+
+/// minimum number of rows converted by one thread
+static const uint64_t MIN_THREAD_ROWS = 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+TimeColumnFiller::TimeColumnFiller(unsigned numThreads)
+   : m_numThreads(numThreads) {
+
+   if (m_numThreads == 0)
+      m_numThreads = max(1u, thread::hardware_concurrency());
+
+   InitTables();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimeColumnFiller::TimeColumnFiller(const BarycentricOffset & barycentricOffset,
+                                   unsigned numThreads)
+   : m_barycentricOffset(new BarycentricOffset(barycentricOffset)),
+     m_numThreads(numThreads) {
+
+   if (m_numThreads == 0)
+      m_numThreads = max(1u, thread::hardware_concurrency());
+
+   InitTables();
+
+   m_threadOffsets.reserve(m_numThreads - 1);
+   for (unsigned numThread = 1; numThread < m_numThreads; numThread++)
+      m_threadOffsets.push_back(*m_barycentricOffset);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+TimeColumnFiller::~TimeColumnFiller() {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimeColumnFiller::InitTables() {
+
+   if (LeapSeconds::m_leapSeconds.size() == 0)
+      throw runtime_error("There is no leap second file defined (SOC_APP_LeapSeconds)");
+
+   for (const auto & leapSecond : LeapSeconds::m_leapSeconds)
+      m_leapSeconds.push_back(LeapSecond{leapSecond.first.getUtc(), leapSecond.second});
+
+   // the records are sorted by OBT, as by OBTUTCCorrelation::getUtc()
+   OBTUTCCorrelation::CorrelationRecord::SetSearchTime(
+         OBTUTCCorrelation::CorrelationRecord::S_OBT);
+   if (OBTUTCCorrelation::m_correlationRecords.size() == 0)
+      OBTUTCCorrelation::ReadCorrelationRecords();
+   if (OBTUTCCorrelation::m_correlationRecords.size() == 0)
+      throw runtime_error("There is no OBT - UTC Correlation File defined.");
+
+   for (const auto & record : OBTUTCCorrelation::m_correlationRecords) {
+
+      // the arguments of UTC::getTtSeconds(), as used by UTC::operator+()
+      const UTC & utc = record.m_utc;
+      Correlation correlation;
+      correlation.m_obtTimeStamp = record.m_obtTimeStamp.getObt() | 0x01LL;
+      correlation.m_obt          = record.m_obt;
+      correlation.m_numDays      = UTC::getNumDays(utc.getYear(), utc.getMonth(), utc.getDay());
+      correlation.m_seconds      = utc.getDaySeconds();
+      correlation.m_tt           = utc.getYear() >= 1977;
+      correlation.m_gradient     = record.m_gradient;
+      correlation.m_offset       = record.m_offset;
+      m_correlations.push_back(correlation);
+   }
+
+   stable_sort(m_correlations.begin(), m_correlations.end(),
+               [](const Correlation & correlation1, const Correlation & correlation2)
+                  {return correlation1.m_obtTimeStamp < correlation2.m_obtTimeStamp;});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int16_t TimeColumnFiller::GetNumLeapSeconds(const char * utc) const {
+
+   // the last leap second at or before utc, as LeapSeconds::getNumLeapSeconds()
+   vector<LeapSecond>::const_iterator i_leapSecond =
+         upper_bound(m_leapSeconds.begin(), m_leapSeconds.end(), utc,
+                     [](const char * time, const LeapSecond & leapSecond)
+                        {return leapSecond.m_utc.compare(time) > 0;});
+
+   if (i_leapSecond == m_leapSeconds.begin())
+      // we are before the first leap second
+      return 0;
+
+   return (--i_leapSecond)->m_numLeapSeconds;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimeColumnFiller::ConvertRows(TimeRow * rows, uint64_t numRows,
+                                   BarycentricOffset * barycentricOffset) const {
+
+   const function<int16_t (const char *)> numLeapSeconds =
+         [this](const char * utc) { return GetNumLeapSeconds(utc); };
+
+   for (uint64_t numRow = 0; numRow < numRows; numRow++) {
+
+      TimeRow & row = rows[numRow];
+
+      // OBT -> UTC: the correlation record valid for the OBT,
+      // as OBTUTCCorrelation::getUtc()
+      int64_t obt = row.m_obt | 0x01LL;
+      vector<Correlation>::const_iterator i_correlation =
+            upper_bound(m_correlations.begin(), m_correlations.end(), obt,
+                        [](int64_t time, const Correlation & correlation)
+                           {return time < correlation.m_obtTimeStamp;});
+      if (i_correlation != m_correlations.begin())
+         i_correlation--;
+
+      double obtSeconds;
+      int64_t corrObt = i_correlation->m_obt.getObt();
+      if ((row.m_obt & 0xFFFF000000000000LL) == (corrObt & 0xFFFF000000000000LL))
+         // identical reset counter, as OBT::operator-()
+         obtSeconds = (obt - (corrObt | 0x01LL)) / double(0x10000);
+      else
+         obtSeconds = (OBT(row.m_obt) - i_correlation->m_obt).getSeconds();
+
+      double deltaSeconds = obtSeconds * i_correlation->m_gradient + i_correlation->m_offset;
+
+      // UTC::operator+()
+      double seconds = UTC::getTtSeconds(i_correlation->m_numDays, i_correlation->m_seconds,
+                                         deltaSeconds, i_correlation->m_tt);
+
+      // UTC::UTC(time_t, double)
+      time_t numSeconds = seconds;
+      char utc[32];
+      struct tm tm;
+      int16_t leapSeconds = UTC::formatTtSeconds(numSeconds, seconds - numSeconds,
+                                                 utc, tm, numLeapSeconds);
+      memcpy(row.m_utc, utc, sizeof(row.m_utc));
+
+      // UTC::getMjd()
+      double mjd = UTC::toMjd(tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+                              tm.tm_hour, tm.tm_min,
+                              tm.tm_sec + strtod(utc + 19, nullptr), leapSeconds);
+      row.m_mjd = mjd;
+
+      // MJD::operator+(BarycentricOffset &)
+      if (barycentricOffset)
+         row.m_bjd = mjd + barycentricOffset->Offset(mjd);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void TimeColumnFiller::Convert(TimeRow * rows, uint64_t numRows) {
+
+   uint64_t numThreads = min<uint64_t>(m_numThreads,
+                                       (numRows + MIN_THREAD_ROWS - 1) / MIN_THREAD_ROWS);
+   if (numThreads <= 1) {
+      ConvertRows(rows, numRows, m_barycentricOffset.get());
+      return;
+   }
+
+   // the first part is converted by this thread, the others in new threads
+   uint64_t threadRows = (numRows + numThreads - 1) / numThreads;
+   vector<exception_ptr> exceptions(numThreads);
+   vector<thread> threads;
+   for (uint64_t numThread = 1; numThread < numThreads; numThread++) {
+      uint64_t firstRow = numThread * threadRows;
+      if (firstRow >= numRows)
+         break;
+      uint64_t rowsOfThread = min(threadRows, numRows - firstRow);
+      BarycentricOffset * offset = m_barycentricOffset ? &m_threadOffsets[numThread - 1] : nullptr;
+
+      threads.push_back(thread([this, rows, firstRow, rowsOfThread, offset, numThread, &exceptions]() {
+         try {
+            ConvertRows(rows + firstRow, rowsOfThread, offset);
+         }
+         catch (...) {
+            exceptions[numThread] = current_exception();
+         }
+      }));
+   }
+
+   try {
+      ConvertRows(rows, threadRows, m_barycentricOffset.get());
+   }
+   catch (...) {
+      exceptions[0] = current_exception();
+   }
+
+   for (thread & convertThread : threads)
+      convertThread.join();
+
+   for (const exception_ptr & exception : exceptions)
+      if (exception)
+         rethrow_exception(exception);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+uint64_t TimeColumnFiller::Fill(FitsDalTable & table, uint64_t firstRow, uint64_t numRows) {
+
+   vector<FitsColBuffer> obtColumn;
+   vector<FitsColBuffer> timeColumns;
+   for (const FitsColMetaData & colMetaData : table.GetFitsColMetaData()) {
+      if (colMetaData.m_colName == "OBT_TIME")
+         obtColumn.push_back(FitsColBuffer("OBT_TIME", col_int64, 1, offsetof(TimeRow, m_obt)));
+      else if (colMetaData.m_colName == "UTC_TIME")
+         timeColumns.push_back(FitsColBuffer("UTC_TIME", col_string, 26, offsetof(TimeRow, m_utc)));
+      else if (colMetaData.m_colName == "MJD_TIME")
+         timeColumns.push_back(FitsColBuffer("MJD_TIME", col_double, 1, offsetof(TimeRow, m_mjd)));
+      else if (colMetaData.m_colName == "BJD_TIME" && m_barycentricOffset)
+         timeColumns.push_back(FitsColBuffer("BJD_TIME", col_double, 1, offsetof(TimeRow, m_bjd)));
+   }
+
+   if (obtColumn.empty())
+      throw runtime_error("Failed to fill the time columns of table " + table.GetFileName() +
+                          ", the table has no OBT_TIME column.");
+
+   if (firstRow == 0)
+      firstRow = 1;
+   uint64_t tableLength = table.GetNumRows();
+   if (timeColumns.empty() || firstRow > tableLength)
+      return 0;
+   if (numRows > tableLength - firstRow + 1)
+      numRows = tableLength - firstRow + 1;
+
+   vector<TimeRow> rows(min(FILL_BLOCK_ROWS, numRows));
+
+   uint64_t row = 0;
+   while (row < numRows) {
+
+      uint64_t blockRows = min(FILL_BLOCK_ROWS, numRows - row);
+
+      table.ReadRows(firstRow + row, blockRows, obtColumn, rows.data(), sizeof(TimeRow));
+      Convert(rows.data(), blockRows);
+      table.UpdateColumns(firstRow + row, blockRows, timeColumns, rows.data(), sizeof(TimeRow));
+
+      row += blockRows;
+   }
+
+   return numRows;
+}
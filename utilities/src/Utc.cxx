@@ -6,6 +6,9 @@
  *
  *  @author Reiner Rohlfs, UGE
  *
+ *  @version 13.2 2026-10-19 agent user-040 the conversion steps are public
+ *                                      static functions, used also by the
+ *                                      TimeColumnFiller
  *  @version 9.2  2018-10-11 RRO #17327 the offset of 32.184 shall not applied
  *                                      for UTC times before 1977
  *  @version 8.0  2017-08-03 RRO #14321 include in the tests the rounding offset
@@ -52,7 +55,8 @@ static string MONTH_NAME[13] = {
       "December"
 };
 
-static int64_t getNumDays(int64_t year, int64_t month, int64_t day) {
+////////////////////////////////////////////////////////////////////////////////
+int64_t UTC::getNumDays(int64_t year, int64_t month, int64_t day) {
 
    // number of days since MJD = 0
    // code taken from INTEGRAL DAL3GEN
@@ -117,6 +121,40 @@ UTC::UTC(uint16_t year, uint8_t month, uint8_t day,
 ////////////////////////////////////////////////////////////////////////////////
 UTC::UTC(time_t seconds, double secFraction) {
 
+   char utc[32];
+   struct tm tm;
+   formatTtSeconds(seconds, secFraction, utc, tm,
+                   [this](const char * time) {
+                      m_utc = time;
+                      return LeapSeconds::getNumLeapSeconds(*this);
+                   });
+   m_utc = utc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// formats the UTC string like UTC::init()
+static void formatUtc(char * utc, const struct tm & tm, double secFraction) {
+
+   if (tm.tm_year + 1900 < 1970 || tm.tm_year + 1900 > 2037)
+      throw runtime_error("The year of a utc has to be in the range from 1970 to 2037."
+                          " UTC - constructor found " + to_string(tm.tm_year + 1900) );
+
+   // #14321 In the next sprintf function a rounding offset of 0.0000005 is added
+   if (secFraction >= 1.0 || secFraction < -0.0000005)
+      throw runtime_error("The fraction of a second of a utc has to be less than 1.0."
+                           " UTC - constructor found " + to_string(secFraction) );
+
+   sprintf(utc, "%04hu-%02hhu-%02hhuT%02hhu:%02hhu:%02hhu.%06d",
+           uint16_t(tm.tm_year + 1900), uint8_t(tm.tm_mon + 1), uint8_t(tm.tm_mday),
+           uint8_t(tm.tm_hour), uint8_t(tm.tm_min), uint8_t(tm.tm_sec),
+           int32_t(secFraction * 1000000 + 0.5));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int16_t UTC::formatTtSeconds(time_t seconds, double secFraction,
+                             char * utc, struct tm & tm,
+                             const function<int16_t (const char *)> & numLeapSeconds) {
+
    // transform TT time into TAI if the time is after 1. 1. 1977
    // 1. 1. 1977 = 2557 days * 86400 sec / day = 220924800 sec
    if (seconds >=  220924800) {
@@ -132,40 +170,38 @@ UTC::UTC(time_t seconds, double secFraction) {
 
    // assume first that TAI - UTC = 0 and get number of leap seconds,
    // which may be wrong by 1
-   struct tm * ptm1 = gmtime(&seconds);
-   init(ptm1->tm_year + 1900, ptm1->tm_mon+1, ptm1->tm_mday,
-        ptm1->tm_hour, ptm1->tm_min, ptm1->tm_sec, secFraction);
+   gmtime_r(&seconds, &tm);
+   formatUtc(utc, tm, secFraction);
 
-   int16_t leapSeconds1 = LeapSeconds::getNumLeapSeconds(*this);
+   int16_t leapSeconds1 = numLeapSeconds(utc);
 
    // now TAI - UTC = leapseconds
    seconds -= leapSeconds1;
-   struct tm * ptm2 = gmtime(&seconds);
-   init(ptm2->tm_year + 1900, ptm2->tm_mon+1, ptm2->tm_mday,
-        ptm2->tm_hour, ptm2->tm_min, ptm2->tm_sec, secFraction);
+   gmtime_r(&seconds, &tm);
+   formatUtc(utc, tm, secFraction);
 
    // test again number of leap second
-   int16_t leapSeconds2 = LeapSeconds::getNumLeapSeconds(*this);
+   int16_t leapSeconds2 = numLeapSeconds(utc);
 
    if (leapSeconds1 != leapSeconds2) {
       // the previously derived number of leap seconds was indeed wrong
       // take the correct number of leap seconds
       seconds = seconds + leapSeconds1 - leapSeconds2;
-      ptm2 = gmtime(&seconds);
-      if(ptm2->tm_min == 0 &&ptm2->tm_sec == 0) {
+      gmtime_r(&seconds, &tm);
+      if(tm.tm_min == 0 && tm.tm_sec == 0) {
          // we are exactly at a leap second
          // reduce the seconds by 1 for the gmtime function and
          // increase the tm_sec by 1, which will become 60
          seconds -= 1;
-         ptm2 = gmtime(&seconds);
-         ptm2->tm_sec +=1;
+         gmtime_r(&seconds, &tm);
+         tm.tm_sec +=1;
       }
 
-      init(ptm2->tm_year + 1900, ptm2->tm_mon+1, ptm2->tm_mday,
-           ptm2->tm_hour, ptm2->tm_min, ptm2->tm_sec, secFraction);
+      formatUtc(utc, tm, secFraction);
+      leapSeconds2 = numLeapSeconds(utc);
    }
 
-
+   return leapSeconds2;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -216,13 +252,8 @@ DeltaTime UTC::operator - (const UTC & utc) const {
    int64_t thisNumDays = getNumDays(getYear(), getMonth(), getDay());
    int64_t inNumDays   = getNumDays(utc.getYear(), utc.getMonth(), utc.getDay());
 
-   double thisNumSeconds = getHour() * 3600.0 + getMinute() * 60.0 +
-                           getSecond() + getSecFraction() +
-                           LeapSeconds::getNumLeapSeconds(*this);
-
-   double inNumSeconds   = utc.getHour() * 3600.0 + utc.getMinute() * 60.0 +
-                           utc.getSecond() + utc.getSecFraction() +
-                           LeapSeconds::getNumLeapSeconds(utc);
+   double thisNumSeconds = getDaySeconds();
+   double inNumSeconds   = utc.getDaySeconds();
 
    return DeltaTime( (thisNumDays - inNumDays) * 86400.0 +
                      thisNumSeconds - inNumSeconds);
@@ -232,21 +263,9 @@ DeltaTime UTC::operator - (const UTC & utc) const {
 ////////////////////////////////////////////////////////////////////////////////
 UTC UTC::operator + (const DeltaTime & deltaTime) const {
 
-   int64_t numDays = getNumDays(getYear(), getMonth(), getDay());
-
-
-   // number of days since 1. 1. 1970
-   numDays -= 40587;
-
-   double seconds = getHour() * 3600.0 + getMinute() * 60.0 +
-                    getSecond() + getSecFraction() +
-                    LeapSeconds::getNumLeapSeconds(*this);
-
-   seconds += numDays * 86400.0 + deltaTime.getSeconds();
-
-   if (getYear() >= 1977)
-      // the 32.184 sec are introduced 1. 1. 1977
-      seconds += 32.184;
+   double seconds = getTtSeconds(getNumDays(getYear(), getMonth(), getDay()),
+                                 getDaySeconds(), deltaTime.getSeconds(),
+                                 getYear() >= 1977);
 
    time_t numSeconds = seconds;
 
@@ -257,21 +276,9 @@ UTC UTC::operator + (const DeltaTime & deltaTime) const {
 ////////////////////////////////////////////////////////////////////////////////
 UTC UTC::operator - (const DeltaTime & deltaTime) const {
 
-   int64_t numDays = getNumDays(getYear(), getMonth(), getDay());
-
-   // number of days since 1. 1. 1970
-   numDays -= 40587;
-
-   double seconds = getHour() * 3600.0 + getMinute() * 60.0 +
-                    getSecond() + getSecFraction() +
-                    LeapSeconds::getNumLeapSeconds(*this);
-
-   seconds += numDays * 86400.0 - deltaTime.getSeconds();
-
-   if (getYear() >= 1977)
-      // the 32.184 sec are introduced 1. 1. 1977
-      seconds += 32.184;
-
+   double seconds = getTtSeconds(getNumDays(getYear(), getMonth(), getDay()),
+                                 getDaySeconds(), -deltaTime.getSeconds(),
+                                 getYear() >= 1977);
 
    time_t numSeconds = seconds;
 
@@ -282,21 +289,9 @@ UTC UTC::operator - (const DeltaTime & deltaTime) const {
 ////////////////////////////////////////////////////////////////////////////////
 UTC & UTC::operator += (const DeltaTime & deltaTime) {
 
-   int64_t numDays = getNumDays(getYear(), getMonth(), getDay());
-
-   // number of days since 1. 1. 1970
-   numDays -= 40587;
-
-   double seconds = getHour() * 3600.0 + getMinute() * 60.0 +
-                    getSecond() + getSecFraction() +
-                    LeapSeconds::getNumLeapSeconds(*this);
-
-   seconds += numDays * 86400.0 + deltaTime.getSeconds();
-
-   if (getYear() >= 1977)
-      // the 32.184 sec are introduced 1. 1. 1977
-      seconds += 32.184;
-
+   double seconds = getTtSeconds(getNumDays(getYear(), getMonth(), getDay()),
+                                 getDaySeconds(), deltaTime.getSeconds(),
+                                 getYear() >= 1977);
 
    time_t numSeconds = seconds;
 
@@ -308,20 +303,9 @@ UTC & UTC::operator += (const DeltaTime & deltaTime) {
 ////////////////////////////////////////////////////////////////////////////////
 UTC & UTC::operator -= (const DeltaTime & deltaTime) {
 
-   int64_t numDays = getNumDays(getYear(), getMonth(), getDay());
-
-   // number of days since 1. 1. 1970
-   numDays -= 40587;
-
-   double seconds = getHour() * 3600.0 + getMinute() * 60.0 +
-                    getSecond() + getSecFraction() +
-                    LeapSeconds::getNumLeapSeconds(*this);
-
-   seconds += numDays * 86400.0 - deltaTime.getSeconds();
-
-   if (getYear() >= 1977)
-      // the 32.184 sec are introduced 1. 1. 1977
-      seconds += 32.184;
+   double seconds = getTtSeconds(getNumDays(getYear(), getMonth(), getDay()),
+                                 getDaySeconds(), -deltaTime.getSeconds(),
+                                 getYear() >= 1977);
 
    time_t numSeconds = seconds;
 
@@ -354,34 +338,51 @@ std::string UTC::getFileNamePattern() const {
 ////////////////////////////////////////////////////////////////////////////////
 MJD UTC::getMjd() const {
 
-   int64_t year = getYear();
-   int64_t month = getMonth();
-   int64_t day   = getDay();
+   return MJD(toMjd(getYear(), getMonth(), getDay(), getHour(), getMinute(),
+                    getSecond() + getSecFraction(),
+                    LeapSeconds::getNumLeapSeconds(*this)));
+}
 
-   // number of days since MJD = 0
-   // code taken from INTEGRAL DAL3GEN
+////////////////////////////////////////////////////////////////////////////////
+double UTC::toMjd(int64_t year, int64_t month, int64_t day,
+                  int64_t hour, int64_t minute, double seconds,
+                  int16_t leapSeconds) {
 
-   /* The algorithm is taken directly from Fliegel and Van Falndern           */
-   /* (1968): "Explanatory Supplement to the Astronomical Almanac"            */
+   double mjd = getNumDays(year, month, day);
+   /// 32.184 is the delay between TT and TAI time system
+   mjd += hour / 24.0 + minute / 1440.0 +
+          (seconds + leapSeconds +
+                ((year >= 1977) ? 32.184 : 0.0)) / 86400.0;
 
-   int64_t j1 = 1461*(year + 4800 + (month - 14)/12)/4;
-   int64_t j2 = 367*(month - 2 - (month - 14)/12*12)/12;
-   int64_t j3 = 3*((year + 4900 + (month - 14)/12)/100)/4;
-   // it is 2400001 and not 240000.5 because the algorithm assumes 12h00
-   // and not midnight (comment taken from DAL3Gen of INTEGRAL code)
-   int64_t numDays = (day - 32075 + j1 + j2 - j3) - 2400001;
+   return mjd;
+}
 
-   int16_t leapSeconds = LeapSeconds::getNumLeapSeconds(*this);
+////////////////////////////////////////////////////////////////////////////////
+double UTC::getDaySeconds() const {
 
-   double mjd = numDays;
-   /// 32.184 is the delay between TT and TAI time system
-   mjd += getHour() / 24.0 + getMinute() / 1440.0 +
-          (getSecond()+getSecFraction() + leapSeconds +
-                ((year >= 1977) ? 32.184 : 0.0)) / 86400.0;
+   return getHour() * 3600.0 + getMinute() * 60.0 +
+          getSecond() + getSecFraction() +
+          LeapSeconds::getNumLeapSeconds(*this);
+}
 
-   return MJD(mjd);
+////////////////////////////////////////////////////////////////////////////////
+double UTC::getTtSeconds(int64_t numDays, double daySeconds,
+                         double deltaSeconds, bool tt) {
+
+   // number of days since 1. 1. 1970
+   numDays -= 40587;
+
+   double seconds = daySeconds;
+   seconds += numDays * 86400.0 + deltaSeconds;
+
+   if (tt)
+      // the 32.184 sec are introduced 1. 1. 1977
+      seconds += 32.184;
+
+   return seconds;
 }
 
+////////////////////////////////////////////////////////////////////////////////
 OBT UTC::getObt() const {
    return OBTUTCCorrelation::getObt(*this);
 }
@@ -5,12 +5,28 @@
  *
  *  @author Anja Bekkelien UGE
  *  
+ *  @version 13.2 2026-10-19 agent user-043 ValidityCatalog and ValidityIndex,
+ *                                     open files and prefetch (user-044)
  *  @version 7.4 2017-06-01 ABE #14081 Order files by archive revision and
  *                                     processing number instead of by creation
  *                                     time.
  *  @version 3.2 2015-04-14 ABE        First version.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#include <limits.h>
 
 #include "ValidRefFile.hxx"
 
@@ -61,3 +77,362 @@ bool ValidityPeriod::contains(const UTC utc) const {
   return (m_validityStart == utc || m_validityStart < utc) &&
          (utc == m_validityStop || utc < m_validityStop);
 }
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Class ValidityCatalog
+//
+////////////////////////////////////////////////////////////////////////////////
+
+/// maximum number of threads reading the headers of the reference files
+static const unsigned MAX_SCAN_THREADS = 16;
+
+/// @brief Minimum age in ns of a file to be stored in the catalogue. A file
+///        changed again within the resolution of the modification time
+///        would otherwise keep its catalogue entry.
+static const int64_t MIN_FILE_AGE = 2000000000;
+
+/// The keywords of a reference file, stored in the catalogue
+struct CatalogEntry {
+  int64_t     m_size;       ///< size of the file in bytes
+  int64_t     m_mtime;      ///< modification time of the file in ns
+  std::string m_extName;    ///< EXTNAME
+  std::string m_start;      ///< V_STRT_U
+  std::string m_stop;       ///< V_STOP_U
+  int32_t     m_archRev;    ///< ARCH_REV
+  int32_t     m_procNum;    ///< PROC_NUM
+};
+
+static std::mutex  s_catalogMutex;          ///< protects all following variables
+static bool        s_catalogFileNameSet = false;
+static std::string s_catalogFileName;
+static int64_t     s_catalogFileMtime = -1; ///< of the catalogue file when it was read
+static std::map<std::string, CatalogEntry> s_catalog;  ///< by the key of the file
+
+/// Returns the file name without the extension in square brackets.
+static std::string RootName(const std::string & fileName) {
+
+  std::vector<char> url(fileName.begin(), fileName.end());
+  url.push_back(0);
+  char rootName[FLEN_FILENAME];
+  int status = 0;
+  fits_parse_rootname(url.data(), rootName, &status);
+  return status == 0 ? std::string(rootName) : fileName;
+}
+
+/// Returns the size and the modification time of a file, false if the file
+/// does not exist.
+static bool FileStat(const std::string & fileName, int64_t & size, int64_t & mtime) {
+
+  struct stat fileStat;
+  if (stat(fileName.c_str(), &fileStat) != 0) {
+    return false;
+  }
+  size  = fileStat.st_size;
+  mtime = int64_t(fileStat.st_mtim.tv_sec) * 1000000000 + fileStat.st_mtim.tv_nsec;
+  return true;
+}
+
+/// The key of a file in the catalogue: the absolute path of @b rootName and
+/// the extension of @b fileName.
+static std::string CatalogKey(const std::string & fileName, const std::string & rootName) {
+
+  char absPath[PATH_MAX];
+  if (realpath(rootName.c_str(), absPath) == nullptr) {
+    return fileName;
+  }
+  return std::string(absPath) + fileName.substr(std::min(rootName.size(), fileName.size()));
+}
+
+/// Reads the catalogue file into @b catalog. A line is the key and the
+/// members of CatalogEntry, separated by tabs.
+static void ReadCatalogFile(const std::string & catalogFileName,
+                            std::map<std::string, CatalogEntry> & catalog) {
+
+  std::ifstream catalogFile(catalogFileName);
+  std::string line;
+  while (std::getline(catalogFile, line)) {
+    std::vector<std::string> fields;
+    std::istringstream lineStream(line);
+    std::string field;
+    while (std::getline(lineStream, field, '\t')) {
+      fields.push_back(field);
+    }
+    // incomplete lines are ignored
+    if (fields.size() != 8) {
+      continue;
+    }
+    try {
+      CatalogEntry entry {std::stoll(fields[1]), std::stoll(fields[2]), fields[3],
+                          fields[4], fields[5], std::stoi(fields[6]), std::stoi(fields[7])};
+      catalog[fields[0]] = entry;
+    }
+    catch (std::exception &) {
+      continue;
+    }
+  }
+}
+
+/// Adds @b newEntries to the catalogue file. The file is read again, to keep
+/// the entries written by other processes, and replaced by a rename.
+static void WriteCatalogFile(const std::string & catalogFileName,
+                             const std::map<std::string, CatalogEntry> & newEntries) {
+
+  std::map<std::string, CatalogEntry> catalog;
+  ReadCatalogFile(catalogFileName, catalog);
+  for (auto & entry : newEntries) {
+    catalog[entry.first] = entry.second;
+  }
+
+  std::string tmpFileName = catalogFileName + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream tmpFile(tmpFileName);
+    for (auto & entry : catalog) {
+      const CatalogEntry & e = entry.second;
+      tmpFile << entry.first << '\t' << e.m_size << '\t' << e.m_mtime << '\t'
+              << e.m_extName << '\t' << e.m_start << '\t' << e.m_stop << '\t'
+              << e.m_archRev << '\t' << e.m_procNum << '\n';
+    }
+    if (!tmpFile) {
+      // the catalogue is only a cache, the files are read again next time
+      tmpFile.close();
+      unlink(tmpFileName.c_str());
+      return;
+    }
+  }
+  if (rename(tmpFileName.c_str(), catalogFileName.c_str()) != 0) {
+    unlink(tmpFileName.c_str());
+  }
+}
+
+/// Reads the keywords of the validity period of a reference file.
+static CatalogEntry ReadHeader(const std::string & fileName) {
+
+  FitsDalHeader header(fileName);
+  CatalogEntry entry;
+  entry.m_extName = header.GetAttr<std::string>("EXTNAME");
+  entry.m_start   = header.GetAttr<std::string>("V_STRT_U");
+  entry.m_stop    = header.GetAttr<std::string>("V_STOP_U");
+  entry.m_archRev = header.GetAttr<int32_t>("ARCH_REV");
+  entry.m_procNum = header.GetAttr<int32_t>("PROC_NUM");
+  return entry;
+}
+
+void ValidityCatalog::setCatalogFileName(const std::string & fileName) {
+
+  std::lock_guard<std::mutex> lock(s_catalogMutex);
+  s_catalogFileName = fileName;
+  s_catalogFileNameSet = true;
+  s_catalogFileMtime = -1;
+}
+
+std::string ValidityCatalog::getCatalogFileName() {
+
+  std::lock_guard<std::mutex> lock(s_catalogMutex);
+  if (!s_catalogFileNameSet) {
+    const char * envValue = getenv("CHEOPS_VALIDITY_CATALOG");
+    s_catalogFileName = envValue ? envValue : "";
+    s_catalogFileNameSet = true;
+  }
+  return s_catalogFileName;
+}
+
+void ValidityCatalog::getValidityPeriods(const std::list<std::string> & fileNames,
+                                         std::vector<ValidityPeriod> & validityPeriods,
+                                         std::vector<std::string> & extNames) {
+
+  std::string catalogFileName = getCatalogFileName();
+
+  size_t numFiles = fileNames.size();
+  std::vector<std::string> names(fileNames.begin(), fileNames.end());
+  std::vector<std::string> rootNames(numFiles);
+  std::vector<std::string> keys(numFiles);
+  std::vector<CatalogEntry> entries(numFiles);
+  std::vector<size_t> coldFiles;
+
+  {
+    std::lock_guard<std::mutex> lock(s_catalogMutex);
+
+    // Read the catalogue file again if another process has changed it
+    int64_t size = 0, mtime = 0;
+    if (!catalogFileName.empty() && FileStat(catalogFileName, size, mtime) &&
+        mtime != s_catalogFileMtime) {
+      ReadCatalogFile(catalogFileName, s_catalog);
+      s_catalogFileMtime = mtime;
+    }
+
+    for (size_t i = 0; i < numFiles; i++) {
+      rootNames[i] = RootName(names[i]);
+      size = 0;
+      mtime = 0;
+      bool exists = FileStat(rootNames[i], size, mtime);
+      keys[i] = CatalogKey(names[i], rootNames[i]);
+      entries[i].m_size = size;
+      entries[i].m_mtime = mtime;
+
+      auto i_entry = s_catalog.find(keys[i]);
+      if (exists && i_entry != s_catalog.end() &&
+          i_entry->second.m_size == size && i_entry->second.m_mtime == mtime) {
+        entries[i] = i_entry->second;
+      }
+      else {
+        coldFiles.push_back(i);
+      }
+    }
+  }
+
+  // Read the headers of the files not in the catalogue, in parallel
+  if (!coldFiles.empty()) {
+    std::vector<std::exception_ptr> errors(numFiles);
+    std::atomic<size_t> next(0);
+    auto scan = [&]() {
+      size_t index;
+      while ((index = next++) < coldFiles.size()) {
+        size_t i = coldFiles[index];
+        try {
+          CatalogEntry entry = ReadHeader(names[i]);
+          entry.m_size  = entries[i].m_size;
+          entry.m_mtime = entries[i].m_mtime;
+          entries[i] = entry;
+        }
+        catch (...) {
+          errors[i] = std::current_exception();
+        }
+      }
+    };
+
+    // cfitsio can open files in several threads at the same time only if it
+    // was built reentrant, otherwise the headers are read by this thread
+    unsigned numThreads = 1;
+    if (fits_is_reentrant()) {
+      numThreads = std::min<size_t>(coldFiles.size(),
+                                    std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                                          MAX_SCAN_THREADS)));
+    }
+    std::vector<std::thread> threads;
+    for (unsigned t = 1; t < numThreads; t++) {
+      threads.emplace_back(scan);
+    }
+    scan();
+    for (auto & thread : threads) {
+      thread.join();
+    }
+
+    // the error of the first file in the list
+    for (auto & error : errors) {
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    int64_t maxMtime = int64_t(now.tv_sec) * 1000000000 + now.tv_nsec - MIN_FILE_AGE;
+
+    std::map<std::string, CatalogEntry> newEntries;
+    for (size_t i : coldFiles) {
+      if (entries[i].m_mtime <= maxMtime) {
+        newEntries[keys[i]] = entries[i];
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(s_catalogMutex);
+    for (auto & entry : newEntries) {
+      s_catalog[entry.first] = entry.second;
+    }
+    if (!catalogFileName.empty() && !newEntries.empty()) {
+      WriteCatalogFile(catalogFileName, newEntries);
+      int64_t size, mtime;
+      if (FileStat(catalogFileName, size, mtime)) {
+        s_catalogFileMtime = mtime;
+      }
+    }
+  }
+
+  validityPeriods.clear();
+  extNames.clear();
+  for (size_t i = 0; i < numFiles; i++) {
+    validityPeriods.push_back(ValidityPeriod(entries[i].m_start, entries[i].m_stop,
+                                             entries[i].m_archRev, entries[i].m_procNum,
+                                             names[i], rootNames[i]));
+    extNames.push_back(entries[i].m_extName);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  Class ValidityIndex
+//
+////////////////////////////////////////////////////////////////////////////////
+
+void ValidityIndex::build(const std::set<ValidityPeriod> & validityPeriods) {
+
+  m_validityPeriods.assign(validityPeriods.begin(), validityPeriods.end());
+
+  m_times.clear();
+  for (auto & validityPeriod : m_validityPeriods) {
+    m_times.push_back(validityPeriod.getValidityStart());
+    m_times.push_back(validityPeriod.getValidityStop());
+  }
+  std::sort(m_times.begin(), m_times.end());
+  m_times.erase(std::unique(m_times.begin(), m_times.end()), m_times.end());
+
+  m_atTime.assign(m_times.size(), -1);
+  m_afterTime.assign(m_times.size(), -1);
+
+  // The periods with the highest archive revision and processing number
+  // first, the times already assigned to a period are not changed.
+  for (int period = int(m_validityPeriods.size()) - 1; period >= 0; period--) {
+    const ValidityPeriod & validityPeriod = m_validityPeriods[period];
+    if (validityPeriod.getValidityStop() < validityPeriod.getValidityStart()) {
+      continue;
+    }
+    size_t first = std::lower_bound(m_times.begin(), m_times.end(),
+                                    validityPeriod.getValidityStart()) - m_times.begin();
+    size_t last  = std::lower_bound(m_times.begin(), m_times.end(),
+                                    validityPeriod.getValidityStop()) - m_times.begin();
+    for (size_t i = first; i <= last; i++) {
+      if (m_atTime[i] < 0) {
+        m_atTime[i] = period;
+      }
+      if (i < last && m_afterTime[i] < 0) {
+        m_afterTime[i] = period;
+      }
+    }
+  }
+}
+
+const ValidityPeriod * ValidityIndex::find(const UTC & utc) const {
+
+  // the last start or stop time before or at utc
+  auto i_time = std::upper_bound(m_times.begin(), m_times.end(), utc);
+  if (i_time == m_times.begin()) {
+    return nullptr;
+  }
+  size_t i = (i_time - m_times.begin()) - 1;
+
+  int period = (m_times[i] == utc) ? m_atTime[i] : m_afterTime[i];
+  return period < 0 ? nullptr : &m_validityPeriods[period];
+}
+
+const ValidityPeriod * ValidityIndex::findNext(const UTC & utc) const {
+
+  const ValidityPeriod * current = find(utc);
+  int currentPeriod = current ? int(current - m_validityPeriods.data()) : -1;
+
+  // the start and stop times and the intervals after utc, in time order
+  size_t i = std::upper_bound(m_times.begin(), m_times.end(), utc) - m_times.begin();
+  if (i > 0 && m_times[i - 1] == utc &&
+      m_afterTime[i - 1] >= 0 && m_afterTime[i - 1] != currentPeriod) {
+    return &m_validityPeriods[m_afterTime[i - 1]];
+  }
+  for (; i < m_times.size(); i++) {
+    if (m_atTime[i] >= 0 && m_atTime[i] != currentPeriod) {
+      return &m_validityPeriods[m_atTime[i]];
+    }
+    if (m_afterTime[i] >= 0 && m_afterTime[i] != currentPeriod) {
+      return &m_validityPeriods[m_afterTime[i]];
+    }
+  }
+  return nullptr;
+}
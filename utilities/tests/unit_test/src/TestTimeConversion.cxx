@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-040 test of the TimeColumnFiller class,
+ *                             also of the BJD_TIME column
  *  @version 3.0   2015-01-24 RRO first version
  *
  */
@@ -17,12 +19,17 @@
 
 #include <stdexcept>
 #include <string>
+#include <unistd.h>
 
 #include "ProgramParams.hxx"
 #include "DeltaTime.hxx"
 #include "Obt.hxx"
 #include "Utc.hxx"
 #include "Mjd.hxx"
+#include "Bjd.hxx"
+#include "BarycentricOffset.hxx"
+#include "FitsDalTable.hxx"
+#include "TimeColumnFiller.hxx"
 
 using namespace boost::unit_test;
 
@@ -31,6 +38,7 @@ struct TimeConversionFixture {
       m_params = CheopsInit(framework::master_test_suite().argc,
                             framework::master_test_suite().argv);
 
+      BarycentricOffset::setEphemerisFileName("resources/CH_TU1949-12-14T00-00-00_EXT_APP_DE1_V0000.fits");
    }
 
    ~TimeConversionFixture() {
@@ -102,5 +110,89 @@ BOOST_AUTO_TEST_CASE( MJD2UTC )
    BOOST_CHECK_EQUAL(utc.getUtc().c_str(), "2015-05-18T00:00:00.003052");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// The UTC_TIME and MJD_TIME columns of a table are filled in several threads,
+// every row has to be the same as converted by OBT::getUtc()
+BOOST_AUTO_TEST_CASE( FillTimeColumns )
+{
+   std::string fileName = "results/testTimeColumns.fits";
+   unlink(fileName.c_str());
+
+   // one row every 10 seconds, before and after the OBT clock reset
+   const int64_t numRows = 5000;
+   FitsDalTable * table = new FitsDalTable(fileName, "CREATE");
+   int64_t obt;
+   std::string utcTime;
+   double mjdTime;
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("UTC_TIME", &utcTime, 26);
+   table->Assign("MJD_TIME", &mjdTime);
+   for (int64_t row = 0; row < numRows; row++) {
+      if (row < numRows / 2)
+         obt = 1000001000000 - (numRows / 2 - row) * (10LL << 16);
+      else
+         obt = 0x1000000000000 + 2000000 + (row - numRows / 2) * (10LL << 16);
+      table->WriteRow();
+   }
+
+   TimeColumnFiller filler(4);
+   BOOST_CHECK_EQUAL(filler.Fill(*table), numRows);
+   delete table;
+
+   table = new FitsDalTable(fileName, "READONLY");
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("UTC_TIME", &utcTime, 26);
+   table->Assign("MJD_TIME", &mjdTime);
+   int64_t numReadRows = 0;
+   while (table->ReadRow()) {
+      UTC utc = OBT(obt).getUtc();
+      BOOST_CHECK_EQUAL(utcTime, utc.getUtc());
+      BOOST_CHECK_EQUAL(mjdTime, utc.getMjd().getMjd());
+      numReadRows++;
+   }
+   BOOST_CHECK_EQUAL(numReadRows, numRows);
+   delete table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The BJD_TIME column is filled in several threads, each with its own copy of
+// the BarycentricOffset, every row has to be the same as MJD + BarycentricOffset
+BOOST_AUTO_TEST_CASE( FillBjdTimeColumn )
+{
+   std::string fileName = "results/testBjdTimeColumn.fits";
+   unlink(fileName.c_str());
+
+   const int64_t numRows = 5000;
+   FitsDalTable * table = new FitsDalTable(fileName, "CREATE");
+   int64_t obt;
+   double mjdTime;
+   double bjdTime;
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("MJD_TIME", &mjdTime);
+   table->Assign("BJD_TIME", &bjdTime);
+   for (int64_t row = 0; row < numRows; row++) {
+      obt = 1000001000000 + row * (60LL << 16);
+      table->WriteRow();
+   }
+
+   BarycentricOffset barycentricOffset(34.5, -23.5);
+   TimeColumnFiller filler(barycentricOffset, 4);
+   BOOST_CHECK_EQUAL(filler.Fill(*table), numRows);
+   delete table;
+
+   table = new FitsDalTable(fileName, "READONLY");
+   table->Assign("OBT_TIME", &obt);
+   table->Assign("MJD_TIME", &mjdTime);
+   table->Assign("BJD_TIME", &bjdTime);
+   int64_t numReadRows = 0;
+   while (table->ReadRow()) {
+      MJD mjd = OBT(obt).getUtc().getMjd();
+      BOOST_CHECK_EQUAL(mjdTime, mjd.getMjd());
+      BOOST_CHECK_EQUAL(bjdTime, (mjd + barycentricOffset).getBjd());
+      numReadRows++;
+   }
+   BOOST_CHECK_EQUAL(numReadRows, numRows);
+   delete table;
+}
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,8 @@
  *
  *  @author Reiner Rohlfs UGE
  *
+ *  @version 13.2  2026-10-19 agent user-043 tests of the ValidityIndex, the
+ *                                ValidityCatalog and the open files (user-044)
  *  @version 3.0   2015-01-24 RRO first version
  *
  */
@@ -14,8 +16,11 @@
 #define BOOST_TEST_MAIN
 #include "boost/test/unit_test.hpp"
 
+#include <fstream>
 #include <list>
+#include <random>
 #include <set>
+#include <sys/time.h>
 
 //#include "REF_APP_Limits.hxx"
 #include "FitsDalTable.hxx"
@@ -185,6 +190,58 @@ BOOST_AUTO_TEST_CASE( test_ValidityPeriod_contains )
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// Test that the ValidityIndex returns the same validity period as a search
+// through all validity periods, starting with the highest version.
+//
+BOOST_AUTO_TEST_CASE( test_ValidityIndex )
+{
+  std::mt19937 random(42);
+  std::uniform_int_distribution<int> second(1, 100);
+
+  std::set<ValidityPeriod> validityPeriods;
+  for (int32_t procNum = 0; procNum < 50; procNum++) {
+    int start = second(random);
+    int stop  = start + second(random) / 4;
+    validityPeriods.insert(ValidityPeriod(UTC(2020, 1, 1, 1, start / 60, start % 60),
+                                          UTC(2020, 1, 1, 1, stop / 60, stop % 60),
+                                          procNum % 3, procNum, m_fileName1, m_fileName1));
+  }
+
+  ValidityIndex validityIndex;
+  validityIndex.build(validityPeriods);
+
+  for (int i = 0; i < 260; i++) {
+    UTC utc(2020, 1, 1, 1, (i / 2) / 60, (i / 2) % 60, (i % 2) * 0.5);
+
+    const ValidityPeriod * expected = nullptr;
+    for (auto i_vp = validityPeriods.rbegin(); i_vp != validityPeriods.rend(); i_vp++) {
+      if (i_vp->contains(utc)) {
+        expected = &(*i_vp);
+        break;
+      }
+    }
+
+    const ValidityPeriod * found = validityIndex.find(utc);
+    BOOST_REQUIRE_EQUAL( found == nullptr, expected == nullptr );
+    if (found) {
+      BOOST_CHECK( *found == *expected );
+    }
+
+    // the next validity period is the next other one found by find()
+    const ValidityPeriod * expectedNext = nullptr;
+    for (int j = i + 1; j < 260 && expectedNext == nullptr; j++) {
+      const ValidityPeriod * next =
+          validityIndex.find(UTC(2020, 1, 1, 1, (j / 2) / 60, (j / 2) % 60, (j % 2) * 0.5));
+      if (next != nullptr && next != found) {
+        expectedNext = next;
+      }
+    }
+    BOOST_CHECK( validityIndex.findNext(utc) == expectedNext );
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 
@@ -203,6 +260,17 @@ struct ValidRefFileFixture {
      unlink(m_fileName3.c_str());
    }
 
+  /// Sets the modification time of a file to one hour ago, younger files
+  /// are not stored in the catalogue.
+  void makeOld(const std::string & fileName) {
+
+    struct timeval times[2];
+    gettimeofday(&times[0], nullptr);
+    times[0].tv_sec -= 3600;
+    times[1] = times[0];
+    utimes(fileName.c_str(), times);
+  }
+
 };
 
 
@@ -475,4 +543,120 @@ BOOST_AUTO_TEST_CASE( two_reference_files_full_overlap )
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+//
+// Test that the files returned before are kept open and that the next file
+// is opened in advance.
+//
+// Time              ----------------->
+// ValidityPeriod 1: |---|
+// ValidityPeriod 2:       |---|
+// ValidityPeriod 3:             |---|
+//
+BOOST_AUTO_TEST_CASE( open_files )
+{
+  UTC validityStart1 (2020, 1, 1, 1, 1, 2);
+  UTC validityStop1  (2020, 1, 1, 1, 1, 4);
+  UTC validityStart2 (2020, 1, 1, 1, 1, 6);
+  UTC validityStop2  (2020, 1, 1, 1, 1, 8);
+  UTC validityStart3 (2020, 1, 1, 1, 1, 10);
+  UTC validityStop3  (2020, 1, 1, 1, 1, 12);
+
+  std::list<std::string> fileNames = { m_fileName1, m_fileName2, m_fileName3 };
+
+  createRefFile<FitsDalTable>(m_fileName1, "REF_APP_LImits", validityStart1, validityStop1, 0, 0);
+  createRefFile<FitsDalTable>(m_fileName2, "REF_APP_LImits", validityStart2, validityStop2, 0, 1);
+  createRefFile<FitsDalTable>(m_fileName3, "REF_APP_LImits", validityStart3, validityStop3, 0, 2);
+
+  ValidRefFile<FitsDalTable> refAppLimits(fileNames);
+  refAppLimits.setMaxOpenFiles(2);
+
+  // alternating data times return the same two files
+  FitsDalTable * file1 = refAppLimits.getFile(validityStart1);
+  FitsDalTable * file2 = refAppLimits.getFile(validityStart2);
+  BOOST_CHECK( file1 != file2 );
+  BOOST_CHECK( refAppLimits.getFile(validityStop1) == file1 );
+  BOOST_CHECK( refAppLimits.getFile(validityStop2) == file2 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStart3)->GetFileName(), m_fileName3 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStop2)->GetFileName(),  m_fileName2 );
+
+  // increasing data times with prefetch
+  refAppLimits.setPrefetch(true);
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStart1)->GetFileName(), m_fileName1 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStop1)->GetFileName(),  m_fileName1 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStart2)->GetFileName(), m_fileName2 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStart3)->GetFileName(), m_fileName3 );
+  BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStop3)->GetFileName(),  m_fileName3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+//
+// Test that the validity periods are read from the catalogue file as long as
+// the reference files are not changed.
+//
+BOOST_AUTO_TEST_CASE( catalog_file )
+{
+  std::string catalogFileName = "resources/TestValidRefFile_catalog.txt";
+  unlink(catalogFileName.c_str());
+  ValidityCatalog::setCatalogFileName(catalogFileName);
+
+  UTC validityStart1 (2020, 1, 1, 1, 1, 2);
+  UTC validityStop1  (2020, 1, 1, 1, 1, 4);
+  UTC validityStart2 (2020, 1, 1, 1, 1, 6);
+  UTC validityStop2  (2020, 1, 1, 1, 1, 8);
+  UTC afterValidityStop1 (2020, 1, 1, 1, 1, 5);
+
+  std::list<std::string> fileNames = { m_fileName1, m_fileName2 };
+
+  createRefFile<FitsDalTable>(m_fileName1, "REF_APP_LImits", validityStart1, validityStop1, 0, 0);
+  createRefFile<FitsDalTable>(m_fileName2, "REF_APP_LImits", validityStart2, validityStop2, 0, 1);
+  makeOld(m_fileName1);
+  makeOld(m_fileName2);
+
+  // the headers are read and stored in the catalogue file
+  {
+    ValidRefFile<FitsDalTable> refAppLimits(fileNames);
+    BOOST_CHECK_THROW( refAppLimits.getFile(afterValidityStop1), std::runtime_error );
+    BOOST_CHECK_EQUAL( refAppLimits.getFile(validityStart2)->GetFileName(), m_fileName2 );
+  }
+
+  // change the validity stop of the first file in the catalogue file only
+  std::list<std::string> lines;
+  {
+    std::ifstream catalogFile(catalogFileName);
+    std::string line;
+    while (std::getline(catalogFile, line)) {
+      if (line.find(m_fileName1) != std::string::npos) {
+        line.replace(line.find(validityStop1.getUtc()), validityStop1.getUtc().size(),
+                     afterValidityStop1.getUtc());
+      }
+      lines.push_back(line);
+    }
+  }
+  BOOST_CHECK_EQUAL( lines.size(), 2 );
+  {
+    std::ofstream catalogFile(catalogFileName);
+    for (auto & line : lines) {
+      catalogFile << line << std::endl;
+    }
+  }
+  ValidityCatalog::setCatalogFileName(catalogFileName);
+
+  // the validity periods are taken from the catalogue file
+  {
+    ValidRefFile<FitsDalTable> refAppLimits(fileNames);
+    BOOST_CHECK_EQUAL( refAppLimits.getFile(afterValidityStop1)->GetFileName(), m_fileName1 );
+  }
+
+  // a changed file is read again
+  createRefFile<FitsDalTable>(m_fileName1, "REF_APP_LImits", validityStart1, validityStop1, 0, 0);
+  {
+    ValidRefFile<FitsDalTable> refAppLimits(fileNames);
+    BOOST_CHECK_THROW( refAppLimits.getFile(afterValidityStop1), std::runtime_error );
+  }
+
+  ValidityCatalog::setCatalogFileName("");
+  unlink(catalogFileName.c_str());
+}
+
 BOOST_AUTO_TEST_SUITE_END()